@@ -0,0 +1,137 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "benchmarks/abm.h"
+#include "benchmarks/metrics.h"
+
+#include "abm/abm.h"
+#include "memilio/utils/random_number_generator.h"
+
+#include <vector>
+
+/**
+ * @brief create a world with households and shared locations, similar to the abm example.
+ * @param num_persons number of persons in the world.
+ * @param cfg configuration of the benchmark.
+ */
+mio::abm::World make_world(size_t num_persons, const mio::benchmark::AbmConfig& cfg)
+{
+    mio::abm::World world;
+
+    // infection state of each person is drawn from the configured shares
+    auto susceptible_pct = 1 - cfg.exposed_pct - cfg.carrier_pct - cfg.infected_pct - cfg.recovered_pct;
+    auto state_weights   = std::vector<double>((size_t)mio::abm::InfectionState::Count, 0.0);
+    state_weights[(size_t)mio::abm::InfectionState::Susceptible]        = susceptible_pct;
+    state_weights[(size_t)mio::abm::InfectionState::Exposed]            = cfg.exposed_pct;
+    state_weights[(size_t)mio::abm::InfectionState::Carrier]            = cfg.carrier_pct;
+    state_weights[(size_t)mio::abm::InfectionState::Infected]           = cfg.infected_pct;
+    state_weights[(size_t)mio::abm::InfectionState::Recovered_Infected] = cfg.recovered_pct;
+    // age distribution of the population in germany
+    auto age_weights = std::vector<double>{5000, 6000, 14943, 22259, 11998, 5038};
+
+    auto add_location = [&world](mio::abm::LocationType type, int max_contacts) {
+        auto id = world.add_location(type);
+        world.get_individualized_location(id).get_infection_parameters().set<mio::abm::MaximumContacts>(max_contacts);
+        return id;
+    };
+    auto event    = add_location(mio::abm::LocationType::SocialEvent, 100);
+    auto hospital = add_location(mio::abm::LocationType::Hospital, 5);
+    auto icu      = add_location(mio::abm::LocationType::ICU, 5);
+    auto shop     = add_location(mio::abm::LocationType::BasicsShop, 20);
+    auto school   = add_location(mio::abm::LocationType::School, 40);
+    auto work     = add_location(mio::abm::LocationType::Work, 40);
+
+    // one shop for 15000 persons, one school for 600 students, one workplace for 100 workers
+    size_t counter_shop = 0, counter_school = 0, counter_work = 0;
+    auto home           = world.add_location(mio::abm::LocationType::Home);
+    for (size_t i = 0; i < num_persons; ++i) {
+        if (i > 0 && i % size_t(cfg.household_size) == 0) {
+            home = world.add_location(mio::abm::LocationType::Home);
+        }
+        auto state   = mio::DiscreteDistribution<size_t>::get_instance()(state_weights);
+        auto age     = mio::DiscreteDistribution<size_t>::get_instance()(age_weights);
+        auto& person = world.add_person(home, mio::abm::InfectionState(state), mio::abm::AgeGroup(age));
+        person.set_assigned_location(home);
+        person.set_assigned_location(event);
+        person.set_assigned_location(hospital);
+        person.set_assigned_location(icu);
+        person.set_assigned_location(shop);
+        if (++counter_shop == 15000) {
+            counter_shop = 0;
+            shop         = add_location(mio::abm::LocationType::BasicsShop, 20);
+        }
+        if (person.get_age() == mio::abm::AgeGroup::Age5to14) {
+            person.set_assigned_location(school);
+            if (++counter_school == 600) {
+                counter_school = 0;
+                school         = add_location(mio::abm::LocationType::School, 40);
+            }
+        }
+        if (person.get_age() == mio::abm::AgeGroup::Age15to34 || person.get_age() == mio::abm::AgeGroup::Age35to59) {
+            person.set_assigned_location(work);
+            if (++counter_work == 100) {
+                counter_work = 0;
+                work         = add_location(mio::abm::LocationType::Work, 40);
+            }
+        }
+    }
+    return world;
+}
+
+/**
+ * @brief advance an abm simulation.
+ * The number of persons is the argument of the benchmark.
+ */
+void abm_simulation(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg  = mio::benchmark::AbmConfig::initialize("benchmarks/abm.config");
+    auto t0   = mio::abm::TimePoint(0);
+    auto tmax = t0 + mio::abm::days(cfg.num_days);
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // setup of the world is not timed
+        state.PauseTiming();
+        memory.pause();
+        auto sim = mio::abm::Simulation(t0, make_world(size_t(state.range(0)), cfg));
+        memory.resume();
+        state.ResumeTiming();
+
+        // This code gets timed
+        sim.advance(tmax);
+    }
+    memory.set_counters(state);
+    state.counters["num_agents"] = double(state.range(0));
+}
+
+// dummy runs to avoid large effects of cpu scaling on times of actual benchmarks
+BENCHMARK(abm_simulation)->Arg(1000)->Name("Dummy 1/3");
+BENCHMARK(abm_simulation)->Arg(1000)->Name("Dummy 2/3");
+BENCHMARK(abm_simulation)->Arg(1000)->Name("Dummy 3/3");
+// register functions as a benchmarks and set a name
+BENCHMARK(abm_simulation)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("simulate abm");
+// run all benchmarks
+MEMILIO_BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef ABM_H_
+#define ABM_H_
+
+#include "memilio/io/json_serializer.h"
+#include "memilio/utils/logging.h"
+
+#include "benchmark/benchmark.h"
+
+namespace mio
+{
+namespace benchmark
+{
+/// @brief parameters for abm benchmark
+struct AbmConfig {
+    int num_days, household_size;
+    double exposed_pct, carrier_pct, infected_pct, recovered_pct;
+    /**
+         * @brief creates configuration with default parameters for an abm
+         * @return configuration for abm benchmark
+         */
+    static AbmConfig initialize()
+    {
+        return AbmConfig{1, 3, 0.01, 0.05, 0.08, 0.01};
+    }
+    /**
+         * @brief reads configuration from json file
+         * @param path the path of the configfile
+         * @return configuration for abm benchmark
+         */
+    static AbmConfig initialize(std::string path)
+    {
+        auto result = mio::read_json(path, mio::Tag<AbmConfig>{});
+        if (!result) { // failed to read config
+            mio::log(mio::LogLevel::critical, result.error().formatted_message());
+            abort();
+        }
+        return result.value();
+    }
+    /// @brief function implementing mio::deserialize, used by read_json in initialize
+    template <class IOContext>
+    static mio::IOResult<AbmConfig> deserialize(IOContext& io)
+    {
+        auto obj               = io.expect_object("bench_abm");
+        auto num_days_io       = obj.expect_element("num_days", mio::Tag<int>{});
+        auto household_size_io = obj.expect_element("household_size", mio::Tag<int>{});
+        auto exposed_pct_io    = obj.expect_element("exposed_pct", mio::Tag<double>{});
+        auto carrier_pct_io    = obj.expect_element("carrier_pct", mio::Tag<double>{});
+        auto infected_pct_io   = obj.expect_element("infected_pct", mio::Tag<double>{});
+        auto recovered_pct_io  = obj.expect_element("recovered_pct", mio::Tag<double>{});
+        return mio::apply(
+            io,
+            [](auto&& num_days, auto&& household_size, auto&& exposed_pct, auto&& carrier_pct, auto&& infected_pct,
+               auto&& recovered_pct) {
+                return AbmConfig{num_days, household_size, exposed_pct, carrier_pct, infected_pct, recovered_pct};
+            },
+            num_days_io, household_size_io, exposed_pct_io, carrier_pct_io, infected_pct_io, recovered_pct_io);
+    }
+};
+} // namespace benchmark
+
+} // namespace mio
+
+#endif
@@ -0,0 +1,196 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/io/json_serializer.h"
+#include "memilio/utils/logging.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * Compare the results of benchmark executables with baselines.
+ * Both files are written by google benchmark with `--benchmark_out=<file> --benchmark_out_format=json`.
+ * The time, the number of allocations and the peak memory of each benchmark are compared.
+ * Fails if any of them increased by more than the tolerance.
+ * Counters that start with "num_" describe the configuration of a benchmark, e.g. the number of nodes.
+ * If the configuration of a benchmark changed, it is not compared.
+ */
+
+/// @brief relative tolerances of the comparison
+struct Tolerances {
+    double time   = 0.1;
+    double memory = 0.1;
+};
+
+/// @brief time of a benchmark run in nanoseconds
+double get_time_ns(const Json::Value& run)
+{
+    auto unit   = run["time_unit"].asString();
+    auto factor = unit == "us" ? 1e3 : unit == "ms" ? 1e6 : unit == "s" ? 1e9 : 1.0;
+    return run["real_time"].asDouble() * factor;
+}
+
+/// @brief find a run by name among the runs of a benchmark output, returns null if not found
+const Json::Value* find_run(const Json::Value& runs, const std::string& name)
+{
+    for (auto& run : runs) {
+        if (run["name"].asString() == name) {
+            return &run;
+        }
+    }
+    return nullptr;
+}
+
+/// @brief true if the configuration counters of two runs of a benchmark are the same
+bool is_same_configuration(const Json::Value& baseline, const Json::Value& current)
+{
+    for (auto& key : current.getMemberNames()) {
+        if (key.compare(0, 4, "num_") == 0 && (!baseline.isMember(key) || baseline[key] != current[key])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief compare one metric of a benchmark and print the result.
+ * @param name name of the benchmark.
+ * @param metric name of the metric.
+ * @param baseline value of the baseline.
+ * @param current current value.
+ * @param tolerance relative tolerance.
+ * @param min_increase smallest absolute increase that is considered a regression.
+ * @return true if the current value is a regression.
+ */
+bool compare_metric(const std::string& name, const std::string& metric, double baseline, double current,
+                    double tolerance, double min_increase)
+{
+    auto is_regression = current > baseline * (1 + tolerance) && current - baseline >= min_increase;
+    auto change        = baseline > 0 ? (current - baseline) / baseline * 100 : 0.0;
+    printf("%-60s %-10s %14.6g %14.6g %+8.1f%% %s\n", name.c_str(), metric.c_str(), baseline, current, change,
+           is_regression ? "REGRESSION" : "");
+    return is_regression;
+}
+
+/**
+ * @brief compare the results of a benchmark executable with a baseline.
+ * @return the number of regressions or any errors that occur while reading the files.
+ */
+mio::IOResult<int> compare(const std::string& baseline_file, const std::string& current_file,
+                           const Tolerances& tolerances)
+{
+    auto baseline_result = mio::read_json(baseline_file);
+    if (!baseline_result && baseline_result.error().code() == mio::StatusCode::FileNotFound) {
+        return mio::failure(mio::StatusCode::FileNotFound,
+                            baseline_file + ", create the baselines with the target benchmark_update_baselines.");
+    }
+    BOOST_OUTCOME_TRY(baseline, std::move(baseline_result));
+    BOOST_OUTCOME_TRY(current, mio::read_json(current_file));
+    if (!baseline["benchmarks"].isArray() || !current["benchmarks"].isArray()) {
+        return mio::failure(mio::StatusCode::InvalidFileFormat, "Not a benchmark output.");
+    }
+
+    auto num_regressions = 0;
+    printf("%-60s %-10s %14s %14s %9s\n", "benchmark", "metric", "baseline", "current", "change");
+    for (auto& run : current["benchmarks"]) {
+        auto name = run["name"].asString();
+        // only compare single runs, dummy runs are just to warm up the cpu
+        if (run.isMember("run_type") && run["run_type"].asString() != "iteration") {
+            continue;
+        }
+        if (name.compare(0, 5, "Dummy") == 0) {
+            continue;
+        }
+        if (run.isMember("error_occurred") && run["error_occurred"].asBool()) {
+            printf("%-60s error: %s\n", name.c_str(), run["error_message"].asCString());
+            ++num_regressions;
+            continue;
+        }
+        auto baseline_run = find_run(baseline["benchmarks"], name);
+        if (!baseline_run) {
+            printf("%-60s no baseline\n", name.c_str());
+            continue;
+        }
+        if (!is_same_configuration(*baseline_run, run)) {
+            printf("%-60s configuration changed, update the baseline\n", name.c_str());
+            continue;
+        }
+
+        num_regressions += compare_metric(name, "time_ns", get_time_ns(*baseline_run), get_time_ns(run),
+                                          tolerances.time, 0.0);
+        if (baseline_run->isMember("allocs") && run.isMember("allocs")) {
+            num_regressions += compare_metric(name, "allocs", (*baseline_run)["allocs"].asDouble(),
+                                              run["allocs"].asDouble(), tolerances.memory, 1.0);
+        }
+        if (baseline_run->isMember("peak_rss") && run.isMember("peak_rss")) {
+            num_regressions += compare_metric(name, "peak_rss", (*baseline_run)["peak_rss"].asDouble(),
+                                              run["peak_rss"].asDouble(), tolerances.memory, 0.0);
+        }
+    }
+    return mio::success(num_regressions);
+}
+
+int main(int argc, char** argv)
+{
+    //options first, then pairs of files
+    Tolerances tolerances;
+    auto i = 1;
+    for (; i + 1 < argc && std::string(argv[i]).compare(0, 2, "--") == 0; i += 2) {
+        auto option = std::string(argv[i]);
+        if (option == "--tolerance") {
+            tolerances.time = std::atof(argv[i + 1]);
+        }
+        else if (option == "--memory-tolerance") {
+            tolerances.memory = std::atof(argv[i + 1]);
+        }
+        else {
+            printf("Unknown option %s.\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (i >= argc || (argc - i) % 2 != 0) {
+        printf("Usage: benchmark_compare [--tolerance <t>] [--memory-tolerance <t>] <baseline.json> <current.json> "
+               "[<baseline.json> <current.json> ...]\n");
+        printf("Compares the output of benchmarks with baselines, fails if the current results are worse.\n");
+        printf("Tolerances are relative, e.g. 0.1 for 10%%; the default is 0.1 for both.\n");
+        return 2;
+    }
+
+    //compare all files before failing so all regressions are reported at once
+    auto exit_code = 0;
+    for (; i < argc; i += 2) {
+        auto result = compare(argv[i], argv[i + 1], tolerances);
+        if (!result) {
+            mio::log_error("{}: {}", argv[i + 1], result.error().formatted_message());
+            exit_code = 2;
+        }
+        else if (result.value() > 0) {
+            printf("%d regressions compared to %s.\n", result.value(), argv[i]);
+            exit_code = std::max(exit_code, 1);
+        }
+        else {
+            printf("No regressions compared to %s.\n", argv[i]);
+        }
+    }
+    return exit_code;
+}
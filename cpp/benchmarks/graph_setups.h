@@ -0,0 +1,92 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef GRAPH_SETUPS_H_
+#define GRAPH_SETUPS_H_
+
+#include "memilio/mobility/graph.h"
+#include "memilio/mobility/mobility.h"
+
+#include <algorithm>
+
+namespace mio
+{
+namespace benchmark
+{
+namespace graph
+{
+/**
+         * @brief Graph of identical models with consistent setup for use in benchmarking.
+         * The nodes are arranged in a ring, every node is connected in both directions to its nearest neighbors,
+         * so the number of edges grows linearly with the number of nodes. Use num_nodes - 1 neighbors for a
+         * complete graph.
+         * @param model model in every node.
+         * @param num_nodes number of nodes.
+         * @param num_neighbors number of neighbors of every node.
+         * @param migration_rate share of every compartment that commutes along every edge.
+         */
+template <class Model>
+Graph<Model, MigrationParameters> make_graph(const Model& model, size_t num_nodes, size_t num_neighbors,
+                                             double migration_rate)
+{
+    num_neighbors = std::min(num_neighbors, num_nodes - 1);
+
+    GraphBuilder<Model, MigrationParameters> builder;
+    builder.reserve(num_nodes, num_nodes * num_neighbors);
+    for (size_t i = 0; i < num_nodes; ++i) {
+        builder.add_node(int(i), model);
+    }
+    auto coeffs = Eigen::VectorXd::Constant(model.populations.numel(), migration_rate).eval();
+    for (size_t i = 0; i < num_nodes; ++i) {
+        //alternate between the following and the preceding neighbors
+        for (size_t k = 0; k < num_neighbors; ++k) {
+            auto offset = k / 2 + 1;
+            auto j      = k % 2 == 0 ? (i + offset) % num_nodes : (i + num_nodes - offset) % num_nodes;
+            builder.add_edge(i, j, coeffs);
+        }
+    }
+    return builder.build();
+}
+
+/**
+         * @brief Graph of simulations from a graph of models, as created by a parameter study.
+         * @param graph graph of models.
+         * @param t0 start time of the simulations.
+         * @param dt initial step size of the integration in the nodes.
+         */
+template <class Simulation>
+Graph<SimulationNode<Simulation>, MigrationEdge>
+make_simulation_graph(const Graph<typename Simulation::Model, MigrationParameters>& graph, double t0, double dt)
+{
+    GraphBuilder<SimulationNode<Simulation>, MigrationEdge> builder;
+    builder.reserve(graph.nodes().size(), graph.edges().size());
+    for (auto&& node : graph.nodes()) {
+        builder.add_node(node.id, node.property, t0, dt);
+    }
+    for (auto&& edge : graph.edges()) {
+        builder.add_edge(edge.start_node_idx, edge.end_node_idx, edge.property);
+    }
+    return builder.build();
+}
+} // namespace graph
+} // namespace benchmark
+
+} // namespace mio
+
+#endif
@@ -0,0 +1,153 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "benchmarks/graph_simulation.h"
+#include "benchmarks/graph_setups.h"
+#include "benchmarks/metrics.h"
+#include "benchmarks/secir_ageres_setups.h"
+#include "benchmarks/secirvvs_ageres_setups.h"
+
+#include "memilio/mobility/coupled_migration.h"
+#include "memilio/mobility/mobility.h"
+#include "models/ode_secir/model.h"
+#include "models/ode_secirvvs/model.h"
+
+/// @brief model in every node of the graph, setup depends on the type of the model
+template <class Model>
+Model make_model(size_t num_agegroups);
+
+template <>
+mio::osecir::Model make_model<mio::osecir::Model>(size_t num_agegroups)
+{
+    return mio::benchmark::model::SecirAgeres(num_agegroups);
+}
+
+template <>
+mio::osecirvvs::Model make_model<mio::osecirvvs::Model>(size_t num_agegroups)
+{
+    return mio::benchmark::model::SecirvvsAgeres(num_agegroups);
+}
+
+/**
+ * @brief simulate a graph of models with migration along the edges.
+ * The number of nodes is the argument of the benchmark.
+ * @tparam Dense if true, every node is connected to every other node, otherwise only to a few neighbors.
+ */
+template <class Simulation, bool Dense>
+void graph_simulation(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg           = mio::benchmark::GraphSimulationConfig::initialize("benchmarks/graph_simulation.config");
+    auto num_nodes     = size_t(state.range(0));
+    auto num_neighbors = Dense ? num_nodes - 1 : size_t(cfg.num_neighbors);
+    auto graph = mio::benchmark::graph::make_graph(make_model<typename Simulation::Model>(size_t(cfg.num_agegroups)),
+                                                   num_nodes, num_neighbors, cfg.migration_rate);
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // setup of the simulations is not timed
+        state.PauseTiming();
+        memory.pause();
+        auto sim = mio::make_migration_sim(
+            cfg.t0, cfg.dt, mio::benchmark::graph::make_simulation_graph<Simulation>(graph, cfg.t0, cfg.dt));
+        memory.resume();
+        state.ResumeTiming();
+
+        // This code gets timed
+        sim.advance(cfg.t_max);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(num_nodes);
+    state.counters["edges"]         = double(graph.edges().size());
+}
+
+/**
+ * @brief simulate a sparse graph of models coupled in a single system of ODEs, see CoupledMigrationSimulation.
+ * The number of nodes and the number of threads that evaluate the right hand side are the arguments of the benchmark.
+ */
+template <class Model>
+void coupled_simulation(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg         = mio::benchmark::GraphSimulationConfig::initialize("benchmarks/graph_simulation.config");
+    auto num_nodes   = size_t(state.range(0));
+    auto num_threads = size_t(state.range(1));
+    auto graph       = mio::benchmark::graph::make_graph(make_model<Model>(size_t(cfg.num_agegroups)), num_nodes,
+                                                        size_t(cfg.num_neighbors), cfg.migration_rate);
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // setup of the simulation, including starting the threads, is not timed
+        state.PauseTiming();
+        memory.pause();
+        mio::CoupledMigrationSimulation<Model> sim(graph, cfg.t0, cfg.dt);
+        sim.set_num_threads(num_threads);
+        memory.resume();
+        state.ResumeTiming();
+
+        // This code gets timed
+        sim.advance(cfg.t_max);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(num_nodes);
+    state.counters["num_threads"]   = double(num_threads);
+}
+
+// dummy runs to avoid large effects of cpu scaling on times of actual benchmarks
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecir::Simulation<>, false)->Arg(10)->Name("Dummy 1/3");
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecir::Simulation<>, false)->Arg(10)->Name("Dummy 2/3");
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecir::Simulation<>, false)->Arg(10)->Name("Dummy 3/3");
+// register functions as a benchmarks and set a name
+// the number of edges of dense graphs grows quadratically, so they are limited to fewer nodes
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecir::Simulation<>, false)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("simulate SecirModel graph sparse");
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecir::Simulation<>, true)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(300)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("simulate SecirModel graph dense");
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecirvvs::Simulation<>, false)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("simulate SecirvvsModel graph sparse");
+BENCHMARK_TEMPLATE(graph_simulation, mio::osecirvvs::Simulation<>, true)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(300)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("simulate SecirvvsModel graph dense");
+// the speedup over 1 thread depends on the number of cores of the machine
+BENCHMARK_TEMPLATE(coupled_simulation, mio::osecir::Model)
+    ->ArgsProduct({{100, 1000}, {1, 2, 4}})
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Name("simulate SecirModel coupled graph");
+// run all benchmarks
+MEMILIO_BENCHMARK_MAIN();
@@ -19,6 +19,7 @@
 */
 #include "benchmarks/integrator_step.h"
 #include "benchmarks/secir_ageres_setups.h"
+#include "benchmarks/metrics.h"
 
 #include "memilio/math/adapt_rk.h"
 #include "memilio/math/stepper_wrapper.h"
@@ -42,12 +43,15 @@ void integrator_step(::benchmark::State& state)
     auto I = Integrator(cfg.abs_tol, cfg.rel_tol, cfg.dt_min, cfg.dt_max);
 
     double t, dt;
+    mio::benchmark::MemoryMetrics memory;
     for (auto _ : state) {
         // This code gets timed
         t  = cfg.t_init;
         dt = cfg.dt_init;
         I.step(f, cfg.yt, t, dt, cfg.ytp1);
     }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
 }
 
 // dummy runs to avoid large effects of cpu scaling on times of actual benchmarks
@@ -63,4 +67,4 @@ BENCHMARK_TEMPLATE(integrator_step, mio::ControlledStepperWrapper<boost::numeric
 BENCHMARK_TEMPLATE(integrator_step, mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_fehlberg78>)
     ->Name("simulate SecirModel boost rkf78");
 // run all benchmarks
-BENCHMARK_MAIN();
+MEMILIO_BENCHMARK_MAIN();
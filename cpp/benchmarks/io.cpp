@@ -0,0 +1,244 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "benchmarks/io.h"
+#include "benchmarks/graph_setups.h"
+#include "benchmarks/metrics.h"
+#include "benchmarks/secir_ageres_setups.h"
+
+#include "memilio/data/analyze_result.h"
+#include "memilio/io/mobility_io.h"
+#include "memilio/io/result_io.h"
+#include "memilio/utils/time_series.h"
+#include "models/ode_secir/model.h"
+
+#include "boost/filesystem.hpp"
+
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief unique path in the system temp directory for files written by the benchmarks.
+ */
+std::string make_temp_path()
+{
+    return (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("memilio-bench-%%%%-%%%%"))
+        .string();
+}
+
+/**
+ * @brief synthetic result of a graph of secir models.
+ * @param num_nodes number of nodes in the graph.
+ * @param cfg configuration of the benchmark.
+ */
+std::vector<mio::TimeSeries<double>> make_result(size_t num_nodes, const mio::benchmark::IoConfig& cfg)
+{
+    auto num_elements = Eigen::Index(cfg.num_agegroups) * Eigen::Index(mio::osecir::InfectionState::Count);
+    std::vector<mio::TimeSeries<double>> result(num_nodes, mio::TimeSeries<double>(num_elements));
+    for (auto& node_result : result) {
+        node_result.reserve(cfg.num_time_points);
+        for (int t = 0; t < cfg.num_time_points; ++t) {
+            node_result.add_time_point(t, 1000 * Eigen::VectorXd::Random(num_elements).cwiseAbs());
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief graph of secir models as it is written and read by simulations that use stored parameters.
+ * @param num_nodes number of nodes in the graph.
+ * @param cfg configuration of the benchmark.
+ */
+mio::Graph<mio::osecir::Model, mio::MigrationParameters> make_graph(size_t num_nodes,
+                                                                     const mio::benchmark::IoConfig& cfg)
+{
+    return mio::benchmark::graph::make_graph(mio::benchmark::model::SecirAgeres(size_t(cfg.num_agegroups)), num_nodes,
+                                             size_t(cfg.num_neighbors), cfg.migration_rate);
+}
+
+/**
+ * @brief write the result of a graph to an hdf5 file.
+ * The number of nodes is the argument of the benchmark.
+ */
+void save_result(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg      = mio::benchmark::IoConfig::initialize("benchmarks/io.config");
+    auto result   = make_result(size_t(state.range(0)), cfg);
+    auto ids      = std::vector<int>(result.size());
+    auto filename = make_temp_path();
+    std::iota(ids.begin(), ids.end(), 0);
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        auto status = mio::save_result(result, ids, cfg.num_agegroups, filename);
+        if (!status) {
+            state.SkipWithError(status.error().formatted_message().c_str());
+            break;
+        }
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+    boost::filesystem::remove_all(filename);
+}
+
+/**
+ * @brief read the result of a graph from an hdf5 file.
+ * The number of nodes is the argument of the benchmark.
+ */
+void read_result(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg      = mio::benchmark::IoConfig::initialize("benchmarks/io.config");
+    auto result   = make_result(size_t(state.range(0)), cfg);
+    auto ids      = std::vector<int>(result.size());
+    auto filename = make_temp_path();
+    std::iota(ids.begin(), ids.end(), 0);
+    auto status = mio::save_result(result, ids, cfg.num_agegroups, filename);
+    if (!status) {
+        state.SkipWithError(status.error().formatted_message().c_str());
+    }
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        auto read = mio::read_result(filename);
+        if (!read) {
+            state.SkipWithError(read.error().formatted_message().c_str());
+            break;
+        }
+        ::benchmark::DoNotOptimize(read);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+    boost::filesystem::remove_all(filename);
+}
+
+/**
+ * @brief write a graph of secir models to json files.
+ * The number of nodes is the argument of the benchmark.
+ */
+void write_graph(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg       = mio::benchmark::IoConfig::initialize("benchmarks/io.config");
+    auto graph     = make_graph(size_t(state.range(0)), cfg);
+    auto directory = make_temp_path();
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        auto status = mio::write_graph(graph, directory);
+        if (!status) {
+            state.SkipWithError(status.error().formatted_message().c_str());
+            break;
+        }
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+    boost::filesystem::remove_all(directory);
+}
+
+/**
+ * @brief read a graph of secir models from json files.
+ * The number of nodes is the argument of the benchmark.
+ */
+void read_graph(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg       = mio::benchmark::IoConfig::initialize("benchmarks/io.config");
+    auto graph     = make_graph(size_t(state.range(0)), cfg);
+    auto directory = make_temp_path();
+    auto status    = mio::write_graph(graph, directory);
+    if (!status) {
+        state.SkipWithError(status.error().formatted_message().c_str());
+    }
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        auto read = mio::read_graph<mio::osecir::Model>(directory);
+        if (!read) {
+            state.SkipWithError(read.error().formatted_message().c_str());
+            break;
+        }
+        ::benchmark::DoNotOptimize(read);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+    boost::filesystem::remove_all(directory);
+}
+
+/**
+ * @brief compute a percentile of the results of an ensemble of graph simulations.
+ * The number of nodes is the argument of the benchmark.
+ */
+void ensemble_percentile(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg = mio::benchmark::IoConfig::initialize("benchmarks/io.config");
+    std::vector<std::vector<mio::TimeSeries<double>>> ensemble;
+    ensemble.reserve(size_t(cfg.num_runs));
+    for (int run = 0; run < cfg.num_runs; ++run) {
+        ensemble.push_back(make_result(size_t(state.range(0)), cfg));
+    }
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        auto percentile = mio::ensemble_percentile(ensemble, 0.05);
+        ::benchmark::DoNotOptimize(percentile);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+}
+
+// dummy runs to avoid large effects of cpu scaling on times of actual benchmarks
+BENCHMARK(ensemble_percentile)->Arg(1)->Name("Dummy 1/3");
+BENCHMARK(ensemble_percentile)->Arg(1)->Name("Dummy 2/3");
+BENCHMARK(ensemble_percentile)->Arg(1)->Name("Dummy 3/3");
+// register functions as a benchmarks and set a name
+BENCHMARK(save_result)->RangeMultiplier(10)->Range(1, 100)->Unit(::benchmark::kMillisecond)->Name("save_result");
+BENCHMARK(read_result)->RangeMultiplier(10)->Range(1, 100)->Unit(::benchmark::kMillisecond)->Name("read_result");
+// read_graph requires edges, so there is no graph with a single node
+BENCHMARK(write_graph)->RangeMultiplier(10)->Range(10, 100)->Unit(::benchmark::kMillisecond)->Name("write_graph");
+BENCHMARK(read_graph)->RangeMultiplier(10)->Range(10, 100)->Unit(::benchmark::kMillisecond)->Name("read_graph");
+BENCHMARK(ensemble_percentile)
+    ->RangeMultiplier(10)
+    ->Range(1, 100)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("ensemble_percentile");
+// run all benchmarks
+MEMILIO_BENCHMARK_MAIN();
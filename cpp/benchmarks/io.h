@@ -0,0 +1,82 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef IO_H_
+#define IO_H_
+
+#include "memilio/io/json_serializer.h"
+#include "memilio/utils/logging.h"
+
+#include "benchmark/benchmark.h"
+
+namespace mio
+{
+namespace benchmark
+{
+/// @brief parameters for io benchmark
+struct IoConfig {
+    int num_agegroups, num_time_points, num_runs, num_neighbors;
+    double migration_rate;
+    /**
+         * @brief creates configuration with default parameters for results and graphs of secir models
+         * @param num_agegroups number of agegroups
+         * @return configuration for io benchmark
+         */
+    static IoConfig initialize(int num_agegroups = 6)
+    {
+        return IoConfig{num_agegroups, 101, 100, 4, 0.01};
+    }
+    /**
+         * @brief reads configuration from json file
+         * @param path the path of the configfile
+         * @return configuration for io benchmark
+         */
+    static IoConfig initialize(std::string path)
+    {
+        auto result = mio::read_json(path, mio::Tag<IoConfig>{});
+        if (!result) { // failed to read config
+            mio::log(mio::LogLevel::critical, result.error().formatted_message());
+            abort();
+        }
+        return result.value();
+    }
+    /// @brief function implementing mio::deserialize, used by read_json in initialize
+    template <class IOContext>
+    static mio::IOResult<IoConfig> deserialize(IOContext& io)
+    {
+        auto obj                = io.expect_object("bench_io");
+        auto num_agegroups_io   = obj.expect_element("num_agegroups", mio::Tag<int>{});
+        auto num_time_points_io = obj.expect_element("num_time_points", mio::Tag<int>{});
+        auto num_runs_io        = obj.expect_element("num_runs", mio::Tag<int>{});
+        auto num_neighbors_io   = obj.expect_element("num_neighbors", mio::Tag<int>{});
+        auto migration_rate_io  = obj.expect_element("migration_rate", mio::Tag<double>{});
+        return mio::apply(
+            io,
+            [](auto&& num_agegroups, auto&& num_time_points, auto&& num_runs, auto&& num_neighbors,
+               auto&& migration_rate) {
+                return IoConfig{num_agegroups, num_time_points, num_runs, num_neighbors, migration_rate};
+            },
+            num_agegroups_io, num_time_points_io, num_runs_io, num_neighbors_io, migration_rate_io);
+    }
+};
+} // namespace benchmark
+
+} // namespace mio
+
+#endif
@@ -0,0 +1,201 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "benchmarks/metrics.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#ifndef MEMILIO_BENCHMARK_COMPILER
+#define MEMILIO_BENCHMARK_COMPILER "unknown"
+#endif
+#ifndef MEMILIO_BENCHMARK_CXX_FLAGS
+#define MEMILIO_BENCHMARK_CXX_FLAGS "unknown"
+#endif
+#ifndef MEMILIO_BENCHMARK_BUILD_TYPE
+#define MEMILIO_BENCHMARK_BUILD_TYPE "unknown"
+#endif
+
+namespace
+{
+//constant initialized, so it can be used by allocations during static initialization
+std::atomic<size_t> g_num_allocations{0};
+
+void count_allocation()
+{
+    g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+} // namespace
+
+#if defined(__GLIBC__)
+
+//replace the allocation functions of the C library to count all allocations, including those of Eigen
+//the memory is allocated by the implementation of glibc, so it can be freed as usual
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept
+{
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept
+{
+    count_allocation();
+    return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    count_allocation();
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept
+{
+    count_allocation();
+    auto p = __libc_memalign(alignment, size);
+    if (!p) {
+        return ENOMEM;
+    }
+    *ptr = p;
+    return 0;
+}
+}
+
+#else
+
+//replace the global operator new, only counts allocations of C++ code
+void* operator new(size_t size)
+{
+    count_allocation();
+    if (auto p = std::malloc(size > 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+namespace mio
+{
+namespace benchmark
+{
+
+size_t get_num_allocations()
+{
+    return g_num_allocations.load(std::memory_order_relaxed);
+}
+
+size_t get_peak_rss()
+{
+#if defined(__linux__)
+    //high water mark of the resident set, can be reset unlike the maximum reported by getrusage
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            size_t kb;
+            status >> kb;
+            return kb * 1024;
+        }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return 0;
+#elif defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return size_t(usage.ru_maxrss); //in bytes on macOS
+#else
+    return 0;
+#endif
+}
+
+void reset_peak_rss()
+{
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+#endif
+}
+
+MemoryMetrics::MemoryMetrics()
+{
+    reset_peak_rss();
+    m_start = get_num_allocations();
+}
+
+void MemoryMetrics::pause()
+{
+    if (!m_paused) {
+        m_num_allocations += get_num_allocations() - m_start;
+        m_paused = true;
+    }
+}
+
+void MemoryMetrics::resume()
+{
+    if (m_paused) {
+        m_start  = get_num_allocations();
+        m_paused = false;
+    }
+}
+
+void MemoryMetrics::set_counters(::benchmark::State& state)
+{
+    pause();
+    state.counters["allocs"] =
+        ::benchmark::Counter(double(m_num_allocations), ::benchmark::Counter::kAvgIterations);
+    state.counters["peak_rss"] = ::benchmark::Counter(double(get_peak_rss()), ::benchmark::Counter::kDefaults,
+                                                      ::benchmark::Counter::kIs1024);
+}
+
+void add_build_context()
+{
+    ::benchmark::AddCustomContext("memilio_compiler", MEMILIO_BENCHMARK_COMPILER);
+    ::benchmark::AddCustomContext("memilio_cxx_flags", MEMILIO_BENCHMARK_CXX_FLAGS);
+    ::benchmark::AddCustomContext("memilio_build_type", MEMILIO_BENCHMARK_BUILD_TYPE);
+}
+
+} // namespace benchmark
+} // namespace mio
@@ -0,0 +1,111 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+
+namespace mio
+{
+namespace benchmark
+{
+/**
+         * @brief number of heap allocations of the process so far.
+         * On systems with glibc, all calls of malloc and related functions are counted, so allocations of
+         * Eigen and C code are included. Otherwise only allocations with operator new are counted.
+         */
+size_t get_num_allocations();
+
+/**
+         * @brief peak resident set size of the process in bytes.
+         * Since the last call of reset_peak_rss if supported, otherwise since the start of the process.
+         * @return peak resident set size in bytes or 0 if it is not available on this system.
+         */
+size_t get_peak_rss();
+
+/**
+         * @brief reset the peak resident set size to the current resident set size.
+         * Only supported on linux, does nothing on other systems.
+         */
+void reset_peak_rss();
+
+/**
+         * @brief measures the memory usage of a benchmark, reported in addition to the time.
+         * Allocations are only counted while the measurement is not paused, pause it together
+         * with the timing of the benchmark to exclude the setup. The peak memory includes the setup.
+         */
+class MemoryMetrics
+{
+public:
+    /**
+         * @brief start measuring.
+         * Resets the peak resident set size.
+         */
+    MemoryMetrics();
+
+    /**
+         * @brief pause or resume counting allocations.
+         * @{
+         */
+    void pause();
+    void resume();
+    /**@}*/
+
+    /**
+         * @brief set the counters "allocs" (per iteration) and "peak_rss" (in bytes) of the benchmark.
+         * @param state state of the benchmark after the last iteration.
+         */
+    void set_counters(::benchmark::State& state);
+
+private:
+    size_t m_num_allocations = 0;
+    size_t m_start           = 0;
+    bool m_paused            = false;
+};
+
+/**
+         * @brief add the compiler and the compiler flags that the benchmarks are built with to the context
+         * that is written at the start of the benchmark output.
+         */
+void add_build_context();
+
+} // namespace benchmark
+
+} // namespace mio
+
+/**
+ * @brief main function of a benchmark executable, like BENCHMARK_MAIN, with additional build context.
+ */
+#define MEMILIO_BENCHMARK_MAIN()                                                                                       \
+    int main(int argc, char** argv)                                                                                    \
+    {                                                                                                                  \
+        ::benchmark::Initialize(&argc, argv);                                                                          \
+        if (::benchmark::ReportUnrecognizedArguments(argc, argv))                                                      \
+            return 1;                                                                                                  \
+        ::mio::benchmark::add_build_context();                                                                         \
+        ::benchmark::RunSpecifiedBenchmarks();                                                                         \
+        ::benchmark::Shutdown();                                                                                       \
+        return 0;                                                                                                      \
+    }                                                                                                                  \
+    int main(int, char**)
+
+#endif
@@ -0,0 +1,102 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "benchmarks/parameter_study.h"
+#include "benchmarks/graph_setups.h"
+#include "benchmarks/metrics.h"
+#include "benchmarks/secir_ageres_setups.h"
+
+#include "memilio/compartments/parameter_studies.h"
+#include "models/ode_secir/model.h"
+#include "models/ode_secir/parameter_space.h"
+
+/**
+ * @brief run a parameter study on a graph of secir models.
+ * The number of nodes is the argument of the benchmark.
+ */
+void parameter_study(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg   = mio::benchmark::ParameterStudyConfig::initialize("benchmarks/parameter_study.config");
+    auto graph = mio::benchmark::graph::make_graph(mio::benchmark::model::SecirAgeres(size_t(cfg.num_agegroups)),
+                                                   size_t(state.range(0)), size_t(cfg.num_neighbors),
+                                                   cfg.migration_rate);
+    auto study = mio::ParameterStudy<mio::osecir::Simulation<>>(graph, cfg.t0, cfg.t_max, cfg.dev_rel, cfg.dt,
+                                                                size_t(cfg.num_runs));
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        study.run(
+            [](auto&& g) {
+                return mio::osecir::draw_sample(g);
+            },
+            [](auto&& results) {
+                ::benchmark::DoNotOptimize(results);
+            });
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+    state.counters["runs"]          = double(cfg.num_runs);
+}
+
+/**
+ * @brief only draw the samples of a parameter study on a graph of secir models, without simulating.
+ * The number of nodes is the argument of the benchmark.
+ */
+void draw_sample(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg   = mio::benchmark::ParameterStudyConfig::initialize("benchmarks/parameter_study.config");
+    auto graph = mio::benchmark::graph::make_graph(mio::benchmark::model::SecirAgeres(size_t(cfg.num_agegroups)),
+                                                   size_t(state.range(0)), size_t(cfg.num_neighbors),
+                                                   cfg.migration_rate);
+    for (auto& node : graph.nodes()) {
+        mio::osecir::set_params_distributions_normal(node.property, cfg.t0, cfg.t_max, cfg.dev_rel);
+    }
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        auto sampled_graph = mio::osecir::draw_sample(graph);
+        ::benchmark::DoNotOptimize(sampled_graph);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+    state.counters["num_nodes"]     = double(state.range(0));
+}
+
+// dummy runs to avoid large effects of cpu scaling on times of actual benchmarks
+BENCHMARK(parameter_study)->Arg(1)->Name("Dummy 1/3");
+BENCHMARK(parameter_study)->Arg(1)->Name("Dummy 2/3");
+BENCHMARK(parameter_study)->Arg(1)->Name("Dummy 3/3");
+// register functions as a benchmarks and set a name
+BENCHMARK(parameter_study)
+    ->RangeMultiplier(10)
+    ->Range(1, 100)
+    ->Unit(::benchmark::kMillisecond)
+    ->Name("parameter study SecirModel graph");
+BENCHMARK(draw_sample)->RangeMultiplier(10)->Range(1, 100)->Name("draw_sample SecirModel graph");
+// run all benchmarks
+MEMILIO_BENCHMARK_MAIN();
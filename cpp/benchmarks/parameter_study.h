@@ -0,0 +1,86 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef PARAMETER_STUDY_H_
+#define PARAMETER_STUDY_H_
+
+#include "memilio/io/json_serializer.h"
+#include "memilio/utils/logging.h"
+
+#include "benchmark/benchmark.h"
+
+namespace mio
+{
+namespace benchmark
+{
+/// @brief parameters for parameter study benchmark
+struct ParameterStudyConfig {
+    int num_agegroups, num_neighbors, num_runs;
+    double t0, t_max, dt, dev_rel, migration_rate;
+    /**
+         * @brief creates configuration with default parameters for a parameter study of a graph of secir models
+         * @param num_agegroups number of agegroups
+         * @return configuration for parameter study benchmark
+         */
+    static ParameterStudyConfig initialize(int num_agegroups = 6)
+    {
+        return ParameterStudyConfig{num_agegroups, 4, 10, 0, 30, 0.5, 0.2, 0.01};
+    }
+    /**
+         * @brief reads configuration from json file
+         * @param path the path of the configfile
+         * @return configuration for parameter study benchmark
+         */
+    static ParameterStudyConfig initialize(std::string path)
+    {
+        auto result = mio::read_json(path, mio::Tag<ParameterStudyConfig>{});
+        if (!result) { // failed to read config
+            mio::log(mio::LogLevel::critical, result.error().formatted_message());
+            abort();
+        }
+        return result.value();
+    }
+    /// @brief function implementing mio::deserialize, used by read_json in initialize
+    template <class IOContext>
+    static mio::IOResult<ParameterStudyConfig> deserialize(IOContext& io)
+    {
+        auto obj               = io.expect_object("bench_parameter_study");
+        auto num_agegroups_io  = obj.expect_element("num_agegroups", mio::Tag<int>{});
+        auto num_neighbors_io  = obj.expect_element("num_neighbors", mio::Tag<int>{});
+        auto num_runs_io       = obj.expect_element("num_runs", mio::Tag<int>{});
+        auto t_io              = obj.expect_element("t0", mio::Tag<double>{});
+        auto t_max_io          = obj.expect_element("t_max", mio::Tag<double>{});
+        auto dt_io             = obj.expect_element("dt", mio::Tag<double>{});
+        auto dev_rel_io        = obj.expect_element("dev_rel", mio::Tag<double>{});
+        auto migration_rate_io = obj.expect_element("migration_rate", mio::Tag<double>{});
+        return mio::apply(
+            io,
+            [](auto&& num_agegroups, auto&& num_neighbors, auto&& num_runs, auto&& t0, auto&& t_max, auto&& dt,
+               auto&& dev_rel, auto&& migration_rate) {
+                return ParameterStudyConfig{num_agegroups, num_neighbors, num_runs, t0,
+                                            t_max,         dt,            dev_rel,  migration_rate};
+            },
+            num_agegroups_io, num_neighbors_io, num_runs_io, t_io, t_max_io, dt_io, dev_rel_io, migration_rate_io);
+    }
+};
+} // namespace benchmark
+
+} // namespace mio
+
+#endif
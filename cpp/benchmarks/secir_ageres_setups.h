@@ -178,6 +178,23 @@ mio::osecir::Model SecirAgeresAbsurdDampings(size_t num_agegroups)
 
     return model;
 }
+/**
+         * @brief Secir model with consistent setup for use in benchmarking stiff integrators.
+         * ICU capacity is exceeded so the smoothed transitions are active and critical cases resolve very fast.
+         */
+mio::osecir::Model SecirAgeresStiff(size_t num_agegroups)
+{
+    mio::osecir::Model model = mio::benchmark::model::SecirAgeres(num_agegroups);
+
+    auto& params = model.parameters;
+    params.set<mio::osecir::ICUCapacity>(5);
+    for (auto i = mio::AgeGroup(0); i < params.get_num_groups(); i++) {
+        // shorter than allowed by the constraints of the parameters, so they are not applied again
+        params.get<mio::osecir::TimeInfectedCritical>()[i] = 0.01;
+    }
+
+    return model;
+}
 } // namespace model
 } // namespace benchmark
 
@@ -0,0 +1,115 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef SECIRVVS_AGERES_SETUPS_H_
+#define SECIRVVS_AGERES_SETUPS_H_
+
+#include "models/ode_secirvvs/model.h"
+
+namespace mio
+{
+namespace benchmark
+{
+namespace model
+{
+/**
+         * @brief Secirvvs model with consistent setup for use in benchmarking.
+         */
+mio::osecirvvs::Model SecirvvsAgeres(size_t num_agegroups)
+{
+    using IS = mio::osecirvvs::InfectionState;
+
+    mio::osecirvvs::Model model((int)num_agegroups);
+    auto nb_groups = model.parameters.get_num_groups();
+    double fact    = 1.0 / (double)(size_t)nb_groups;
+
+    auto& params = model.parameters;
+    params.get<mio::osecirvvs::ICUCapacity>()          = 100;
+    params.get<mio::osecirvvs::TestAndTraceCapacity>() = 0.0143;
+    params.get<mio::osecirvvs::Seasonality>()          = 0.2;
+    params.get<mio::osecirvvs::DailyFirstVaccination>().resize(mio::SimulationDay(size_t(1000)));
+    params.get<mio::osecirvvs::DailyFirstVaccination>().array().setConstant(5);
+    params.get<mio::osecirvvs::DailyFullVaccination>().resize(mio::SimulationDay(size_t(1000)));
+    params.get<mio::osecirvvs::DailyFullVaccination>().array().setConstant(3);
+
+    for (auto i = mio::AgeGroup(0); i < nb_groups; i++) {
+        model.populations[{i, IS::ExposedNaive}]                                = fact * 100;
+        model.populations[{i, IS::ExposedPartialImmunity}]                      = fact * 50;
+        model.populations[{i, IS::ExposedImprovedImmunity}]                     = fact * 50;
+        model.populations[{i, IS::InfectedNoSymptomsNaive}]                     = fact * 50;
+        model.populations[{i, IS::InfectedNoSymptomsNaiveConfirmed}]            = fact * 10;
+        model.populations[{i, IS::InfectedNoSymptomsPartialImmunity}]           = fact * 25;
+        model.populations[{i, IS::InfectedNoSymptomsPartialImmunityConfirmed}]  = fact * 5;
+        model.populations[{i, IS::InfectedNoSymptomsImprovedImmunity}]          = fact * 25;
+        model.populations[{i, IS::InfectedNoSymptomsImprovedImmunityConfirmed}] = fact * 5;
+        model.populations[{i, IS::InfectedSymptomsNaive}]                       = fact * 50;
+        model.populations[{i, IS::InfectedSymptomsNaiveConfirmed}]              = fact * 10;
+        model.populations[{i, IS::InfectedSymptomsPartialImmunity}]             = fact * 25;
+        model.populations[{i, IS::InfectedSymptomsPartialImmunityConfirmed}]    = fact * 5;
+        model.populations[{i, IS::InfectedSymptomsImprovedImmunity}]            = fact * 25;
+        model.populations[{i, IS::InfectedSymptomsImprovedImmunityConfirmed}]   = fact * 5;
+        model.populations[{i, IS::InfectedSevereNaive}]                         = fact * 20;
+        model.populations[{i, IS::InfectedSeverePartialImmunity}]               = fact * 5;
+        model.populations[{i, IS::InfectedSevereImprovedImmunity}]              = fact * 5;
+        model.populations[{i, IS::InfectedCriticalNaive}]                       = fact * 10;
+        model.populations[{i, IS::InfectedCriticalPartialImmunity}]             = fact * 2;
+        model.populations[{i, IS::InfectedCriticalImprovedImmunity}]            = fact * 2;
+        model.populations[{i, IS::SusceptiblePartialImmunity}]                  = fact * 2000;
+        model.populations[{i, IS::SusceptibleImprovedImmunity}]                 = fact * 1000;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>({i, IS::SusceptibleNaive}, fact * 10000);
+
+        params.get<mio::osecirvvs::IncubationTime>()[i]       = 5.2;
+        params.get<mio::osecirvvs::SerialInterval>()[i]       = 4.2;
+        params.get<mio::osecirvvs::TimeInfectedSymptoms>()[i] = 7;
+        params.get<mio::osecirvvs::TimeInfectedSevere>()[i]   = 6;
+        params.get<mio::osecirvvs::TimeInfectedCritical>()[i] = 7;
+
+        params.get<mio::osecirvvs::TransmissionProbabilityOnContact>()[i]  = 0.15;
+        params.get<mio::osecirvvs::RelativeTransmissionNoSymptoms>()[i]    = 0.5;
+        params.get<mio::osecirvvs::RiskOfInfectionFromSymptomatic>()[i]    = 0.0;
+        params.get<mio::osecirvvs::MaxRiskOfInfectionFromSymptomatic>()[i] = 0.4;
+        params.get<mio::osecirvvs::RecoveredPerInfectedNoSymptoms>()[i]    = 0.2;
+        params.get<mio::osecirvvs::SeverePerInfectedSymptoms>()[i]         = 0.1;
+        params.get<mio::osecirvvs::CriticalPerSevere>()[i]                 = 0.1;
+        params.get<mio::osecirvvs::DeathsPerCritical>()[i]                 = 0.1;
+
+        params.get<mio::osecirvvs::ReducExposedPartialImmunity>()[i]                     = 0.8;
+        params.get<mio::osecirvvs::ReducExposedImprovedImmunity>()[i]                    = 0.331;
+        params.get<mio::osecirvvs::ReducInfectedSymptomsPartialImmunity>()[i]            = 0.65;
+        params.get<mio::osecirvvs::ReducInfectedSymptomsImprovedImmunity>()[i]           = 0.243;
+        params.get<mio::osecirvvs::ReducInfectedSevereCriticalDeadPartialImmunity>()[i]  = 0.1;
+        params.get<mio::osecirvvs::ReducInfectedSevereCriticalDeadImprovedImmunity>()[i] = 0.091;
+        params.get<mio::osecirvvs::ReducTimeInfectedMild>()[i]                           = 0.9;
+    }
+
+    mio::ContactMatrixGroup& contact_matrix = params.get<mio::osecirvvs::ContactPatterns>().get_cont_freq_mat();
+    contact_matrix[0] = mio::ContactMatrix(Eigen::MatrixXd::Constant((size_t)nb_groups, (size_t)nb_groups, fact * 10));
+    contact_matrix.add_damping(Eigen::MatrixXd::Constant((size_t)nb_groups, (size_t)nb_groups, 0.7),
+                               mio::SimulationTime(30.));
+
+    model.apply_constraints();
+
+    return model;
+}
+} // namespace model
+} // namespace benchmark
+
+} // namespace mio
+
+#endif
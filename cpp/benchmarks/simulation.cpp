@@ -19,9 +19,11 @@
 */
 #include "benchmarks/simulation.h"
 #include "benchmarks/secir_ageres_setups.h"
+#include "benchmarks/metrics.h"
 
 #include "memilio/math/adapt_rk.h"
 #include "memilio/math/stepper_wrapper.h"
+#include "memilio/math/rosenbrock.h"
 
 template <class Integrator>
 void simulation(::benchmark::State& state)
@@ -33,12 +35,57 @@ void simulation(::benchmark::State& state)
     //auto cfg = mio::benchmark::SimulationConfig::initialize(10);
     auto model = mio::benchmark::model::SecirAgeres(cfg.num_agegroups);
 
+    mio::benchmark::MemoryMetrics memory;
     for (auto _ : state) {
         // This code gets timed
         std::shared_ptr<mio::IntegratorCore> I =
             std::make_shared<Integrator>(cfg.abs_tol, cfg.rel_tol, cfg.dt_min, cfg.dt_max);
+        auto result = simulate(cfg.t0, cfg.t_max, cfg.dt, model, I);
+        state.counters["steps"] = double(result.get_num_time_points() - 1);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+}
+
+template <class Integrator>
+void stiff_simulation(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters
+    auto cfg   = mio::benchmark::SimulationConfig::initialize("benchmarks/simulation.config");
+    auto model = mio::benchmark::model::SecirAgeresStiff(cfg.num_agegroups);
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        std::shared_ptr<mio::IntegratorCore> I =
+            std::make_shared<Integrator>(cfg.abs_tol, cfg.rel_tol, cfg.dt_min, cfg.dt_max);
+        auto result = simulate(cfg.t0, cfg.t_max, cfg.dt, model, I);
+        state.counters["steps"] = double(result.get_num_time_points() - 1);
+    }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = double(cfg.num_agegroups);
+}
+
+template <class Model>
+void simulation_6_agegroups(::benchmark::State& state)
+{
+    // suppress non-critical messages
+    mio::set_log_level(mio::LogLevel::critical);
+    // setup benchmark parameters, 6 age groups as in RKI data
+    auto cfg = mio::benchmark::SimulationConfig::initialize("benchmarks/simulation.config");
+    Model model(mio::benchmark::model::SecirAgeres(6));
+
+    mio::benchmark::MemoryMetrics memory;
+    for (auto _ : state) {
+        // This code gets timed
+        std::shared_ptr<mio::IntegratorCore> I =
+            std::make_shared<mio::RKIntegratorCore>(cfg.abs_tol, cfg.rel_tol, cfg.dt_min, cfg.dt_max);
         simulate(cfg.t0, cfg.t_max, cfg.dt, model, I);
     }
+    memory.set_counters(state);
+    state.counters["num_agegroups"] = 6;
 }
 
 // dummy runs to avoid large effects of cpu scaling on times of actual benchmarks
@@ -53,5 +100,15 @@ BENCHMARK_TEMPLATE(simulation, mio::ControlledStepperWrapper<boost::numeric::ode
     ->Name("simulate SecirModel boost rk_dopri5");
 BENCHMARK_TEMPLATE(simulation, mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_fehlberg78>)
     ->Name("simulate SecirModel boost rkf78");
+BENCHMARK_TEMPLATE(simulation, mio::RosenbrockIntegratorCore)->Name("simulate SecirModel rosenbrock");
+// compare explicit and implicit integrators on a stiff problem
+BENCHMARK_TEMPLATE(stiff_simulation, mio::RKIntegratorCore)->Name("simulate stiff SecirModel adapt_rk");
+BENCHMARK_TEMPLATE(stiff_simulation, mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>)
+    ->Name("simulate stiff SecirModel boost rk_ck54");
+BENCHMARK_TEMPLATE(stiff_simulation, mio::RosenbrockIntegratorCore)->Name("simulate stiff SecirModel rosenbrock");
+// compare number of age groups known at runtime and at compile time
+BENCHMARK_TEMPLATE(simulation_6_agegroups, mio::osecir::Model)->Name("simulate SecirModel 6 age groups");
+BENCHMARK_TEMPLATE(simulation_6_agegroups, mio::osecir::FixedSizeModel<6>)
+    ->Name("simulate SecirModel 6 fixed size age groups");
 // run all benchmarks
-BENCHMARK_MAIN();
+MEMILIO_BENCHMARK_MAIN();
@@ -0,0 +1,234 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_COMPARTMENTS_BATCH_SIMULATION_H
+#define MIO_COMPARTMENTS_BATCH_SIMULATION_H
+
+#include "memilio/config.h"
+#include "memilio/compartments/compartmentalmodel.h"
+#include "memilio/math/adapt_rk.h"
+#include "memilio/utils/logging.h"
+#include "memilio/utils/time_series.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * @brief Simulation of many instances of a compartment model in lockstep, e.g., the members of an ensemble
+ * with different sampled parameters.
+ * All models must have the same number of compartments. The states of all models are integrated as one
+ * (compartments x models) matrix with a shared adaptive step size that satisfies the tolerances in every model.
+ * This avoids the overhead of stepping each model on its own, which dominates for small models.
+ * Only the ODE of the model is integrated, simulations that do more, e.g., implement dynamic NPIs,
+ * must be run on their own.
+ * @tparam M a CompartmentModel type
+ */
+template <class M>
+class BatchSimulation
+{
+    static_assert(is_compartment_model<M>::value, "Template parameter must be a compartment model.");
+
+public:
+    using Model = M;
+
+    /**
+     * @brief setup the simulation of a batch of models.
+     * @param[in] models the models to simulate, at least one.
+     * @param[in] t0 start time
+     * @param[in] dt initial step size of integration
+     */
+    BatchSimulation(std::vector<Model> models, double t0 = 0., double dt = 0.1)
+        : m_models(std::move(models))
+        , m_integrator_core(std::make_shared<BatchRKIntegratorCore>())
+        , m_dt(dt)
+    {
+        assert(!m_models.empty());
+        auto num_compartments = m_models[0].get_initial_values().size();
+        m_state.resize(num_compartments, Eigen::Index(m_models.size()));
+        m_results.reserve(m_models.size());
+        for (size_t k = 0; k < m_models.size(); ++k) {
+            m_state.col(Eigen::Index(k)) = m_models[k].get_initial_values();
+            m_results.emplace_back(t0, m_state.col(Eigen::Index(k)));
+        }
+        m_next_state.resize(m_state.rows(), m_state.cols());
+    }
+
+    /**
+     * @brief set the core integrator used in the simulation
+     */
+    void set_integrator(std::shared_ptr<BatchRKIntegratorCore> integrator)
+    {
+        m_integrator_core = std::move(integrator);
+    }
+
+    /**
+     * @brief get_integrator
+     * @return reference to the core integrator used in the simulation
+     * @{
+     */
+    BatchRKIntegratorCore& get_integrator()
+    {
+        return *m_integrator_core;
+    }
+    const BatchRKIntegratorCore& get_integrator() const
+    {
+        return *m_integrator_core;
+    }
+    /**@}*/
+
+    /**
+     * @brief advance all simulations to tmax
+     * tmax must be greater than the last time point of the results.
+     * @param tmax next stopping point of simulation
+     * @return the current state of all models, one column for each model.
+     */
+    Eigen::Ref<Eigen::MatrixXd> advance(double tmax)
+    {
+        auto f = [this](Eigen::Ref<const Eigen::MatrixXd> y, double t, Eigen::Ref<Eigen::MatrixXd> dydt) {
+            for (size_t k = 0; k < m_models.size(); ++k) {
+                auto col = Eigen::Index(k);
+                m_models[k].eval_right_hand_side(y.col(col), y.col(col), t, dydt.col(col));
+            }
+        };
+
+        const double t0 = get_time();
+        assert(tmax > t0);
+
+        //same stepping as OdeIntegrator::advance
+        bool step_okay = true;
+        double t       = t0;
+        while (std::abs((tmax - t) / (tmax - t0)) > 1e-10) {
+            auto dt_eff = std::min(m_dt, tmax - t);
+            step_okay &= m_integrator_core->step(f, m_state, t, dt_eff, m_next_state);
+            m_state.swap(m_next_state);
+            for (size_t k = 0; k < m_models.size(); ++k) {
+                m_results[k].add_time_point(t, m_state.col(Eigen::Index(k)));
+            }
+
+            if (std::abs((tmax - t) / (tmax - t0)) > 1e-10 || dt_eff > m_dt) {
+                m_dt = dt_eff;
+            }
+        }
+
+        if (!step_okay) {
+            log_warning("Adaptive step sizing failed.");
+        }
+        else if (std::abs((tmax - t) / (tmax - t0)) > 1e-15) {
+            log_warning("Last time step too small. Could not reach tmax exactly.");
+        }
+        else {
+            log_debug("Adaptive step sizing successful to tolerances.");
+        }
+
+        return m_state;
+    }
+
+    /**
+     * @brief current time of all simulations.
+     */
+    double get_time() const
+    {
+        return m_results[0].get_last_time();
+    }
+
+    /**
+     * @brief number of models in the batch.
+     */
+    size_t get_num_models() const
+    {
+        return m_models.size();
+    }
+
+    /**
+     * @brief result of one of the models.
+     * All results have the same time points.
+     * @param k index of the model in the batch.
+     * @return a TimeSeries to represent the simulation result.
+     * @{
+     */
+    TimeSeries<ScalarType>& get_result(size_t k)
+    {
+        return m_results[k];
+    }
+    const TimeSeries<ScalarType>& get_result(size_t k) const
+    {
+        return m_results[k];
+    }
+    /**@}*/
+
+    /**
+     * @brief one of the models used in the simulation.
+     * @param k index of the model in the batch.
+     * @{
+     */
+    Model& get_model(size_t k)
+    {
+        return m_models[k];
+    }
+    const Model& get_model(size_t k) const
+    {
+        return m_models[k];
+    }
+    /**@}*/
+
+private:
+    std::vector<Model> m_models;
+    std::shared_ptr<BatchRKIntegratorCore> m_integrator_core;
+    double m_dt;
+    Eigen::MatrixXd m_state, m_next_state; // one column for each model
+    std::vector<TimeSeries<ScalarType>> m_results;
+};
+
+/**
+ * @brief simulates a batch of compartment models in lockstep.
+ * @param[in] t0 start time
+ * @param[in] tmax end time
+ * @param[in] dt initial step size of integration
+ * @param[in] models the models to simulate
+ * @param[in] integrator optional integrator, BatchRKIntegratorCore with default tolerances otherwise.
+ * @return the simulation results of the models in the same order.
+ * @tparam Model a compartment model type
+ */
+template <class Model>
+std::vector<TimeSeries<ScalarType>> simulate_batch(double t0, double tmax, double dt, std::vector<Model> models,
+                                                   std::shared_ptr<BatchRKIntegratorCore> integrator = nullptr)
+{
+    for (auto& model : models) {
+        model.check_constraints();
+    }
+    BatchSimulation<Model> sim(std::move(models), t0, dt);
+    if (integrator) {
+        sim.set_integrator(integrator);
+    }
+    sim.advance(tmax);
+    std::vector<TimeSeries<ScalarType>> results;
+    results.reserve(sim.get_num_models());
+    for (size_t k = 0; k < sim.get_num_models(); ++k) {
+        results.push_back(std::move(sim.get_result(k)));
+    }
+    return results;
+}
+
+} // namespace mio
+
+#endif // MIO_COMPARTMENTS_BATCH_SIMULATION_H
@@ -0,0 +1,225 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_COMPARTMENTS_FLOW_MODEL_H
+#define MIO_COMPARTMENTS_FLOW_MODEL_H
+
+#include "memilio/compartments/compartmentalmodel.h"
+#include "memilio/math/eigen.h"
+
+#include <utility>
+
+namespace mio
+{
+
+/**
+ * @brief a flow of people from a source compartment to a target compartment.
+ * @tparam Comp enum type of the compartments.
+ * @tparam Source compartment that people leave.
+ * @tparam Target compartment that people enter.
+ */
+template <class Comp, Comp Source, Comp Target>
+struct Flow {
+    using Compartments = Comp;
+    static constexpr Comp source()
+    {
+        return Source;
+    }
+    static constexpr Comp target()
+    {
+        return Target;
+    }
+};
+
+/**
+ * @brief compile time list of all flows of a model.
+ * The position of a flow in the list is its index in the vector of flow values.
+ * @tparam Flows list of Flow types with the same compartments.
+ */
+template <class... Flows>
+struct FlowChart {
+    static_assert(sizeof...(Flows) > 0, "A flow chart needs at least one flow.");
+
+    /**
+     * @brief number of flows in the chart.
+     */
+    static constexpr size_t size()
+    {
+        return sizeof...(Flows);
+    }
+
+    /**
+     * @brief index of the flow from source to target in the chart.
+     * @return the index or size() if the chart does not contain the flow.
+     */
+    template <class Comp>
+    static constexpr size_t get_index(Comp source, Comp target)
+    {
+        const Comp sources[] = {Flows::source()...};
+        const Comp targets[] = {Flows::target()...};
+        for (size_t i = 0; i < size(); ++i) {
+            if (sources[i] == source && targets[i] == target) {
+                return i;
+            }
+        }
+        return size();
+    }
+
+    /**
+     * @brief subtract each flow from its source and add it to its target.
+     * @param flow_values values of all flows in the chart.
+     * @param dydt compartments that the flows are applied to.
+     */
+    template <class FlowValues, class Compartments>
+    static void apply(const FlowValues& flow_values, Compartments&& dydt)
+    {
+        apply_impl(flow_values, dydt, std::make_index_sequence<size()>{});
+    }
+
+private:
+    template <class FlowValues, class Compartments, size_t... I>
+    static void apply_impl(const FlowValues& flow_values, Compartments& dydt, std::index_sequence<I...>)
+    {
+        using expander = int[];
+        (void)expander{0, (dydt[Eigen::Index(Flows::source())] -= flow_values[Eigen::Index(I)],
+                           dydt[Eigen::Index(Flows::target())] += flow_values[Eigen::Index(I)], 0)...};
+    }
+};
+
+/**
+ * @brief a compartment model that is defined by the flows between its compartments.
+ *
+ * Instead of the derivatives of all compartments, a model only computes the value of each flow in get_flows.
+ * The derivatives are generated from the flow chart at compile time: each flow is subtracted from its source
+ * and added to its target without any lookup or allocation. The flows can also be integrated directly by a
+ * FlowSimulation, e.g., to get the number of new infections in each time step.
+ *
+ * The compartments must be the last category of the populations. All other categories, e.g., age groups, define
+ * subgroups that have the same flows. The values of the flows are stored by subgroup first,
+ * see get_flat_flow_index.
+ * @tparam Comp enum type of the compartments.
+ * @tparam Pop type of the populations, the last category must be Comp.
+ * @tparam Params type of the parameter set.
+ * @tparam Flows FlowChart of all flows of the model.
+ */
+template <class Comp, class Pop, class Params, class Flows>
+class FlowModel : public CompartmentalModel<Comp, Pop, Params>
+{
+    using Base = CompartmentalModel<Comp, Pop, Params>;
+
+public:
+    using FlowChart = Flows;
+
+    FlowModel(const Pop& pop, const Params& params)
+        : Base(pop, params)
+        , m_flow_values(get_num_flows())
+    {
+    }
+
+    /**
+     * @brief number of compartments in each subgroup.
+     */
+    static constexpr size_t get_num_compartments_per_subgroup()
+    {
+        return size_t(Comp::Count);
+    }
+
+    /**
+     * @brief number of subgroups, e.g., age groups, that have the same flows.
+     */
+    size_t get_num_subgroups() const
+    {
+        return this->populations.get_num_compartments() / get_num_compartments_per_subgroup();
+    }
+
+    /**
+     * @brief number of flows in all subgroups.
+     */
+    size_t get_num_flows() const
+    {
+        return get_num_subgroups() * Flows::size();
+    }
+
+    /**
+     * @brief index of a flow in the vector of flow values.
+     * @tparam Source source compartment of the flow.
+     * @tparam Target target compartment of the flow.
+     * @param subgroup flat index of the subgroup, e.g., the age group.
+     */
+    template <Comp Source, Comp Target>
+    static size_t get_flat_flow_index(size_t subgroup = 0)
+    {
+        constexpr size_t index = Flows::get_index(Source, Target);
+        static_assert(index < Flows::size(), "Flow is not in the flow chart of the model.");
+        return subgroup * Flows::size() + index;
+    }
+
+    /**
+     * @brief compute the values of all flows.
+     * Implemented by each model. The flow values are initialized to zero.
+     * @param pop the current population of the model, used e.g. for the force of infection.
+     * @param y the current state of the compartments.
+     * @param t the current time.
+     * @param flow_values the value of each flow, see get_flat_flow_index.
+     */
+    //REMARK: Not pure virtual for easier java/python bindings
+    virtual void get_flows(Eigen::Ref<const Eigen::VectorXd> /*pop*/, Eigen::Ref<const Eigen::VectorXd> /*y*/,
+                           double /*t*/, Eigen::Ref<Eigen::VectorXd> /*flow_values*/) const {};
+
+    /**
+     * @brief compute the derivatives of the compartments from the values of the flows.
+     * @param flow_values the value of each flow, see get_flat_flow_index.
+     * @param dydt the derivatives of all compartments.
+     */
+    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> flow_values, Eigen::Ref<Eigen::VectorXd> dydt) const
+    {
+        const auto num_comps = Eigen::Index(get_num_compartments_per_subgroup());
+        const auto num_flows = Eigen::Index(Flows::size());
+        dydt.setZero();
+        for (Eigen::Index i = 0; i < Eigen::Index(get_num_subgroups()); ++i) {
+            Flows::apply(flow_values.segment(i * num_flows, num_flows), dydt.segment(i * num_comps, num_comps));
+        }
+    }
+
+#if USE_DERIV_FUNC
+    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
+                         Eigen::Ref<Eigen::VectorXd> dydt) const override
+    {
+        m_flow_values.resize(get_num_flows());
+        m_flow_values.setZero();
+        get_flows(pop, y, t, m_flow_values);
+        get_derivatives(m_flow_values, dydt);
+    }
+#endif // USE_DERIV_FUNC
+
+    /**
+     * @brief initial values of the flows for a FlowSimulation, all zero.
+     */
+    Eigen::VectorXd get_initial_flows() const
+    {
+        return Eigen::VectorXd::Zero(get_num_flows());
+    }
+
+private:
+    mutable Eigen::VectorXd m_flow_values; //buffer so the evaluation doesn't allocate
+};
+
+} // namespace mio
+
+#endif // MIO_COMPARTMENTS_FLOW_MODEL_H
@@ -0,0 +1,208 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_COMPARTMENTS_FLOW_SIMULATION_H
+#define MIO_COMPARTMENTS_FLOW_SIMULATION_H
+
+#include "memilio/compartments/flow_model.h"
+#include "memilio/compartments/simulation.h"
+
+namespace mio
+{
+
+/**
+ * @brief simulation of a FlowModel that integrates the flows instead of the compartments.
+ *
+ * The state of the integrator is the accumulated value of each flow since the start of the simulation,
+ * e.g., the total number of new infections. The compartments are computed from the initial values and the
+ * accumulated flows, so no additional compartments are required to count transitions.
+ * @tparam M a FlowModel type.
+ */
+template <class M>
+class FlowSimulation
+{
+    static_assert(is_compartment_model<M>::value, "Template parameter must be a compartment model.");
+
+public:
+    using Model = M;
+
+    /**
+     * @brief setup the simulation with an ODE solver.
+     * @param[in] model an instance of a flow model.
+     * @param[in] t0 start time.
+     * @param[in] dt initial step size of integration.
+     */
+    FlowSimulation(Model const& model, double t0 = 0., double dt = 0.1)
+        : m_integratorCore(
+              std::make_shared<mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>>())
+        , m_model(std::make_unique<Model>(model))
+        , m_initial_values(m_model->get_initial_values())
+        , m_pop(m_initial_values.size())
+        , m_integrator(
+              [this](auto&& flows, auto&& t, auto&& dflows_dt) {
+                  MEMILIO_PROFILE_SCOPE("right_hand_side");
+                  get_compartments(flows, m_pop);
+                  dflows_dt.setZero();
+                  m_model->get_flows(m_pop, m_pop, t, dflows_dt);
+              },
+              t0, m_model->get_initial_flows(), dt, m_integratorCore)
+        , m_result(t0, m_initial_values)
+    {
+    }
+
+    //the integrator refers to this object
+    FlowSimulation(const FlowSimulation&) = delete;
+    FlowSimulation& operator=(const FlowSimulation&) = delete;
+
+    /**
+     * @brief set the core integrator used in the simulation.
+     */
+    void set_integrator(std::shared_ptr<IntegratorCore> integrator)
+    {
+        m_integratorCore = std::move(integrator);
+        m_integrator.set_integrator(m_integratorCore);
+    }
+
+    /**
+     * @brief get the core integrator used in the simulation.
+     * @{
+     */
+    IntegratorCore& get_integrator()
+    {
+        return *m_integratorCore;
+    }
+    IntegratorCore const& get_integrator() const
+    {
+        return *m_integratorCore;
+    }
+    /**@}*/
+
+    /**
+     * @brief advance simulation to tmax.
+     * tmax must be greater than get_result().get_last_time_point().
+     * @param tmax next stopping point of simulation.
+     * @return the compartments at tmax.
+     */
+    Eigen::Ref<Eigen::VectorXd> advance(double tmax)
+    {
+        m_integrator.advance(tmax);
+        auto& flows = m_integrator.get_result();
+        for (Eigen::Index i = m_result.get_num_time_points(); i < flows.get_num_time_points(); ++i) {
+            get_compartments(flows[i], m_result.add_time_point(flows.get_time(i)));
+        }
+        return m_result.get_last_value();
+    }
+
+    /**
+     * @brief the compartments at each time point of the simulation.
+     * @{
+     */
+    TimeSeries<ScalarType>& get_result()
+    {
+        return m_result;
+    }
+    const TimeSeries<ScalarType>& get_result() const
+    {
+        return m_result;
+    }
+    /**@}*/
+
+    /**
+     * @brief statistics of the integration, e.g., number of steps and evaluations of the right hand side.
+     */
+    const IntegratorStatistics& get_integrator_statistics() const
+    {
+        return m_integrator.get_statistics();
+    }
+
+    /**
+     * @brief the accumulated flows at each time point of the simulation.
+     * The difference between two time points is the number of people that moved along each flow in between,
+     * e.g., the number of new infections. See FlowModel::get_flat_flow_index for the order of the flows.
+     * @{
+     */
+    TimeSeries<ScalarType>& get_flows()
+    {
+        return m_integrator.get_result();
+    }
+    const TimeSeries<ScalarType>& get_flows() const
+    {
+        return m_integrator.get_result();
+    }
+    /**@}*/
+
+    /**
+     * @brief returns the simulation model used in simulation.
+     * @{
+     */
+    const Model& get_model() const
+    {
+        return *m_model;
+    }
+    Model& get_model()
+    {
+        return *m_model;
+    }
+    /**@}*/
+
+private:
+    /**
+     * @brief compute the compartments from the initial values and the accumulated flows.
+     */
+    template <class V>
+    void get_compartments(Eigen::Ref<const Eigen::VectorXd> flows, V&& compartments) const
+    {
+        m_model->get_derivatives(flows, compartments);
+        compartments += m_initial_values;
+    }
+
+    std::shared_ptr<IntegratorCore> m_integratorCore;
+    std::unique_ptr<Model> m_model;
+    Eigen::VectorXd m_initial_values;
+    Eigen::VectorXd m_pop;
+    OdeIntegrator m_integrator;
+    TimeSeries<ScalarType> m_result;
+};
+
+/**
+ * @brief simulate a flow model.
+ * @param[in] t0 start time.
+ * @param[in] tmax end time.
+ * @param[in] dt initial step size of integration.
+ * @param[in] model an instance of a flow model.
+ * @param[in] integrator optional integrator, uses runge_kutta_cash_karp54 if empty.
+ * @return the compartments and the accumulated flows at each time point of the simulation.
+ * @tparam Model a flow model type.
+ */
+template <class Model>
+std::vector<TimeSeries<ScalarType>> simulate_flows(double t0, double tmax, double dt, Model const& model,
+                                                   std::shared_ptr<IntegratorCore> integrator = nullptr)
+{
+    model.check_constraints();
+    FlowSimulation<Model> sim(model, t0, dt);
+    if (integrator) {
+        sim.set_integrator(integrator);
+    }
+    sim.advance(tmax);
+    return {sim.get_result(), sim.get_flows()};
+}
+
+} // namespace mio
+
+#endif // MIO_COMPARTMENTS_FLOW_SIMULATION_H
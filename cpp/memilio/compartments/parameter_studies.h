@@ -23,7 +23,11 @@
 #include "memilio/utils/time_series.h"
 #include "memilio/mobility/mobility.h"
 #include "memilio/compartments/simulation.h"
+#include "memilio/compartments/batch_simulation.h"
+#include "memilio/utils/profiling.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 
 namespace mio
@@ -67,7 +71,7 @@ public:
         , m_dt_graph_sim(graph_sim_dt)
     {
         for (auto& params_node : m_graph.nodes()) {
-            set_params_distributions_normal(params_node, t0, tmax, dev_rel);
+            set_params_distributions_normal(params_node.property, t0, tmax, dev_rel);
         }
     }
 
@@ -96,11 +100,16 @@ public:
     template <class SampleGraphFunction, class HandleSimulationResultFunction>
     void run(SampleGraphFunction sample_graph, HandleSimulationResultFunction result_processing_function)
     {
+        MEMILIO_PROFILE_SCOPE("ParameterStudy::run");
         // Iterate over all parameters in the parameter space
         for (size_t i = 0; i < m_num_runs; i++) {
-            auto sim = create_sampled_simulation(sample_graph);
+            auto sim = [&] {
+                MEMILIO_PROFILE_SCOPE("sample");
+                return create_sampled_simulation(sample_graph);
+            }();
             sim.advance(m_tmax);
 
+            MEMILIO_PROFILE_SCOPE("result_processing");
             result_processing_function(std::move(sim).get_graph());
         }
     }
@@ -123,6 +132,37 @@ public:
         return ensemble_result;
     }
 
+    /**
+     * @brief Carry out all simulations of a study for a single compartment model in batches.
+     * The simulations of a batch are integrated in lockstep with a shared step size, see BatchSimulation.
+     * Only the ODE of the model is integrated, so this is only equivalent to run() if the simulation type
+     * doesn't do more, e.g., implement dynamic NPIs.
+     * @param batch_size maximum number of simulations in one batch.
+     * @param sample_model function that receives the input model and returns a sampled copy.
+     * @param result_processing_function Processing function for simulation results, e.g., output function.
+     *                                   Receives the sampled model and the result after each run is completed.
+     */
+    template <class SampleModelFunction, class HandleSimulationResultFunction>
+    void run_batched(size_t batch_size, SampleModelFunction sample_model,
+                     HandleSimulationResultFunction result_processing_function)
+    {
+        assert(batch_size > 0);
+        for (size_t first_run = 0; first_run < m_num_runs; first_run += batch_size) {
+            auto num_runs_in_batch = std::min(batch_size, m_num_runs - first_run);
+            std::vector<typename Simulation::Model> models;
+            models.reserve(num_runs_in_batch);
+            for (size_t i = 0; i < num_runs_in_batch; i++) {
+                models.push_back(sample_model(get_model()));
+            }
+
+            BatchSimulation<typename Simulation::Model> sim(std::move(models), m_t0, m_dt_integration);
+            sim.advance(m_tmax);
+            for (size_t k = 0; k < sim.get_num_models(); k++) {
+                result_processing_function(std::move(sim.get_model(k)), std::move(sim.get_result(k)));
+            }
+        }
+    }
+
     /*
      * @brief sets the number of Monte Carlo runs
      * @param[in] num_runs number of runs
@@ -207,9 +247,10 @@ private:
     mio::GraphSimulation<mio::Graph<mio::SimulationNode<Simulation>, mio::MigrationEdge>>
     create_sampled_simulation(SampleGraphFunction sample_graph)
     {
-        mio::Graph<mio::SimulationNode<Simulation>, mio::MigrationEdge> sim_graph;
+        mio::GraphBuilder<mio::SimulationNode<Simulation>, mio::MigrationEdge> sim_graph;
 
         auto sampled_graph = sample_graph(m_graph);
+        sim_graph.reserve(sampled_graph.nodes().size(), sampled_graph.edges().size());
         for (auto&& node : sampled_graph.nodes()) {
             sim_graph.add_node(node.id, node.property, m_t0, m_dt_integration);
         }
@@ -217,7 +258,7 @@ private:
             sim_graph.add_edge(edge.start_node_idx, edge.end_node_idx, edge.property);
         }
 
-        return make_migration_sim(m_t0, m_dt_graph_sim, std::move(sim_graph));
+        return make_migration_sim(m_t0, m_dt_graph_sim, sim_graph.build());
     }
 
 private:
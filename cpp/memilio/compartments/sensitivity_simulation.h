@@ -0,0 +1,305 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_COMPARTMENTS_SENSITIVITY_SIMULATION_H
+#define MIO_COMPARTMENTS_SENSITIVITY_SIMULATION_H
+
+#include "memilio/compartments/compartmentalmodel.h"
+#include "memilio/data/analyze_result.h"
+#include "memilio/math/integrator.h"
+#include "memilio/math/stepper_wrapper.h"
+#include "memilio/utils/time_series.h"
+
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * @brief simulation of a compartment model together with the sensitivities of the compartments
+ * with respect to some of its parameters.
+ *
+ * The sensitivity s_k = dy/dp_k of the compartments y with respect to the parameter p_k is the solution of
+ * the forward sensitivity equation ds_k/dt = df/dy * s_k + df/dp_k, which is integrated in the same run as
+ * the compartments. The right hand side of the sensitivity equation is the directional derivative of the right hand
+ * side f of the model in the direction (s_k, e_k), which is evaluated with a single additional evaluation of f.
+ * So the gradient of a result with respect to all parameters is obtained from one simulation instead of one
+ * or two simulations for each parameter as with finite differences of whole simulations.
+ * The sensitivities of the initial values are computed from the populations of the model, so populations
+ * can be used as parameters as well.
+ * The right hand side of the model must be differentiable in the parameters, parameters that are only used
+ * to compute other values once, e.g. when the model is created, do not have any effect.
+ * @tparam M a compartment model type.
+ */
+template <class M>
+class SensitivitySimulation
+{
+    static_assert(is_compartment_model<M>::value, "Template parameter must be a compartment model.");
+
+public:
+    using Model = M;
+    /**
+     * function that returns a reference to one scalar parameter of the model, e.g.
+     * `[](auto& m) -> ScalarType& { return m.parameters.template get<Param>()[AgeGroup(0)]; }`.
+     * UncertainValue is implicitly converted.
+     */
+    using ParameterAccessor = std::function<ScalarType&(Model&)>;
+
+    /**
+     * @brief setup the simulation.
+     * @param model an instance of a compartment model.
+     * @param parameters the parameters whose sensitivities are computed.
+     * @param t0 start time.
+     * @param dt initial step size of integration.
+     */
+    SensitivitySimulation(Model const& model, std::vector<ParameterAccessor> parameters, double t0 = 0.,
+                          double dt = 0.1)
+        : m_model(std::make_unique<Model>(model))
+        , m_parameters(std::move(parameters))
+        , m_num_compartments(m_model->get_initial_values().size())
+        , m_y_perturbed(m_num_compartments)
+        , m_f_perturbed(m_num_compartments)
+        , m_integrator_core(
+              std::make_shared<ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>>())
+        , m_integrator(
+              [this](auto&& z, auto&& t, auto&& dzdt) {
+                  eval_right_hand_side(z, t, dzdt);
+              },
+              t0, get_initial_values(), dt, m_integrator_core)
+    {
+    }
+
+    //the integrator refers to this object
+    SensitivitySimulation(const SensitivitySimulation&) = delete;
+    SensitivitySimulation& operator=(const SensitivitySimulation&) = delete;
+
+    /**
+     * @brief set the core integrator used in the simulation.
+     */
+    void set_integrator(std::shared_ptr<IntegratorCore> integrator)
+    {
+        m_integrator_core = std::move(integrator);
+        m_integrator.set_integrator(m_integrator_core);
+    }
+
+    /**
+     * @brief get the core integrator used in the simulation.
+     * @{
+     */
+    IntegratorCore& get_integrator()
+    {
+        return *m_integrator_core;
+    }
+    const IntegratorCore& get_integrator() const
+    {
+        return *m_integrator_core;
+    }
+    /**@}*/
+
+    /**
+     * @brief advance the simulation to tmax.
+     * @param tmax next stopping point of the simulation, must be greater than the current time.
+     * @return the current compartments and sensitivities.
+     */
+    Eigen::Ref<Eigen::VectorXd> advance(double tmax)
+    {
+        return m_integrator.advance(tmax);
+    }
+
+    /**
+     * @brief the compartments and the sensitivities of the compartments at each time point.
+     * Each time point contains the compartments followed by the sensitivities of the compartments with respect to
+     * each parameter, in the order of the parameters.
+     * @{
+     */
+    TimeSeries<ScalarType>& get_result()
+    {
+        return m_integrator.get_result();
+    }
+    const TimeSeries<ScalarType>& get_result() const
+    {
+        return m_integrator.get_result();
+    }
+    /**@}*/
+
+    /**
+     * @brief the compartments at each time point.
+     * Same as the result of a Simulation of the model.
+     */
+    TimeSeries<ScalarType> get_model_result() const
+    {
+        return get_block(0);
+    }
+
+    /**
+     * @brief the sensitivities of the compartments with respect to one parameter at each time point.
+     * @param param_idx index of the parameter.
+     */
+    TimeSeries<ScalarType> get_sensitivity(size_t param_idx) const
+    {
+        assert(param_idx < m_parameters.size());
+        return get_block(Eigen::Index(param_idx) + 1);
+    }
+
+    /**
+     * @brief number of parameters whose sensitivities are computed.
+     */
+    size_t get_num_parameters() const
+    {
+        return m_parameters.size();
+    }
+
+    /**
+     * @brief the model that is simulated.
+     * @{
+     */
+    Model& get_model()
+    {
+        return *m_model;
+    }
+    const Model& get_model() const
+    {
+        return *m_model;
+    }
+    /**@}*/
+
+    /**
+     * @brief evaluate the right hand side of the model and of the sensitivity equations.
+     * @param z current compartments and sensitivities.
+     * @param t current time.
+     * @param dzdt derivatives of the compartments and sensitivities.
+     */
+    void eval_right_hand_side(Eigen::Ref<const Eigen::VectorXd> z, double t, Eigen::Ref<Eigen::VectorXd> dzdt)
+    {
+        auto y = z.head(m_num_compartments);
+        auto f = dzdt.head(m_num_compartments);
+        m_model->eval_right_hand_side(y, y, t, f);
+
+        //step size of the directional difference, the parameter and the compartments are changed by
+        //about the square root of machine precision relative to their magnitude
+        const auto sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+        const auto y_scale  = std::max(y.cwiseAbs().maxCoeff(), 1.0);
+        for (size_t k = 0; k < m_parameters.size(); ++k) {
+            auto s     = z.segment((Eigen::Index(k) + 1) * m_num_compartments, m_num_compartments);
+            auto& p    = m_parameters[k](*m_model);
+            auto p0    = p;
+            auto h     = sqrt_eps * get_scale(p0);
+            auto s_max = s.cwiseAbs().maxCoeff();
+            if (s_max * h > sqrt_eps * y_scale) {
+                h = sqrt_eps * y_scale / s_max;
+            }
+            //exactly representable change of the parameter
+            h = (p0 + h) - p0;
+
+            m_y_perturbed = y + h * s;
+            p             = p0 + h;
+            m_model->eval_right_hand_side(m_y_perturbed, m_y_perturbed, t, m_f_perturbed);
+            p = p0;
+            dzdt.segment((Eigen::Index(k) + 1) * m_num_compartments, m_num_compartments) = (m_f_perturbed - f) / h;
+        }
+    }
+
+private:
+    static double get_scale(double p)
+    {
+        return p != 0.0 ? std::abs(p) : 1.0;
+    }
+
+    Eigen::VectorXd get_initial_values()
+    {
+        auto num_params    = Eigen::Index(m_parameters.size());
+        Eigen::VectorXd z0 = Eigen::VectorXd::Zero((num_params + 1) * m_num_compartments);
+        auto y0            = m_model->get_initial_values().eval();
+
+        z0.head(m_num_compartments) = y0;
+
+        //initial values are linear in the populations, so the difference is exact for any step size
+        for (Eigen::Index k = 0; k < num_params; ++k) {
+            auto& p = m_parameters[size_t(k)](*m_model);
+            auto p0 = p;
+            auto h  = get_scale(p0);
+            p       = p0 + h;
+            z0.segment((k + 1) * m_num_compartments, m_num_compartments) =
+                (m_model->get_initial_values() - y0) / ((p0 + h) - p0);
+            p = p0;
+        }
+        return z0;
+    }
+
+    TimeSeries<ScalarType> get_block(Eigen::Index block_idx) const
+    {
+        auto& result = get_result();
+        TimeSeries<ScalarType> block(m_num_compartments);
+        block.reserve(result.get_num_time_points());
+        for (Eigen::Index i = 0; i < result.get_num_time_points(); ++i) {
+            block.add_time_point(result.get_time(i), result[i].segment(block_idx * m_num_compartments,
+                                                                       m_num_compartments));
+        }
+        return block;
+    }
+
+    std::unique_ptr<Model> m_model;
+    std::vector<ParameterAccessor> m_parameters;
+    Eigen::Index m_num_compartments;
+    Eigen::VectorXd m_y_perturbed;
+    Eigen::VectorXd m_f_perturbed;
+    std::shared_ptr<IntegratorCore> m_integrator_core;
+    OdeIntegrator m_integrator;
+};
+
+/**
+ * @brief gradient of the distance between the result of a simulation and a reference,
+ * e.g. reported data, with respect to the parameters of the simulation.
+ * The distance is computed like result_distance_2norm after interpolating the result
+ * at the time points of the reference.
+ * @param sim simulation that was advanced at least to the last time point of the reference.
+ * @param reference values of the compartments at time points inside the simulated time span.
+ * @return gradient of the distance, one value for each parameter of the simulation.
+ */
+template <class M>
+Eigen::VectorXd result_distance_2norm_gradient(const SensitivitySimulation<M>& sim,
+                                               const TimeSeries<ScalarType>& reference)
+{
+    auto times  = std::vector<double>(reference.get_times().begin(), reference.get_times().end());
+    auto result = interpolate_simulation_result(sim.get_model_result(), times);
+    assert(result.get_num_time_points() == reference.get_num_time_points());
+
+    auto distance            = result_distance_2norm({result}, {reference});
+    Eigen::VectorXd gradient = Eigen::VectorXd::Zero(Eigen::Index(sim.get_num_parameters()));
+    if (distance == 0.0) {
+        return gradient;
+    }
+    for (size_t k = 0; k < sim.get_num_parameters(); ++k) {
+        //interpolation is linear, so the interpolated sensitivity is the sensitivity of the interpolated result
+        auto sensitivity = interpolate_simulation_result(sim.get_sensitivity(k), times);
+        for (Eigen::Index i = 0; i < reference.get_num_time_points(); ++i) {
+            gradient[Eigen::Index(k)] += (result[i] - reference[i]).dot(sensitivity[i]);
+        }
+    }
+    return gradient / distance;
+}
+
+} // namespace mio
+
+#endif // MIO_COMPARTMENTS_SENSITIVITY_SIMULATION_H
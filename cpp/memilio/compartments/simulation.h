@@ -23,6 +23,7 @@
 #include "memilio/config.h"
 #include "memilio/compartments/compartmentalmodel.h"
 #include "memilio/utils/metaprogramming.h"
+#include "memilio/utils/profiling.h"
 #include "memilio/math/stepper_wrapper.h"
 #include "memilio/utils/time_series.h"
 #include "memilio/math/euler.h"
@@ -54,6 +55,7 @@ public:
         , m_model(std::make_unique<Model>(model))
         , m_integrator(
               [&model = *m_model](auto&& y, auto&& t, auto&& dydt) {
+                  MEMILIO_PROFILE_SCOPE("right_hand_side");
                   model.eval_right_hand_side(y, y, t, dydt);
               },
               t0, m_model->get_initial_values(), dt, m_integratorCore)
@@ -131,6 +133,14 @@ public:
         return *m_model;
     }
 
+    /**
+     * @brief statistics of the integration, e.g., number of steps and evaluations of the right hand side.
+     */
+    const IntegratorStatistics& get_integrator_statistics() const
+    {
+        return m_integrator.get_statistics();
+    }
+
 private:
     std::shared_ptr<IntegratorCore> m_integratorCore;
     std::unique_ptr<Model> m_model;
@@ -25,10 +25,13 @@
 
 namespace mio
 {
-TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simulation_result, const double abs_tol)
+namespace
+{
+template <class FP>
+TimeSeries<FP> interpolate_simulation_result_impl(const TimeSeries<FP>& simulation_result, const double abs_tol)
 {
-    const auto t0    = simulation_result.get_time(0);
-    const auto t_max = simulation_result.get_last_time();
+    const auto t0    = double(simulation_result.get_time(0));
+    const auto t_max = double(simulation_result.get_last_time());
     // add another day if the first time point is equal to day_0 up to absolute tolerance tol
     const auto day0 = (t0 - abs_tol < std::ceil(t0) - 1) ? std::floor(t0) : std::ceil(t0);
     // add another day if the last time point is equal to day_max up to absolute tolerance tol
@@ -41,8 +44,9 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
     return interpolate_simulation_result(simulation_result, tps);
 }
 
-TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simulation_result,
-                                                 const std::vector<double>& interpolation_times)
+template <class FP>
+TimeSeries<FP> interpolate_simulation_result_impl(const TimeSeries<FP>& simulation_result,
+                                                  const std::vector<double>& interpolation_times)
 {
     assert(simulation_result.get_num_time_points() > 0 && "TimeSeries must not be empty.");
 
@@ -56,7 +60,7 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
                "for lower boundary).");
     }
 
-    TimeSeries<double> interpolated(simulation_result.get_num_elements());
+    TimeSeries<FP> interpolated(simulation_result.get_num_elements());
 
     if (interpolation_times.size() == 0) {
         return interpolated;
@@ -66,8 +70,8 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
     // add first time point of interpolation times in case it is smaller than the first time point of simulation_result
     // this is used for the case that it equals the first time point of simulation up to tolerance
     // this is necessary even if the tolerance is 0 due to the way the comparison in the loop is implemented (< and >=)
-    if (simulation_result.get_time(0) >= interpolation_times[0]) {
-        interpolated.add_time_point(interpolation_times[0], simulation_result[0]);
+    if (simulation_result.get_time(0) >= FP(interpolation_times[0])) {
+        interpolated.add_time_point(FP(interpolation_times[0]), simulation_result[0]);
         ++interp_idx;
     }
 
@@ -77,13 +81,12 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
         //only go to next pair of time points if no time point is added.
         //otherwise check the same time points again
         //in case there is more than one interpolation point between the two time points
-        if (simulation_result.get_time(sim_idx) < interpolation_times[interp_idx] &&
-            simulation_result.get_time(sim_idx + 1) >= interpolation_times[interp_idx]) {
-            interpolated.add_time_point(
-                interpolation_times[interp_idx],
-                linear_interpolation(interpolation_times[interp_idx], simulation_result.get_time(sim_idx),
-                                     simulation_result.get_time(sim_idx + 1), simulation_result[sim_idx],
-                                     simulation_result[sim_idx + 1]));
+        const auto t = FP(interpolation_times[interp_idx]);
+        if (simulation_result.get_time(sim_idx) < t && simulation_result.get_time(sim_idx + 1) >= t) {
+            interpolated.add_time_point(t, linear_interpolation(t, simulation_result.get_time(sim_idx),
+                                                                simulation_result.get_time(sim_idx + 1),
+                                                                simulation_result[sim_idx],
+                                                                simulation_result[sim_idx + 1]));
             ++interp_idx;
         }
         else {
@@ -94,42 +97,65 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
     // add last time point of interpolation times in case it is larger than the last time point of simulation_result
     // this is used for the case that it equals the last time point of simulation up to tolerance
     if (interp_idx < interpolation_times.size() &&
-        simulation_result.get_last_time() < interpolation_times[interp_idx]) {
-        interpolated.add_time_point(interpolation_times[interp_idx], simulation_result.get_last_value());
+        simulation_result.get_last_time() < FP(interpolation_times[interp_idx])) {
+        interpolated.add_time_point(FP(interpolation_times[interp_idx]), simulation_result.get_last_value());
     }
 
     return interpolated;
 }
 
-std::vector<std::vector<TimeSeries<double>>>
-sum_nodes(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result)
+/**
+ * convert results that were accumulated in double precision to the floating point type they are stored in.
+ */
+template <class FP>
+std::vector<TimeSeries<FP>> convert_accumulated(std::vector<TimeSeries<double>>&& accumulated)
+{
+    std::vector<TimeSeries<FP>> converted;
+    converted.reserve(accumulated.size());
+    for (auto& ts : accumulated) {
+        converted.push_back(ts.template cast<FP>());
+    }
+    return converted;
+}
+template <>
+std::vector<TimeSeries<double>> convert_accumulated<double>(std::vector<TimeSeries<double>>&& accumulated)
+{
+    return std::move(accumulated);
+}
+
+template <class FP>
+std::vector<std::vector<TimeSeries<FP>>> sum_nodes_impl(const std::vector<std::vector<TimeSeries<FP>>>& ensemble_result)
 {
     auto num_runs        = ensemble_result.size();
     auto num_nodes       = ensemble_result[0].size();
     auto num_time_points = ensemble_result[0][0].get_num_time_points();
     auto num_elements    = ensemble_result[0][0].get_num_elements();
 
-    std::vector<std::vector<TimeSeries<double>>> sum_result(
-        num_runs, std::vector<TimeSeries<double>>(1, TimeSeries<double>::zero(num_time_points, num_elements)));
-
+    std::vector<std::vector<TimeSeries<FP>>> sum_result;
+    sum_result.reserve(num_runs);
     for (size_t run = 0; run < num_runs; run++) {
+        //sums are accumulated in double precision, even if results are stored in lower precision
+        std::vector<TimeSeries<double>> run_sum(1, TimeSeries<double>::zero(num_time_points, num_elements));
         for (Eigen::Index time = 0; time < num_time_points; time++) {
-            sum_result[run][0].get_time(time) = ensemble_result[run][0].get_time(time);
+            run_sum[0].get_time(time) = ensemble_result[run][0].get_time(time);
             for (size_t node = 0; node < num_nodes; node++) {
-                sum_result[run][0][time] += ensemble_result[run][node][time];
+                run_sum[0][time] += ensemble_result[run][node][time].template cast<double>();
             }
         }
+        sum_result.push_back(convert_accumulated<FP>(std::move(run_sum)));
     }
     return sum_result;
 }
 
-std::vector<TimeSeries<double>> ensemble_mean(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result)
+template <class FP>
+std::vector<TimeSeries<FP>> ensemble_mean_impl(const std::vector<std::vector<TimeSeries<FP>>>& ensemble_result)
 {
     auto num_runs        = ensemble_result.size();
     auto num_nodes       = ensemble_result[0].size();
     auto num_time_points = ensemble_result[0][0].get_num_time_points();
     auto num_elements    = ensemble_result[0][0].get_num_elements();
 
+    //mean is accumulated in double precision, even if results are stored in lower precision
     std::vector<TimeSeries<double>> mean(num_nodes, TimeSeries<double>::zero(num_time_points, num_elements));
 
     for (size_t run = 0; run < num_runs; run++) {
@@ -141,16 +167,17 @@ std::vector<TimeSeries<double>> ensemble_mean(const std::vector<std::vector<Time
                 assert(ensemble_result[run][node].get_num_elements() == num_elements &&
                        "ensemble results not uniform.");
                 mean[node].get_time(time) = ensemble_result[run][node].get_time(time);
-                mean[node][time] += ensemble_result[run][node][time] / num_runs;
+                mean[node][time] += ensemble_result[run][node][time].template cast<double>() / num_runs;
             }
         }
     }
 
-    return mean;
+    return convert_accumulated<FP>(std::move(mean));
 }
 
-std::vector<TimeSeries<double>> ensemble_percentile(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result,
-                                                    double p)
+template <class FP>
+std::vector<TimeSeries<FP>> ensemble_percentile_impl(const std::vector<std::vector<TimeSeries<FP>>>& ensemble_result,
+                                                     double p)
 {
     assert(p > 0.0 && p < 1.0 && "Invalid percentile value.");
 
@@ -159,9 +186,9 @@ std::vector<TimeSeries<double>> ensemble_percentile(const std::vector<std::vecto
     auto num_time_points = ensemble_result[0][0].get_num_time_points();
     auto num_elements    = ensemble_result[0][0].get_num_elements();
 
-    std::vector<TimeSeries<double>> percentile(num_nodes, TimeSeries<double>::zero(num_time_points, num_elements));
+    std::vector<TimeSeries<FP>> percentile(num_nodes, TimeSeries<FP>::zero(num_time_points, num_elements));
 
-    std::vector<double> single_element_ensemble(num_runs); //reused for each element
+    std::vector<FP> single_element_ensemble(num_runs); //reused for each element
     for (size_t node = 0; node < num_nodes; node++) {
         for (Eigen::Index time = 0; time < num_time_points; time++) {
             percentile[node].get_time(time) = ensemble_result[0][node].get_time(time);
@@ -177,6 +204,63 @@ std::vector<TimeSeries<double>> ensemble_percentile(const std::vector<std::vecto
     }
     return percentile;
 }
+} // namespace
+
+TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simulation_result, const double abs_tol)
+{
+    return interpolate_simulation_result_impl(simulation_result, abs_tol);
+}
+
+TimeSeries<float> interpolate_simulation_result(const TimeSeries<float>& simulation_result, const double abs_tol)
+{
+    return interpolate_simulation_result_impl(simulation_result, abs_tol);
+}
+
+TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simulation_result,
+                                                 const std::vector<double>& interpolation_times)
+{
+    return interpolate_simulation_result_impl(simulation_result, interpolation_times);
+}
+
+TimeSeries<float> interpolate_simulation_result(const TimeSeries<float>& simulation_result,
+                                                const std::vector<double>& interpolation_times)
+{
+    return interpolate_simulation_result_impl(simulation_result, interpolation_times);
+}
+
+std::vector<std::vector<TimeSeries<double>>>
+sum_nodes(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result)
+{
+    return sum_nodes_impl(ensemble_result);
+}
+
+std::vector<std::vector<TimeSeries<float>>>
+sum_nodes(const std::vector<std::vector<TimeSeries<float>>>& ensemble_result)
+{
+    return sum_nodes_impl(ensemble_result);
+}
+
+std::vector<TimeSeries<double>> ensemble_mean(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result)
+{
+    return ensemble_mean_impl(ensemble_result);
+}
+
+std::vector<TimeSeries<float>> ensemble_mean(const std::vector<std::vector<TimeSeries<float>>>& ensemble_result)
+{
+    return ensemble_mean_impl(ensemble_result);
+}
+
+std::vector<TimeSeries<double>> ensemble_percentile(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result,
+                                                    double p)
+{
+    return ensemble_percentile_impl(ensemble_result, p);
+}
+
+std::vector<TimeSeries<float>> ensemble_percentile(const std::vector<std::vector<TimeSeries<float>>>& ensemble_result,
+                                                   double p)
+{
+    return ensemble_percentile_impl(ensemble_result, p);
+}
 
 double result_distance_2norm(const std::vector<mio::TimeSeries<double>>& result1,
                              const std::vector<mio::TimeSeries<double>>& result2)
@@ -38,9 +38,13 @@ namespace mio
  * @param simulation_result time series to interpolate
  * @param abs_tol  absolute tolerance given for doubles t0 and tmax to account for small deviations from whole days.
  * @return interpolated time series
+ * @{
  */
 TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simulation_result,
                                                  const double abs_tol = 1e-14);
+TimeSeries<float> interpolate_simulation_result(const TimeSeries<float>& simulation_result,
+                                                const double abs_tol = 1e-14);
+/** @} */
 
 /**
  * @brief interpolate time series with freely chosen time points that lie in between the time points of the given time series up to a given tolerance.
@@ -48,9 +52,13 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
  * @param simulation_result time series to interpolate
  * @param interpolations_times std::vector of time points at which simulation results are interpolated.
  * @return interpolated time series at given interpolation points
+ * @{
  */
 TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simulation_result,
                                                  const std::vector<double>& interpolation_times);
+TimeSeries<float> interpolate_simulation_result(const TimeSeries<float>& simulation_result,
+                                                const std::vector<double>& interpolation_times);
+/** @} */
 
 /**
  * helper template, type returned by overload interpolate_simulation_result(T t)
@@ -75,18 +83,32 @@ std::vector<InterpolateResultT<T>> interpolate_ensemble_results(const std::vecto
     return interpolated;
 }
 
+/**
+ * @brief sums up the results of all nodes for each run, compartment and time point.
+ * Results stored as float are summed up in double precision.
+ * @param ensemble_result uniform results of multiple simulation runs
+ * @return one summed up result per run
+ * @{
+ */
 std::vector<std::vector<TimeSeries<double>>>
 sum_nodes(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result);
+std::vector<std::vector<TimeSeries<float>>>
+sum_nodes(const std::vector<std::vector<TimeSeries<float>>>& ensemble_result);
+/** @} */
 
 /**
  * @brief computes mean of each compartment, node, and time point over all runs
  * input must be uniform as returned by interpolated_ensemble_result:
  * same number of nodes, same time points and elements.
+ * Results stored as float are accumulated in double precision.
  * @see interpolated_ensemble_result
  * @param ensemble_results uniform results of multiple simulation runs
  * @return mean of the results over all runs
+ * @{
  */
 std::vector<TimeSeries<double>> ensemble_mean(const std::vector<std::vector<TimeSeries<double>>>& ensemble_results);
+std::vector<TimeSeries<float>> ensemble_mean(const std::vector<std::vector<TimeSeries<float>>>& ensemble_results);
+/** @} */
 
 /**
  * @brief computes the p percentile of the result for each compartment, node, and time point.
@@ -98,9 +120,13 @@ std::vector<TimeSeries<double>> ensemble_mean(const std::vector<std::vector<Time
  * @param ensemble_result uniform results of multiple simulation runs
  * @param p percentile value in open interval (0, 1)
  * @return p percentile of the results over all runs
+ * @{
  */
 std::vector<TimeSeries<double>> ensemble_percentile(const std::vector<std::vector<TimeSeries<double>>>& ensemble_result,
                                                     double p);
+std::vector<TimeSeries<float>> ensemble_percentile(const std::vector<std::vector<TimeSeries<float>>>& ensemble_result,
+                                                   double p);
+/** @} */
 /**
  * interpolate time series with evenly spaced, integer time points for each node.
  * @see interpolate_simulation_result
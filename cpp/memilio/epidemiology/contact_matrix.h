@@ -27,10 +27,29 @@
 #include <vector>
 #include <numeric>
 #include <ostream>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
 
 namespace mio
 {
 
+namespace details
+{
+/**
+ * new version number that is unique in the whole program.
+ * @see DampingMatrixExpression::get_version
+ */
+inline uint64_t next_damping_matrix_version()
+{
+    static std::atomic<uint64_t> version{0};
+    return ++version;
+}
+} // namespace details
+
 /**
  * represents the coefficient wise matrix (or vector) expression B - D * M
  * where B is a baseline, M is a minimum and D is some time dependent complex damping factor.
@@ -95,6 +114,7 @@ public:
     template <class... T>
     void add_damping(T&&... t)
     {
+        m_version = details::next_damping_matrix_version();
         m_dampings.add(std::forward<T>(t)...);
     }
 
@@ -104,6 +124,7 @@ public:
      */
     void remove_damping(size_t i)
     {
+        m_version = details::next_damping_matrix_version();
         m_dampings.remove(i);
     }
 
@@ -112,11 +133,13 @@ public:
      */
     void clear_dampings()
     {
+        m_version = details::next_damping_matrix_version();
         m_dampings.clear();
     }
 
     /**
      * list of dampings.
+     * Non-const access changes the version, see get_version().
      */
     auto get_dampings() const
     {
@@ -124,11 +147,13 @@ public:
     }
     auto get_dampings()
     {
+        m_version = details::next_damping_matrix_version();
         return make_range(m_dampings.begin(), m_dampings.end());
     }
 
     /**
      * get the baseline matrix.
+     * Non-const access changes the version, see get_version().
      */
     const Matrix& get_baseline() const
     {
@@ -136,11 +161,13 @@ public:
     }
     Matrix& get_baseline()
     {
+        m_version = details::next_damping_matrix_version();
         return m_baseline;
     }
 
     /**
      * get the minimum matrix.
+     * Non-const access changes the version, see get_version().
      */
     const Matrix& get_minimum() const
     {
@@ -148,9 +175,22 @@ public:
     }
     Matrix& get_minimum()
     {
+        m_version = details::next_damping_matrix_version();
         return m_minimum;
     }
 
+    /**
+     * version of the matrices and dampings.
+     * Every function that may change them, including non-const access, sets a new version that is unique in
+     * the program, so a different version means that the expression may have changed. Copies keep the version.
+     * Changes through references or ranges that were obtained before the current version are not detected.
+     * @see DampingMatrixExpressionGroup::get_scheduled_matrix_at
+     */
+    uint64_t get_version() const
+    {
+        return m_version;
+    }
+
     /**
      * dimensions of the matrix.
      */
@@ -179,6 +219,15 @@ public:
         m_dampings.finalize();
     }
 
+    /**
+     * accumulated dampings at each time point where they change.
+     * @see Dampings::get_accumulated_dampings
+     */
+    const auto& get_accumulated_dampings() const
+    {
+        return m_dampings.get_accumulated_dampings();
+    }
+
     /**
      * Applies dampings to compute the real contact frequency at a point in time.
      * Uses lazy evaluation, coefficients are calculated on indexed access.
@@ -261,8 +310,187 @@ private:
     Matrix m_baseline;
     Matrix m_minimum;
     DampingsType m_dampings;
+    uint64_t m_version = details::next_damping_matrix_version();
 };
 
+/**
+ * precomputed sum of a collection of DampingMatrixExpressions over time.
+ * The sum only changes in the smooth transitions of one day before each accumulated damping
+ * and is linear in the dampings, so it is precomputed at each time point where a transition starts or ends.
+ * get_matrix_at() only adds the transitions that are in progress at the requested time and returns a reference
+ * to a precomputed or preallocated matrix. Lookups of increasing time points, e.g. in the steps of an integrator,
+ * take constant time.
+ * The schedule is a snapshot of the dampings, it needs to be created again if dampings are added or removed.
+ * Not threadsafe, every thread requires its own schedule.
+ * @see DampingMatrixExpressionGroup::get_schedule
+ * @see DampingMatrixExpressionGroup::get_scheduled_matrix_at
+ * @tparam M matrix type.
+ */
+template <class M>
+class DampingMatrixSchedule
+{
+public:
+    using Matrix = M;
+
+    /**
+     * precompute the sum of the matrices in a collection.
+     * @param group DampingMatrixExpressionGroup or compatible type.
+     * @tparam G type of the collection.
+     */
+    template <class G>
+    explicit DampingMatrixSchedule(const G& group);
+
+    /**
+     * get the sum of the matrices at a point in time.
+     * Same as DampingMatrixExpressionGroup::get_matrix_at up to rounding errors.
+     * @param t time in the simulation.
+     * @return reference to the sum of the matrices, valid until the next call.
+     */
+    const Matrix& get_matrix_at(SimulationTime t);
+    const Matrix& get_matrix_at(double t)
+    {
+        return get_matrix_at(SimulationTime(t));
+    }
+
+    /**
+     * check if the schedule was precomputed from the current versions of the matrices in a collection.
+     * @param group DampingMatrixExpressionGroup or compatible type.
+     * @see DampingMatrixExpression::get_version
+     */
+    template <class G>
+    bool is_up_to_date(const G& group) const
+    {
+        return m_versions.size() == group.get_num_matrices() &&
+               std::equal(m_versions.begin(), m_versions.end(), group.begin(), [](uint64_t version, auto& expr) {
+                   return version == expr.get_version();
+               });
+    }
+
+    /**
+     * number of intervals where different transitions are in progress.
+     */
+    size_t get_num_segments() const
+    {
+        return m_segment_times.size();
+    }
+
+private:
+    /**
+     * smooth change of the sum in the day before a damping.
+     * the change starts earlier if the previous damping is less than a day before.
+     */
+    struct Transition {
+        double start;
+        double end;
+        Matrix change;
+    };
+
+    bool is_in_segment(size_t idx, double t) const
+    {
+        return idx < m_segment_times.size() && m_segment_times[idx] <= t &&
+               (idx + 1 == m_segment_times.size() || t < m_segment_times[idx + 1]);
+    }
+
+    std::vector<Transition> m_transitions;
+    std::vector<double> m_segment_times; ///< start of each segment, the segment ends at the start of the next.
+    std::vector<Matrix> m_segment_sums; ///< sum with all transitions completed before the segment.
+    std::vector<std::vector<size_t>> m_segment_transitions; ///< indices of the transitions in progress.
+    size_t m_current_segment = 0;
+    Matrix m_matrix;
+    std::vector<uint64_t> m_versions; ///< versions of the matrices that the schedule was computed from.
+};
+
+template <class M>
+template <class G>
+DampingMatrixSchedule<M>::DampingMatrixSchedule(const G& group)
+{
+    using std::get;
+
+    Matrix initial = Matrix::Zero(group.get_shape().rows(), group.get_shape().cols());
+    for (auto& expr : group) {
+        m_versions.push_back(expr.get_version());
+        initial += expr.get_baseline();
+        auto& accumulated = expr.get_accumulated_dampings();
+        auto range        = (expr.get_baseline() - expr.get_minimum()).eval();
+        //first element is zero before all dampings, last element is a copy at the end of time
+        for (size_t k = 1; k + 1 < accumulated.size(); ++k) {
+            auto end   = double(get<SimulationTime>(accumulated[k]));
+            auto start = std::max(end - 1, double(get<SimulationTime>(accumulated[k - 1])));
+            Matrix change =
+                ((get<Matrix>(accumulated[k - 1]) - get<Matrix>(accumulated[k])).array() * range.array()).matrix();
+            m_transitions.push_back({start, end, std::move(change)});
+        }
+    }
+
+    //matrices in a group usually have dampings at the same times, their transitions are combined
+    std::sort(m_transitions.begin(), m_transitions.end(), [](auto& tr1, auto& tr2) {
+        return std::make_tuple(tr1.end, tr1.start) < std::make_tuple(tr2.end, tr2.start);
+    });
+    if (!m_transitions.empty()) {
+        auto last = m_transitions.begin();
+        for (auto iter = m_transitions.begin() + 1; iter != m_transitions.end(); ++iter) {
+            if (iter->start == last->start && iter->end == last->end) {
+                last->change += iter->change;
+            }
+            else if (++last != iter) {
+                *last = std::move(*iter);
+            }
+        }
+        m_transitions.erase(last + 1, m_transitions.end());
+    }
+
+    m_segment_times.push_back(std::numeric_limits<double>::lowest());
+    for (auto& tr : m_transitions) {
+        m_segment_times.push_back(tr.start);
+        m_segment_times.push_back(tr.end);
+    }
+    std::sort(m_segment_times.begin(), m_segment_times.end());
+    m_segment_times.erase(std::unique(m_segment_times.begin(), m_segment_times.end()), m_segment_times.end());
+
+    //transitions are sorted by end, so the completed transitions are added in order
+    auto sum           = initial;
+    size_t next_to_end = 0;
+    for (auto t : m_segment_times) {
+        for (; next_to_end < m_transitions.size() && m_transitions[next_to_end].end <= t; ++next_to_end) {
+            sum += m_transitions[next_to_end].change;
+        }
+        m_segment_sums.push_back(sum);
+        m_segment_transitions.emplace_back();
+        for (size_t i = next_to_end; i < m_transitions.size(); ++i) {
+            if (m_transitions[i].start <= t) {
+                m_segment_transitions.back().push_back(i);
+            }
+        }
+    }
+    m_matrix = initial;
+}
+
+template <class M>
+auto DampingMatrixSchedule<M>::get_matrix_at(SimulationTime t) -> const Matrix&
+{
+    auto t_ = double(t);
+    if (!is_in_segment(m_current_segment, t_)) {
+        if (is_in_segment(m_current_segment + 1, t_)) {
+            ++m_current_segment;
+        }
+        else {
+            auto ub           = std::upper_bound(m_segment_times.begin(), m_segment_times.end(), t_);
+            m_current_segment = size_t(std::max(ub - m_segment_times.begin(), std::ptrdiff_t(1)) - 1);
+        }
+    }
+
+    auto& transitions = m_segment_transitions[m_current_segment];
+    if (transitions.empty()) {
+        return m_segment_sums[m_current_segment];
+    }
+    m_matrix = m_segment_sums[m_current_segment];
+    for (auto i : transitions) {
+        auto& tr = m_transitions[i];
+        m_matrix += smoother_cosine(t_, tr.end - 1, tr.end, 0.0, 1.0) * tr.change;
+    }
+    return m_matrix;
+}
+
 /**
  * represents a collection of DampingMatrixExpressions that are summed up.
  * @tparam E some instance of DampingMatrixExpression or compatible type.
@@ -309,6 +537,23 @@ public:
         assert(v.size() > 0);
     }
 
+    /**
+     * copy the matrices, the schedule of get_scheduled_matrix_at is not copied so copies can be used by other
+     * threads.
+     */
+    DampingMatrixExpressionGroup(const DampingMatrixExpressionGroup& other)
+        : m_matrices(other.m_matrices)
+    {
+    }
+    DampingMatrixExpressionGroup& operator=(const DampingMatrixExpressionGroup& other)
+    {
+        m_matrices = other.m_matrices;
+        m_schedule.reset();
+        return *this;
+    }
+    DampingMatrixExpressionGroup(DampingMatrixExpressionGroup&& other) = default;
+    DampingMatrixExpressionGroup& operator=(DampingMatrixExpressionGroup&& other) = default;
+
     /**
      * access one matrix.
      */
@@ -398,6 +643,38 @@ public:
             });
     }
 
+    /**
+     * precompute the sum of all contained matrices for fast evaluation at many points in time.
+     * @return a schedule that contains a snapshot of the current dampings.
+     * @see DampingMatrixSchedule
+     */
+    DampingMatrixSchedule<Matrix> get_schedule() const
+    {
+        return DampingMatrixSchedule<Matrix>(*this);
+    }
+
+    /**
+     * get the real contact frequency at a point in time using a precomputed schedule.
+     * Same as get_matrix_at up to rounding errors, but much faster for many points in time, e.g. in every
+     * evaluation of the right hand side of a model. The schedule is kept and only computed again if the version
+     * of a matrix changed, e.g. because dampings were added, see DampingMatrixExpression::get_version.
+     * Unlike get_matrix_at, this is not thread safe, every thread requires its own copy of the collection.
+     * @param t point in time.
+     * @return reference to the sum of all matrices, valid until the next call or until the matrices are changed.
+     * @see DampingMatrixSchedule
+     */
+    const Matrix& get_scheduled_matrix_at(SimulationTime t) const
+    {
+        if (!m_schedule || !m_schedule->is_up_to_date(*this)) {
+            m_schedule = std::make_unique<DampingMatrixSchedule<Matrix>>(*this);
+        }
+        return m_schedule->get_matrix_at(t);
+    }
+    const Matrix& get_scheduled_matrix_at(double t) const
+    {
+        return get_scheduled_matrix_at(SimulationTime(t));
+    }
+
     /**
      * STL iterators over matrices.
      */
@@ -484,6 +761,7 @@ public:
 
 private:
     std::vector<value_type> m_matrices;
+    mutable std::unique_ptr<DampingMatrixSchedule<Matrix>> m_schedule; ///< see get_scheduled_matrix_at.
 };
 
 /**
@@ -31,6 +31,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <limits>
 
 namespace mio
 {
@@ -306,6 +307,7 @@ public:
     void remove(size_t i)
     {
         assert(m_dampings.size() > i);
+        invalidate_cache(m_dampings[i].get_time());
         m_dampings.erase(m_dampings.begin() + i);
     }
 
@@ -315,6 +317,7 @@ public:
     void clear()
     {
         m_dampings.clear();
+        m_accumulated_dampings_cached.clear();
     }
 
     /**
@@ -353,9 +356,24 @@ public:
      * compute the cache of accumulated dampings.
      * if this is used after adding dampings, all subsequent calls to get_matrix_at()
      * are quick and threadsafe. Otherwise the cache is updated automatically on the first call.
+     * Only the part of the cache starting at the time of the earliest damping that was added or removed
+     * since the last update is recomputed, so adding dampings at the end of the timeline, e.g. during
+     * the simulation, is cheap even if there are many dampings before.
      */
     void finalize() const;
 
+    /**
+     * accumulated dampings at each time point where they change, sorted by time.
+     * The first element is zero at the lowest possible time, the last element is a copy of the element
+     * before at the highest possible time.
+     * Updates the cache of accumulated dampings if necessary, see finalize().
+     */
+    const std::vector<std::tuple<Matrix, SimulationTime>>& get_accumulated_dampings() const
+    {
+        finalize();
+        return m_accumulated_dampings_cached;
+    }
+
     /**
      * access one damping in this collection.
      */
@@ -472,6 +490,14 @@ private:
      */
     void add_(const value_type& damping);
 
+    /**
+     * mark the cache of accumulated dampings as outdated from time t onwards.
+     */
+    void invalidate_cache(SimulationTime t)
+    {
+        m_first_modified_time = std::min(m_first_modified_time, double(t));
+    }
+
     /**
      * replace matrices of the same type, sum up matrices on the same level.
      * add new types/levels if necessary.
@@ -507,6 +533,7 @@ private:
     std::vector<value_type> m_dampings;
     Shape m_shape;
     mutable std::vector<std::tuple<Matrix, SimulationTime>> m_accumulated_dampings_cached;
+    mutable double m_first_modified_time = std::numeric_limits<double>::infinity();
 };
 
 template <class D>
@@ -517,26 +544,46 @@ void Dampings<D>::finalize() const
     if (m_accumulated_dampings_cached.empty()) {
         m_accumulated_dampings_cached.emplace_back(Matrix::Zero(m_shape.rows(), m_shape.cols()),
                                                    SimulationTime(std::numeric_limits<double>::lowest()));
-
-        std::vector<std::tuple<std::reference_wrapper<const Matrix>, DampingLevel, DampingType>> active_by_type;
-        std::vector<std::tuple<Matrix, DampingLevel>> sum_by_level;
-        for (auto& damping : m_dampings) {
-            update_active_dampings(damping, active_by_type, sum_by_level);
-            auto combined_damping = inclusive_exclusive_sum(sum_by_level);
-            assert((combined_damping.array() <= 1).all() && (combined_damping.array() >= 0).all() &&
-                   "unexpected error, accumulated damping out of range.");
-            if (floating_point_equal(double(get<SimulationTime>(damping)),
-                                     double(get<SimulationTime>(m_accumulated_dampings_cached.back())), 1e-15, 1e-15)) {
-                std::get<Matrix>(m_accumulated_dampings_cached.back()) = combined_damping;
-            }
-            else {
-                m_accumulated_dampings_cached.emplace_back(combined_damping, get<SimulationTime>(damping));
-            }
+        m_first_modified_time = std::numeric_limits<double>::lowest();
+    }
+    else if (m_first_modified_time == std::numeric_limits<double>::infinity()) {
+        return;
+    }
+
+    //accumulated dampings before the first modified time point are still up to date
+    auto is_unmodified = [t_modified = m_first_modified_time](double t) {
+        return t < t_modified && !floating_point_equal(t, t_modified, 1e-15, 1e-15);
+    };
+    //the first element is the zero matrix before any damping and always stays
+    auto first_outdated = std::partition_point(m_accumulated_dampings_cached.begin() + 1,
+                                               m_accumulated_dampings_cached.end(), [&is_unmodified](auto& tup) {
+                                                   return is_unmodified(double(get<SimulationTime>(tup)));
+                                               });
+    m_accumulated_dampings_cached.erase(first_outdated, m_accumulated_dampings_cached.end());
+
+    std::vector<std::tuple<std::reference_wrapper<const Matrix>, DampingLevel, DampingType>> active_by_type;
+    std::vector<std::tuple<Matrix, DampingLevel>> sum_by_level;
+    for (auto& damping : m_dampings) {
+        update_active_dampings(damping, active_by_type, sum_by_level);
+        if (is_unmodified(double(get<SimulationTime>(damping)))) {
+            //only the active dampings are required, the accumulated damping is already in the cache
+            continue;
+        }
+        auto combined_damping = inclusive_exclusive_sum(sum_by_level);
+        assert((combined_damping.array() <= 1).all() && (combined_damping.array() >= 0).all() &&
+               "unexpected error, accumulated damping out of range.");
+        if (floating_point_equal(double(get<SimulationTime>(damping)),
+                                 double(get<SimulationTime>(m_accumulated_dampings_cached.back())), 1e-15, 1e-15)) {
+            std::get<Matrix>(m_accumulated_dampings_cached.back()) = combined_damping;
+        }
+        else {
+            m_accumulated_dampings_cached.emplace_back(combined_damping, get<SimulationTime>(damping));
         }
-
-        m_accumulated_dampings_cached.emplace_back(get<Matrix>(m_accumulated_dampings_cached.back()),
-                                                   SimulationTime(std::numeric_limits<double>::max()));
     }
+
+    m_accumulated_dampings_cached.emplace_back(get<Matrix>(m_accumulated_dampings_cached.back()),
+                                               SimulationTime(std::numeric_limits<double>::max()));
+    m_first_modified_time = std::numeric_limits<double>::infinity();
 }
 
 template <class D>
@@ -547,7 +594,7 @@ void Dampings<D>::add_(const value_type& damping)
         return std::make_tuple(tup1.get_time(), int(tup1.get_type()), int(tup1.get_level())) <
                std::make_tuple(tup2.get_time(), int(tup2.get_type()), int(tup2.get_level()));
     });
-    m_accumulated_dampings_cached.clear();
+    invalidate_cache(damping.get_time());
 }
 
 template <class S>
@@ -320,7 +320,7 @@ void implement_dynamic_npis(DampingExprGroup& damping_expr_group, const std::vec
     for (auto& damping_expr : damping_expr_group) {
         //go from the back so indices aren't invalidated when dampings are removed
         //use indices to loop instead of reverse iterators because removing invalidates the current iterator
-        for (auto i = size_t(0); i < damping_expr.get_dampings().size() - 1; ++i) {
+        for (auto i = size_t(0); i + 1 < damping_expr.get_dampings().size(); ++i) {
             auto it = damping_expr.get_dampings().rbegin() + i;
 
             //look for previous damping of the same type/level
@@ -0,0 +1,100 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/io/binary_serializer.h"
+
+#include <fstream>
+
+namespace mio
+{
+
+namespace details
+{
+namespace
+{
+//identifies files in memilio binary format
+const char BINARY_MAGIC[8] = {'M', 'I', 'O', 'B', 'I', 'N', '\0', '\0'};
+//written in native byte order, so files from platforms with different endianness are detected
+const uint32_t BINARY_BYTE_ORDER_MARK = 0x01020304;
+const size_t BINARY_HEADER_SIZE       = sizeof(BINARY_MAGIC) + 3 * sizeof(uint32_t);
+} // namespace
+
+void write_binary_header(std::vector<unsigned char>& buffer, int flags)
+{
+    append_bytes(buffer, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    append_bytes(buffer, BINARY_BYTE_ORDER_MARK);
+    append_bytes(buffer, BINARY_FORMAT_VERSION);
+    append_bytes(buffer, int32_t(flags));
+}
+
+IOResult<size_t> read_binary_header(const std::vector<unsigned char>& buffer, int flags)
+{
+    if (buffer.size() < BINARY_HEADER_SIZE ||
+        std::memcmp(buffer.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        return failure(StatusCode::InvalidFileFormat, "Data is not in memilio binary format.");
+    }
+    auto p = buffer.data() + sizeof(BINARY_MAGIC);
+    if (load_bytes<uint32_t>(p) != BINARY_BYTE_ORDER_MARK) {
+        return failure(StatusCode::InvalidFileFormat, "Binary data was written with a different byte order.");
+    }
+    p += sizeof(uint32_t);
+    auto version = load_bytes<uint32_t>(p);
+    if (version != BINARY_FORMAT_VERSION) {
+        return failure(StatusCode::InvalidFileFormat,
+                       "Binary format version " + std::to_string(version) + " is not supported, expected version " +
+                           std::to_string(BINARY_FORMAT_VERSION) + ".");
+    }
+    p += sizeof(uint32_t);
+    if (load_bytes<int32_t>(p) != int32_t(flags)) {
+        return failure(StatusCode::InvalidValue, "Binary data was written with different IO flags.");
+    }
+    return success(BINARY_HEADER_SIZE);
+}
+} // namespace details
+
+IOResult<void> write_binary(const std::string& path, const std::vector<unsigned char>& buffer)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open()) {
+        return failure(StatusCode::FileNotFound, path);
+    }
+    ofs.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+    if (!ofs) {
+        return failure(StatusCode::UnknownError, "Unknown error writing binary file " + path + ".");
+    }
+    return success();
+}
+
+IOResult<std::vector<unsigned char>> read_binary(const std::string& path)
+{
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs.is_open()) {
+        return failure(StatusCode::FileNotFound, path);
+    }
+    auto size = ifs.tellg();
+    ifs.seekg(0, std::ios::beg);
+    std::vector<unsigned char> buffer(static_cast<size_t>(size));
+    ifs.read(reinterpret_cast<char*>(buffer.data()), size);
+    if (!ifs) {
+        return failure(StatusCode::UnknownError, "Unknown error reading binary file " + path + ".");
+    }
+    return success(std::move(buffer));
+}
+
+} // namespace mio
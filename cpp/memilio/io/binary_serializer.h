@@ -0,0 +1,709 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef EPI_IO_BINARY_SERIALIZER_H
+#define EPI_IO_BINARY_SERIALIZER_H
+
+#include "memilio/io/io.h"
+#include "memilio/math/eigen.h"
+#include "memilio/utils/metaprogramming.h"
+#include "boost/optional.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * Version of the binary format.
+ * Increment whenever the layout of records, lists or basic types changes.
+ */
+const uint32_t BINARY_FORMAT_VERSION = 1;
+
+namespace details
+{
+//append the bytes of a trivially copyable value to the buffer
+template <class T>
+void append_bytes(std::vector<unsigned char>& buffer, const T& t)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written as bytes.");
+    auto p = reinterpret_cast<const unsigned char*>(&t);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+//append a block of bytes to the buffer
+inline void append_bytes(std::vector<unsigned char>& buffer, const void* data, size_t num_bytes)
+{
+    auto p = static_cast<const unsigned char*>(data);
+    buffer.insert(buffer.end(), p, p + num_bytes);
+}
+
+//read a trivially copyable value from a possibly unaligned position
+template <class T>
+T load_bytes(const unsigned char* p)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read from bytes.");
+    T t;
+    std::memcpy(&t, p, sizeof(T));
+    return t;
+}
+
+//types that are stored by their object representation
+template <class T>
+using is_binary_basic_type = std::is_arithmetic<T>;
+
+//dense Eigen matrices with arithmetic scalars are stored as contiguous blocks
+template <class M, class = void>
+struct is_binary_matrix : std::false_type {
+};
+template <class M>
+struct is_binary_matrix<M, std::enable_if_t<std::is_base_of<Eigen::DenseBase<M>, M>::value>>
+    : std::is_arithmetic<typename M::Scalar> {
+};
+
+/**
+ * write header of the binary format (magic, byte order, version, flags) to the buffer.
+ */
+void write_binary_header(std::vector<unsigned char>& buffer, int flags);
+
+/**
+ * check header of the binary format.
+ * @return position of the first byte after the header if the header is valid, error otherwise.
+ */
+IOResult<size_t> read_binary_header(const std::vector<unsigned char>& buffer, int flags);
+} // namespace details
+
+/**
+ * Base class for implementations of serialization framework concepts for binary format.
+ * Stores status and flags.
+ */
+class BinaryBase
+{
+public:
+    /**
+     * Constructor that sets status and flags.
+     */
+    BinaryBase(std::shared_ptr<IOStatus> status, int flags)
+        : m_status(status)
+        , m_flags(flags)
+    {
+        assert(status && "Status must not be null.");
+    }
+
+    /**
+     * Flags that determine the behavior of serialization.
+     * @see mio::IOFlags
+     */
+    int flags() const
+    {
+        return m_flags;
+    }
+
+    /**
+     * The current status of serialization.
+     * Contains errors that occurred.
+     */
+    const IOStatus& status() const
+    {
+        return *m_status;
+    }
+
+    /**
+     * Set the current status of serialization.
+     */
+    void set_error(const IOStatus& status)
+    {
+        if (*m_status) {
+            *m_status = status;
+        }
+    }
+
+protected:
+    std::shared_ptr<IOStatus> m_status;
+    int m_flags;
+};
+
+/**
+ * Implementation of the IOObject concept for binary format.
+ * An object is stored as a sequence of records. Each record consists of the name of the element,
+ * the size of the data in bytes and the data of the element.
+ * Elements are usually retrieved in the same order as they were added, which is the fast path.
+ * Lookup by name in any order is supported as well, e.g., for types that inspect some element first
+ * to decide how to deserialize the rest.
+ * Serialization writes directly into the buffer of the root context, so there is no copying of nested objects.
+ */
+class BinaryObject : public BinaryBase
+{
+public:
+    /**
+     * Constructor for serialization.
+     * @param status status, shared with the parent IO context and objects.
+     * @param buffer buffer that the data is appended to.
+     * @param flags flags to determine the behavior of serialization.
+     */
+    BinaryObject(const std::shared_ptr<IOStatus>& status, std::vector<unsigned char>& buffer, int flags)
+        : BinaryBase{status, flags}
+        , m_buffer{&buffer}
+        , m_begin{nullptr}
+        , m_end{nullptr}
+        , m_cursor{nullptr}
+    {
+    }
+
+    /**
+     * Constructor for deserialization.
+     * @param status status, shared with the parent IO context and objects.
+     * @param begin pointer to the first byte of the records of the object.
+     * @param end pointer behind the last byte of the records of the object.
+     * @param flags flags to determine the behavior of serialization.
+     */
+    BinaryObject(const std::shared_ptr<IOStatus>& status, const unsigned char* begin, const unsigned char* end,
+                 int flags)
+        : BinaryBase{status, flags}
+        , m_buffer{nullptr}
+        , m_begin{begin}
+        , m_end{end}
+        , m_cursor{begin}
+    {
+    }
+
+    /**
+     * add element to the object.
+     * @tparam T the type of the value to be serialized.
+     * @param name name of the element.
+     * @param value value of the element.
+     */
+    template <class T>
+    void add_element(const std::string& name, const T& value);
+
+    /**
+     * add optional element to the object.
+     * An empty optional is not stored at all.
+     * @tparam T the type of the value to be serialized.
+     * @param name name of the element.
+     * @param value pointer to value of the element, may be null.
+     */
+    template <class T>
+    void add_optional(const std::string& name, const T* value);
+
+    /**
+     * add list of elements to the object.
+     * Lists of basic types are stored as one contiguous block.
+     * @tparam Iter type of the iterators that represent the list.
+     * @param name name of the list.
+     * @param b iterator to first element in the list.
+     * @param e iterator to end of the list.
+     */
+    template <class Iter>
+    void add_list(const std::string& name, Iter b, Iter e);
+
+    /**
+     * retrieve element from the object.
+     * @tparam T the type of value to be deserialized.
+     * @param name name of the element.
+     * @param tag define type of the element for overload resolution.
+     * @return retrieved element if succesful, error otherwise.
+     */
+    template <class T>
+    IOResult<T> expect_element(const std::string& name, Tag<T> tag);
+
+    /**
+     * retrieve optional element from the object.
+     * @tparam T the type of value to be deserialized.
+     * @param name name of the element.
+     * @param tag define type of the element for overload resolution.
+     * @return retrieved element if name is found and can be deserialized, empty optional if not found, error otherwise.
+     */
+    template <class T>
+    IOResult<boost::optional<T>> expect_optional(const std::string& name, Tag<T> tag);
+
+    /**
+     * retrieve list of elements from the object.
+     * @tparam T the type of the elements in the list to be deserialized.
+     * @param name name of the list.
+     * @param tag define type of the list elements for overload resolution.
+     * @return vector of deserialized elements if succesful, error otherwise.
+     */
+    template <class T>
+    IOResult<std::vector<T>> expect_list(const std::string& name, Tag<T> tag);
+
+private:
+    //write name and a placeholder for the size of the record, returns position of the placeholder
+    size_t begin_record(const std::string& name);
+    //write size of the record that started at the given position
+    void end_record(size_t size_pos);
+    //find the record with the given name, starting the search at the cursor
+    //returns false and leaves the output untouched if not found, sets status on corrupt data
+    bool find_record(const std::string& name, const unsigned char*& data_begin, const unsigned char*& data_end);
+
+    std::vector<unsigned char>* m_buffer;
+    const unsigned char* m_begin;
+    const unsigned char* m_end;
+    const unsigned char* m_cursor;
+};
+
+/**
+ * Implementation of IOContext concept for binary format.
+ * Basic types and dense Eigen matrices are stored directly by their object representation
+ * in native byte order. Matrices are stored as one block in column major order.
+ */
+class BinaryContext : public BinaryBase
+{
+public:
+    /**
+     * Create context for serialization, set status and flags.
+     * @param status status of serialization, shared with parent IO contexts and objects.
+     * @param buffer buffer that the data is appended to.
+     * @param flags flags to determine behavior of serialization.
+     */
+    BinaryContext(const std::shared_ptr<IOStatus>& status, std::vector<unsigned char>& buffer, int flags)
+        : BinaryBase{status, flags}
+        , m_buffer{&buffer}
+        , m_begin{nullptr}
+        , m_end{nullptr}
+    {
+    }
+
+    /**
+     * Create context for deserialization, set status, flags and the range of bytes that contains the data.
+     * @param begin pointer to the first byte of the data.
+     * @param end pointer behind the last byte of the data.
+     * @param status status of serialization, shared with parent IO contexts and objects.
+     * @param flags flags to determine behavior of serialization.
+     */
+    BinaryContext(const unsigned char* begin, const unsigned char* end, const std::shared_ptr<IOStatus>& status,
+                  int flags)
+        : BinaryBase{status, flags}
+        , m_buffer{nullptr}
+        , m_begin{begin}
+        , m_end{end}
+    {
+    }
+
+    /**
+     * Create a BinaryObject that accepts serialization data.
+     * The type of the object is currently ignored.
+     * @param type name of the type of the object.
+     * @return new BinaryObject for serialization.
+     */
+    BinaryObject create_object(const std::string& type)
+    {
+        mio::unused(type);
+        assert(m_buffer && "Context was not created for serialization.");
+        return {m_status, *m_buffer, m_flags};
+    }
+
+    /**
+     * Create a BinaryObject that contains serialized data.
+     * The type of the object is currently ignored.
+     * @param type name of the type of the object.
+     * @return new BinaryObject for deserialization.
+     */
+    BinaryObject expect_object(const std::string& type)
+    {
+        mio::unused(type);
+        return {m_status, m_begin, m_end, m_flags};
+    }
+
+    /**
+     * Serialize basic types by their object representation.
+     */
+    template <class T, std::enable_if_t<details::is_binary_basic_type<T>::value, void*> = nullptr>
+    friend void serialize_internal(BinaryContext& io, const T& t)
+    {
+        if (io.m_status->is_ok()) {
+            details::append_bytes(*io.m_buffer, t);
+        }
+    }
+
+    /**
+     * Deserialize basic types from their object representation.
+     */
+    template <class T, std::enable_if_t<details::is_binary_basic_type<T>::value, void*> = nullptr>
+    friend IOResult<T> deserialize_internal(BinaryContext& io, Tag<T>)
+    {
+        if (size_t(io.m_end - io.m_begin) != sizeof(T)) {
+            return failure(StatusCode::InvalidType, "Binary value does not have the size of the requested type.");
+        }
+        return success(details::load_bytes<T>(io.m_begin));
+    }
+
+    /**
+     * Serialize strings as the characters without terminating null.
+     * @{
+     */
+    friend void serialize_internal(BinaryContext& io, const std::string& s)
+    {
+        if (io.m_status->is_ok()) {
+            details::append_bytes(*io.m_buffer, s.data(), s.size());
+        }
+    }
+    friend void serialize_internal(BinaryContext& io, const char* s)
+    {
+        if (io.m_status->is_ok()) {
+            details::append_bytes(*io.m_buffer, s, std::strlen(s));
+        }
+    }
+    /**@}*/
+
+    /**
+     * Deserialize strings.
+     */
+    friend IOResult<std::string> deserialize_internal(BinaryContext& io, Tag<std::string>)
+    {
+        return success(std::string(reinterpret_cast<const char*>(io.m_begin), size_t(io.m_end - io.m_begin)));
+    }
+
+    /**
+     * Serialize dense Eigen matrices (and expressions) as one block of values.
+     * The shape is stored in front of the values, the values are stored in column major order.
+     */
+    template <class M, std::enable_if_t<details::is_binary_matrix<M>::value, void*> = nullptr>
+    friend void serialize_internal(BinaryContext& io, const M& mat)
+    {
+        if (io.m_status->is_ok()) {
+            using Scalar = typename M::Scalar;
+            //Ref only evaluates into a temporary if the expression isn't already stored in column major order
+            Eigen::Ref<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>, 0, Eigen::OuterStride<>> ref(
+                mat.derived());
+            details::append_bytes(*io.m_buffer, int64_t(ref.rows()));
+            details::append_bytes(*io.m_buffer, int64_t(ref.cols()));
+            for (Eigen::Index j = 0; j < ref.cols(); ++j) {
+                details::append_bytes(*io.m_buffer, ref.col(j).data(), size_t(ref.rows()) * sizeof(Scalar));
+            }
+        }
+    }
+
+    /**
+     * Deserialize dense Eigen matrices.
+     */
+    template <class M, std::enable_if_t<details::is_binary_matrix<M>::value, void*> = nullptr>
+    friend IOResult<M> deserialize_internal(BinaryContext& io, Tag<M>)
+    {
+        using Scalar    = typename M::Scalar;
+        auto num_bytes  = size_t(io.m_end - io.m_begin);
+        auto shape_size = 2 * sizeof(int64_t);
+        if (num_bytes < shape_size) {
+            return failure(StatusCode::InvalidFileFormat, "Binary matrix is truncated.");
+        }
+        auto rows = details::load_bytes<int64_t>(io.m_begin);
+        auto cols = details::load_bytes<int64_t>(io.m_begin + sizeof(int64_t));
+        //check the shape before multiplying, corrupt files may contain any value
+        if (rows < 0 || cols < 0 ||
+            (cols != 0 && uint64_t(rows) > (num_bytes - shape_size) / sizeof(Scalar) / uint64_t(cols)) ||
+            num_bytes - shape_size != size_t(rows * cols) * sizeof(Scalar)) {
+            return failure(StatusCode::InvalidFileFormat, "Binary matrix size does not match its shape.");
+        }
+        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> m(rows, cols);
+        if (rows * cols > 0) {
+            std::memcpy(m.data(), io.m_begin + shape_size, size_t(rows * cols) * sizeof(Scalar));
+        }
+        return success(M(m));
+    }
+
+private:
+    std::vector<unsigned char>* m_buffer;
+    const unsigned char* m_begin;
+    const unsigned char* m_end;
+};
+
+/**
+ * Serialize an object into a buffer in binary format.
+ * The buffer starts with a header that contains the version of the format and the flags.
+ * @tparam T the type of value to be serialized.
+ * @param t the object to be serialized.
+ * @param flags flags that determine the behavior of serialization; see mio::IOFlags.
+ * @return buffer with the binary data if serialization is succesful, error code otherwise.
+ */
+template <class T>
+IOResult<std::vector<unsigned char>> serialize_binary(const T& t, int flags = IOF_None)
+{
+    std::vector<unsigned char> buffer;
+    details::write_binary_header(buffer, flags);
+    BinaryContext ctxt{std::make_shared<IOStatus>(), buffer, flags};
+    mio::serialize(ctxt, t);
+    if (!ctxt.status()) {
+        return failure(ctxt.status());
+    }
+    return success(std::move(buffer));
+}
+
+/**
+ * Deserialize an object from a buffer in binary format.
+ * @tparam T the type of value to be deserialized.
+ * @param buffer buffer that contains the binary data, including the header.
+ * @param tag defines the type of the object for overload resolution.
+ * @param flags define behavior of serialization; must be the same as during serialization; see mio::IOFlags.
+ * @return the deserialized object if succesful, error code otherwise.
+ */
+template <class T>
+IOResult<T> deserialize_binary(const std::vector<unsigned char>& buffer, Tag<T> tag, int flags = IOF_None)
+{
+    BOOST_OUTCOME_TRY(offset, details::read_binary_header(buffer, flags));
+    BinaryContext ctxt{buffer.data() + offset, buffer.data() + buffer.size(), std::make_shared<IOStatus>(), flags};
+    return mio::deserialize(ctxt, tag);
+}
+
+/**
+ * Write a buffer into a file.
+ * @param path path of the file.
+ * @param buffer data to be written.
+ * @return nothing if succesful, error code otherwise.
+ */
+IOResult<void> write_binary(const std::string& path, const std::vector<unsigned char>& buffer);
+
+/**
+ * Serialize an object in binary format and write it into a file.
+ * @tparam T the type of value to be serialized.
+ * @param path the path of the file.
+ * @param t the object to be serialized.
+ * @param flags flags that determine the behavior of the serialization; see mio::IOFlags.
+ * @return nothing if succesful, error code otherwise.
+ */
+template <class T>
+IOResult<void> write_binary(const std::string& path, const T& t, int flags = IOF_None)
+{
+    BOOST_OUTCOME_TRY(buffer, serialize_binary(t, flags));
+    return write_binary(path, buffer);
+}
+
+/**
+ * Read the contents of a file into a buffer.
+ * @param path path of the file.
+ * @return buffer with the contents of the file if succesful, error code otherwise.
+ */
+IOResult<std::vector<unsigned char>> read_binary(const std::string& path);
+
+/**
+ * Read a file in binary format and deserialize it into an object.
+ * @tparam T the type of value to be deserialized.
+ * @param path the path of the file.
+ * @param tag defines the type of the object for overload resolution.
+ * @param flags define behavior of serialization; see mio::IOFlags.
+ * @return the deserialized object if succesful, error code otherwise.
+ */
+template <class T>
+IOResult<T> read_binary(const std::string& path, Tag<T> tag, int flags = IOF_None)
+{
+    BOOST_OUTCOME_TRY(buffer, read_binary(path));
+    return deserialize_binary(buffer, tag, flags);
+}
+
+///////////////////////////////////////////////////////////////
+//Implementations for BinaryObject member functions below//
+///////////////////////////////////////////////////////////////
+
+inline size_t BinaryObject::begin_record(const std::string& name)
+{
+    details::append_bytes(*m_buffer, uint32_t(name.size()));
+    details::append_bytes(*m_buffer, name.data(), name.size());
+    auto size_pos = m_buffer->size();
+    details::append_bytes(*m_buffer, uint64_t(0));
+    return size_pos;
+}
+
+inline void BinaryObject::end_record(size_t size_pos)
+{
+    auto size = uint64_t(m_buffer->size() - size_pos - sizeof(uint64_t));
+    std::memcpy(m_buffer->data() + size_pos, &size, sizeof(uint64_t));
+}
+
+inline bool BinaryObject::find_record(const std::string& name, const unsigned char*& data_begin,
+                                      const unsigned char*& data_end)
+{
+    //search from the cursor to the end, then wrap around and search from the beginning to the cursor
+    auto search = [&](const unsigned char* first, const unsigned char* last) {
+        auto p = first;
+        while (p < last) {
+            if (size_t(m_end - p) < sizeof(uint32_t)) {
+                set_error(IOStatus{StatusCode::InvalidFileFormat, "Binary record is truncated."});
+                return false;
+            }
+            auto name_size = details::load_bytes<uint32_t>(p);
+            p += sizeof(uint32_t);
+            if (size_t(m_end - p) < name_size + sizeof(uint64_t)) {
+                set_error(IOStatus{StatusCode::InvalidFileFormat, "Binary record is truncated."});
+                return false;
+            }
+            auto record_name = p;
+            p += name_size;
+            auto data_size = details::load_bytes<uint64_t>(p);
+            p += sizeof(uint64_t);
+            if (uint64_t(m_end - p) < data_size) {
+                set_error(IOStatus{StatusCode::InvalidFileFormat, "Binary record is truncated."});
+                return false;
+            }
+            if (name_size == name.size() && std::memcmp(record_name, name.data(), name_size) == 0) {
+                data_begin = p;
+                data_end   = p + data_size;
+                m_cursor   = data_end;
+                return true;
+            }
+            p += data_size;
+        }
+        return false;
+    };
+    return search(m_cursor, m_end) || (m_status->is_ok() && search(m_begin, m_cursor));
+}
+
+template <class T>
+void BinaryObject::add_element(const std::string& name, const T& value)
+{
+    if (m_status->is_ok()) {
+        auto size_pos = begin_record(name);
+        auto ctxt     = BinaryContext(m_status, *m_buffer, m_flags);
+        mio::serialize(ctxt, value);
+        end_record(size_pos);
+    }
+}
+
+template <class T>
+void BinaryObject::add_optional(const std::string& name, const T* value)
+{
+    if (value) {
+        add_element(name, *value);
+    }
+}
+
+template <class Iter>
+void BinaryObject::add_list(const std::string& name, Iter b, Iter e)
+{
+    if (m_status->is_ok()) {
+        using T       = std::decay_t<decltype(*b)>;
+        auto size_pos = begin_record(name);
+        //list header: size of basic type elements (0 for other types) and number of elements
+        auto count_pos = m_buffer->size() + sizeof(uint8_t);
+        details::append_bytes(*m_buffer, uint8_t(details::is_binary_basic_type<T>::value ? sizeof(T) : 0));
+        details::append_bytes(*m_buffer, uint64_t(0));
+        uint64_t count = 0;
+        for (auto it = b; it != e; ++it, ++count) {
+            if (details::is_binary_basic_type<T>::value) {
+                //basic types have a fixed size, so no size is needed for each element
+                auto ctxt = BinaryContext(m_status, *m_buffer, m_flags);
+                mio::serialize(ctxt, *it);
+            }
+            else {
+                add_element("", *it);
+            }
+        }
+        std::memcpy(m_buffer->data() + count_pos, &count, sizeof(uint64_t));
+        end_record(size_pos);
+    }
+}
+
+template <class T>
+IOResult<T> BinaryObject::expect_element(const std::string& name, Tag<T> tag)
+{
+    if (m_status->is_error()) {
+        return failure(*m_status);
+    }
+    const unsigned char* data_begin;
+    const unsigned char* data_end;
+    if (!find_record(name, data_begin, data_end)) {
+        if (m_status->is_error()) {
+            return failure(*m_status);
+        }
+        return failure(StatusCode::KeyNotFound, name);
+    }
+    auto ctxt = BinaryContext(data_begin, data_end, m_status, m_flags);
+    return mio::deserialize(ctxt, tag);
+}
+
+template <class T>
+IOResult<boost::optional<T>> BinaryObject::expect_optional(const std::string& name, Tag<T> tag)
+{
+    if (m_status->is_error()) {
+        return failure(*m_status);
+    }
+    const unsigned char* data_begin;
+    const unsigned char* data_end;
+    if (!find_record(name, data_begin, data_end)) {
+        if (m_status->is_error()) {
+            return failure(*m_status);
+        }
+        return success(boost::optional<T>{});
+    }
+    auto ctxt = BinaryContext(data_begin, data_end, m_status, m_flags);
+    BOOST_OUTCOME_TRY(t, mio::deserialize(ctxt, tag));
+    return success(boost::optional<T>(std::move(t)));
+}
+
+template <class T>
+IOResult<std::vector<T>> BinaryObject::expect_list(const std::string& name, Tag<T> tag)
+{
+    if (m_status->is_error()) {
+        return failure(*m_status);
+    }
+    const unsigned char* data_begin;
+    const unsigned char* data_end;
+    if (!find_record(name, data_begin, data_end)) {
+        if (m_status->is_error()) {
+            return failure(*m_status);
+        }
+        return failure(StatusCode::KeyNotFound, name);
+    }
+
+    auto header_size = sizeof(uint8_t) + sizeof(uint64_t);
+    if (size_t(data_end - data_begin) < header_size) {
+        return failure(StatusCode::InvalidFileFormat, "Binary list header is truncated (" + name + ").");
+    }
+    auto element_size = details::load_bytes<uint8_t>(data_begin);
+    auto count        = details::load_bytes<uint64_t>(data_begin + sizeof(uint8_t));
+    auto expected_size = uint8_t(details::is_binary_basic_type<T>::value ? sizeof(T) : 0);
+    if (element_size != expected_size) {
+        return failure(StatusCode::InvalidType, "Binary list does not have the requested type (" + name + ").");
+    }
+    data_begin += header_size;
+
+    //check the number of elements before reserving, corrupt files may contain any value
+    std::vector<T> v;
+    auto num_bytes = uint64_t(data_end - data_begin);
+    if (details::is_binary_basic_type<T>::value) {
+        if (count > num_bytes / element_size || num_bytes != count * element_size) {
+            return failure(StatusCode::InvalidFileFormat, "Binary list size does not match (" + name + ").");
+        }
+        v.reserve(count);
+        for (uint64_t i = 0; i < count; ++i) {
+            auto ctxt = BinaryContext(data_begin + i * element_size, data_begin + (i + 1) * element_size, m_status,
+                                      m_flags);
+            BOOST_OUTCOME_TRY(t, mio::deserialize(ctxt, tag));
+            v.emplace_back(std::move(t));
+        }
+    }
+    else {
+        //each element is a record with at least the size of the name and the size of the data
+        if (count > num_bytes / (sizeof(uint32_t) + sizeof(uint64_t))) {
+            return failure(StatusCode::InvalidFileFormat, "Binary list is truncated (" + name + ").");
+        }
+        auto elements = BinaryObject(m_status, data_begin, data_end, m_flags);
+        v.reserve(count);
+        for (uint64_t i = 0; i < count; ++i) {
+            BOOST_OUTCOME_TRY(t, elements.expect_element("", tag));
+            v.emplace_back(std::move(t));
+        }
+    }
+    return success(std::move(v));
+}
+
+} // namespace mio
+
+#endif //EPI_IO_BINARY_SERIALIZER_H
@@ -22,6 +22,20 @@
 
 #ifdef MEMILIO_HAS_JSONCPP
 
+#include "json/reader.h"
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
 namespace mio
 {
 const std::array<const char*, 6> ConfirmedCasesDataEntry::age_group_names = {"A00-A04", "A05-A14", "A15-A34",
@@ -34,6 +48,290 @@ const std::array<const char*, 11> PopulationDataEntry::age_group_names = {
 const std::array<const char*, 6> VaccinationDataEntry::age_group_names = {"0-4",   "5-14",  "15-34",
                                                                           "35-59", "60-79", "80-99"};
 
+namespace details
+{
+IOResult<void> read_json_array(const std::string& filename,
+                               const std::function<IOResult<void>(const Json::Value&)>& f)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.is_open()) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+
+    //read characters directly from the buffer, much faster than formatted input
+    auto buf            = ifs.rdbuf();
+    auto next_non_space = [buf]() {
+        int c;
+        while ((c = buf->sbumpc()) != std::char_traits<char>::eof()) {
+            if (!std::isspace(c)) {
+                return c;
+            }
+        }
+        return c;
+    };
+
+    if (next_non_space() != '[') {
+        return failure(StatusCode::InvalidType, filename + ", Json value must be an array.");
+    }
+
+    Json::CharReaderBuilder crb;
+    auto reader = std::unique_ptr<Json::CharReader>(crb.newCharReader());
+    std::string object_str;
+    Json::Value js_object;
+    std::string err_msg;
+    for (auto c = next_non_space(); c != ']';) {
+        if (c == std::char_traits<char>::eof()) {
+            return failure(StatusCode::UnknownError, filename + ", unexpected end of file.");
+        }
+        if (c != '{') {
+            return failure(StatusCode::InvalidType, filename + ", Json array must contain only objects.");
+        }
+
+        //collect the characters of the object, nested objects and braces inside of strings are skipped
+        object_str.assign(1, '{');
+        auto depth     = 1;
+        auto in_string = false;
+        auto escaped   = false;
+        int ch;
+        while (depth > 0 && (ch = buf->sbumpc()) != std::char_traits<char>::eof()) {
+            object_str.push_back(char(ch));
+            if (in_string) {
+                if (escaped) {
+                    escaped = false;
+                }
+                else if (ch == '\\') {
+                    escaped = true;
+                }
+                else if (ch == '"') {
+                    in_string = false;
+                }
+            }
+            else if (ch == '"') {
+                in_string = true;
+            }
+            else if (ch == '{') {
+                ++depth;
+            }
+            else if (ch == '}') {
+                --depth;
+            }
+        }
+        if (depth > 0) {
+            return failure(StatusCode::UnknownError, filename + ", unexpected end of file.");
+        }
+
+        if (!reader->parse(object_str.data(), object_str.data() + object_str.size(), &js_object, &err_msg)) {
+            return failure(StatusCode::UnknownError, filename + ", " + err_msg);
+        }
+        BOOST_OUTCOME_TRY(f(js_object));
+
+        c = next_non_space();
+        if (c == ',') {
+            c = next_non_space();
+        }
+        else if (c != ']') {
+            return failure(StatusCode::UnknownError, filename + ", expected ',' or ']' after object in array.");
+        }
+    }
+
+    return success();
+}
+} // namespace details
+
+namespace
+{
+/**
+ * Modification time and size of a file, used to detect if a cached file has changed.
+ */
+struct FileStamp {
+    int64_t last_write_time; ///< nanoseconds since the epoch, seconds only on systems without POSIX stat.
+    uint64_t size;
+    bool operator==(const FileStamp& other) const
+    {
+        return last_write_time == other.last_write_time && size == other.size;
+    }
+};
+
+IOResult<FileStamp> get_file_stamp(const std::string& filename)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct stat file_stat;
+    if (stat(filename.c_str(), &file_stat) != 0) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+#ifdef __APPLE__
+    auto& mtime = file_stat.st_mtimespec;
+#else
+    auto& mtime = file_stat.st_mtim;
+#endif
+    return success(FileStamp{int64_t(mtime.tv_sec) * 1000000000 + int64_t(mtime.tv_nsec), uint64_t(file_stat.st_size)});
+#else
+    boost::system::error_code ec;
+    auto last_write_time = boost::filesystem::last_write_time(filename, ec);
+    if (ec) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+    auto size = boost::filesystem::file_size(filename, ec);
+    if (ec) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+    return success(FileStamp{int64_t(last_write_time) * 1000000000, uint64_t(size)});
+#endif
+}
+
+/**
+ * Current time in nanoseconds since the epoch, same clock as the modification time of files.
+ */
+int64_t get_current_time()
+{
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return int64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+/**
+ * Maximum number of tables of each type in the cache, see set_epi_data_cache_capacity.
+ */
+std::atomic<size_t> g_epi_data_cache_capacity{4};
+
+/**
+ * Tables that have been read from files, by absolute file name.
+ * Holds at most g_epi_data_cache_capacity tables, the least recently used table is removed first.
+ */
+template <class Entry>
+class EpiDataCache
+{
+public:
+    static EpiDataCache& get_instance()
+    {
+        static EpiDataCache instance;
+        return instance;
+    }
+
+    /**
+     * Get the table of a file from the cache or read it if it is not cached or the file has changed.
+     * The file is read without holding the lock, so different files can be read in parallel.
+     * @param filename name of the file.
+     * @param read function that reads a list of entries from a file.
+     */
+    template <class ReadFunction>
+    IOResult<std::shared_ptr<const EpiDataTable<Entry>>> get(const std::string& filename, ReadFunction read)
+    {
+        BOOST_OUTCOME_TRY(stamp, get_file_stamp(filename));
+        auto key = boost::filesystem::absolute(filename).string();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_tables.find(key);
+            //the modification time has limited resolution, so a file that was modified shortly before it was read
+            //may have been modified again without changing the stamp and must be read again
+            if (it != m_tables.end() && it->second.stamp == stamp &&
+                it->second.read_time - stamp.last_write_time >= 1000000000) {
+                it->second.last_use = ++m_num_uses;
+                return success(it->second.table);
+            }
+        }
+
+        auto read_time = get_current_time();
+        BOOST_OUTCOME_TRY(entries, read(filename));
+        auto table = std::make_shared<const EpiDataTable<Entry>>(std::move(entries));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto capacity = g_epi_data_cache_capacity.load();
+        if (capacity > 0) {
+            //another thread may have read the same file in the meantime, keep the table that was read last
+            auto& cached = m_tables[key];
+            if (!cached.table || cached.read_time <= read_time) {
+                cached = CachedTable{stamp, read_time, ++m_num_uses, table};
+            }
+        }
+        evict(capacity);
+        return success(std::move(table));
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tables.clear();
+    }
+
+    void shrink(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        evict(capacity);
+    }
+
+private:
+    struct CachedTable {
+        FileStamp stamp;
+        int64_t read_time; ///< time before the file was read, same clock as the modification time.
+        uint64_t last_use;
+        std::shared_ptr<const EpiDataTable<Entry>> table;
+    };
+
+    //remove the least recently used tables until there are at most capacity tables
+    void evict(size_t capacity)
+    {
+        while (m_tables.size() > capacity) {
+            m_tables.erase(std::min_element(m_tables.begin(), m_tables.end(), [](auto& a, auto& b) {
+                return a.second.last_use < b.second.last_use;
+            }));
+        }
+    }
+
+    std::mutex m_mutex;
+    uint64_t m_num_uses = 0;
+    std::map<std::string, CachedTable> m_tables;
+};
+} // namespace
+
+IOResult<std::shared_ptr<const EpiDataTable<ConfirmedCasesDataEntry>>>
+read_confirmed_cases_data_table(const std::string& filename)
+{
+    return EpiDataCache<ConfirmedCasesDataEntry>::get_instance().get(filename, [](auto&& f) {
+        return read_confirmed_cases_data(f);
+    });
+}
+
+IOResult<std::shared_ptr<const EpiDataTable<DiviEntry>>> read_divi_data_table(const std::string& filename)
+{
+    return EpiDataCache<DiviEntry>::get_instance().get(filename, [](auto&& f) {
+        return read_divi_data(f);
+    });
+}
+
+IOResult<std::shared_ptr<const EpiDataTable<PopulationDataEntry>>>
+read_population_data_table(const std::string& filename)
+{
+    return EpiDataCache<PopulationDataEntry>::get_instance().get(filename, [](auto&& f) {
+        return read_population_data(f);
+    });
+}
+
+IOResult<std::shared_ptr<const EpiDataTable<VaccinationDataEntry>>>
+read_vaccination_data_table(const std::string& filename)
+{
+    return EpiDataCache<VaccinationDataEntry>::get_instance().get(filename, [](auto&& f) {
+        return read_vaccination_data(f);
+    });
+}
+
+void set_epi_data_cache_capacity(size_t capacity)
+{
+    g_epi_data_cache_capacity = capacity;
+    EpiDataCache<ConfirmedCasesDataEntry>::get_instance().shrink(capacity);
+    EpiDataCache<DiviEntry>::get_instance().shrink(capacity);
+    EpiDataCache<PopulationDataEntry>::get_instance().shrink(capacity);
+    EpiDataCache<VaccinationDataEntry>::get_instance().shrink(capacity);
+}
+
+void clear_epi_data_cache()
+{
+    EpiDataCache<ConfirmedCasesDataEntry>::get_instance().clear();
+    EpiDataCache<DiviEntry>::get_instance().clear();
+    EpiDataCache<PopulationDataEntry>::get_instance().clear();
+    EpiDataCache<VaccinationDataEntry>::get_instance().clear();
+}
+
 IOResult<std::vector<int>> get_county_ids(const std::string& path)
 {
     BOOST_OUTCOME_TRY(population_data, read_population_data(path_join(path, "county_current_population.json")));
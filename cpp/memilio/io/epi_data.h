@@ -30,9 +30,15 @@
 #include "memilio/io/json_serializer.h"
 #include "memilio/utils/custom_index_array.h"
 #include "memilio/utils/date.h"
+#include "memilio/utils/metaprogramming.h"
+#include "memilio/utils/stl_util.h"
 
 #include "json/value.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace mio
@@ -65,6 +71,39 @@ public:
     }
 };
 
+namespace details
+{
+/**
+ * Read a json array of objects from a file one object at a time.
+ * Only one object is kept in memory at a time instead of the whole array, 
+ * which makes it possible to read very large files quickly.
+ * @param filename name of the json file. File content must be an array of objects.
+ * @param f function that is called with each object of the array in order.
+ * @return any error that occurs during reading or that is returned by f.
+ */
+IOResult<void> read_json_array(const std::string& filename,
+                               const std::function<IOResult<void>(const Json::Value&)>& f);
+
+/**
+ * Read a json array of objects from a file and deserialize each object.
+ * @see read_json_array
+ * @tparam T type of the objects.
+ * @param filename name of the json file. File content must be an array of objects, objects must match T.
+ * @return list of deserialized objects.
+ */
+template <class T>
+IOResult<std::vector<T>> read_json_array(const std::string& filename, Tag<T>)
+{
+    std::vector<T> v;
+    BOOST_OUTCOME_TRY(read_json_array(filename, [&v](const Json::Value& js) -> IOResult<void> {
+        BOOST_OUTCOME_TRY(t, deserialize_json(js, Tag<T>{}));
+        v.push_back(std::move(t));
+        return success();
+    }));
+    return success(std::move(v));
+}
+} // namespace details
+
 /**
  * Represents the entries of a confirmed cases data file, e.g., from RKI.
  * Number of confirmed, recovered and deceased in a region on a specific date.
@@ -134,13 +173,22 @@ inline IOResult<std::vector<ConfirmedCasesDataEntry>> deserialize_confirmed_case
 
 /**
  * Read list of ConfirmedCasesDataEntry from a json file.
+ * The file is read one entry at a time.
  * @param filename name of the json file. File content must be an array of objects, objects must match ConfirmedCasesDataEntry.
  * @return list of entries; entries of unknown age group are omitted.
  */
 inline IOResult<std::vector<ConfirmedCasesDataEntry>> read_confirmed_cases_data(const std::string& filename)
 {
-    BOOST_OUTCOME_TRY(jsvalue, read_json(filename));
-    return deserialize_confirmed_cases_data(jsvalue);
+    std::vector<ConfirmedCasesDataEntry> cases_data;
+    BOOST_OUTCOME_TRY(details::read_json_array(filename, [&cases_data](const Json::Value& js) -> IOResult<void> {
+        BOOST_OUTCOME_TRY(entry, deserialize_json(js, Tag<ConfirmedCasesDataEntry>{}));
+        //filter entries with unknown age group
+        if (entry.age_group < AgeGroup(ConfirmedCasesDataEntry::age_group_names.size())) {
+            cases_data.push_back(entry);
+        }
+        return success();
+    }));
+    return success(std::move(cases_data));
 }
 
 /**
@@ -191,7 +239,7 @@ inline IOResult<std::vector<DiviEntry>> deserialize_divi_data(const Json::Value&
  */
 inline IOResult<std::vector<DiviEntry>> read_divi_data(const std::string& filename)
 {
-    return read_json(filename, Tag<std::vector<DiviEntry>>{});
+    return details::read_json_array(filename, Tag<DiviEntry>{});
 }
 
 namespace details
@@ -352,8 +400,8 @@ inline IOResult<std::vector<PopulationDataEntry>> deserialize_population_data(co
  */
 inline IOResult<std::vector<PopulationDataEntry>> read_population_data(const std::string& filename)
 {
-    BOOST_OUTCOME_TRY(jsvalue, read_json(filename));
-    return deserialize_population_data(jsvalue);
+    BOOST_OUTCOME_TRY(population_data, details::read_json_array(filename, Tag<PopulationDataEntry>{}));
+    return success(details::interpolate_to_rki_age_groups(population_data));
 }
 
 /**
@@ -420,9 +468,253 @@ inline IOResult<std::vector<VaccinationDataEntry>> deserialize_vaccination_data(
  */
 inline IOResult<std::vector<VaccinationDataEntry>> read_vaccination_data(const std::string& filename)
 {
-    BOOST_OUTCOME_TRY(jsvalue, read_json(filename));
-    return deserialize_vaccination_data(jsvalue);
+    return details::read_json_array(filename, Tag<VaccinationDataEntry>{});
+}
+
+namespace details
+{
+template <class T>
+using epi_data_date_expr_t = decltype(std::declval<T>().date);
+template <class T>
+using epi_data_age_group_expr_t = decltype(std::declval<T>().age_group);
+
+//date of an entry if the entry type has a date, 0 otherwise, so entries of all types can be sorted the same way
+template <class Entry, std::enable_if_t<mio::is_expression_valid<epi_data_date_expr_t, Entry>::value, void*> = nullptr>
+Date get_epi_data_date(const Entry& entry)
+{
+    return entry.date;
 }
+template <class Entry, std::enable_if_t<!mio::is_expression_valid<epi_data_date_expr_t, Entry>::value, void*> = nullptr>
+int get_epi_data_date(const Entry&)
+{
+    return 0;
+}
+
+//age group of an entry if the entry type has an age group, 0 otherwise, so entries of all types can be sorted the same way
+template <class Entry,
+          std::enable_if_t<mio::is_expression_valid<epi_data_age_group_expr_t, Entry>::value, void*> = nullptr>
+AgeGroup get_epi_data_age_group(const Entry& entry)
+{
+    return entry.age_group;
+}
+template <class Entry,
+          std::enable_if_t<!mio::is_expression_valid<epi_data_age_group_expr_t, Entry>::value, void*> = nullptr>
+int get_epi_data_age_group(const Entry&)
+{
+    return 0;
+}
+} // namespace details
+
+/**
+ * Table of epidemiological data entries indexed by region, date and age group.
+ * Entries are sorted by region, then by date and age group if the entry type has them.
+ * Entries of a region, a day or a single age group can be found quickly without searching through all entries.
+ * @tparam Entry type of data entries, e.g. ConfirmedCasesDataEntry or DiviEntry.
+ */
+template <class Entry>
+class EpiDataTable
+{
+public:
+    using Iterator = typename std::vector<Entry>::const_iterator;
+
+    /**
+     * Create a table from a list of entries.
+     * @param entries list of entries in any order.
+     */
+    explicit EpiDataTable(std::vector<Entry> entries)
+        : m_entries(std::move(entries))
+    {
+        std::stable_sort(m_entries.begin(), m_entries.end(), [](auto&& a, auto&& b) {
+            return get_key(a) < get_key(b);
+        });
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            auto region_id = get_region_id(m_entries[i]);
+            if (m_region_ids.empty() || m_region_ids.back() != region_id) {
+                m_region_ids.push_back(region_id);
+                m_region_offsets.push_back(i);
+            }
+        }
+        m_region_offsets.push_back(m_entries.size());
+    }
+
+    /**
+     * County or state id of an entry if available, 0 (for whole country) otherwise.
+     */
+    static int get_region_id(const Entry& entry)
+    {
+        return entry.county_id ? entry.county_id->get() : (entry.state_id ? entry.state_id->get() : 0);
+    }
+
+    /**
+     * All entries of the table, sorted by region, date and age group.
+     */
+    const std::vector<Entry>& get_entries() const
+    {
+        return m_entries;
+    }
+
+    /**
+     * Sorted ids of all regions that have entries in the table.
+     */
+    const std::vector<int>& get_region_ids() const
+    {
+        return m_region_ids;
+    }
+
+    /**
+     * Entries of one region.
+     * @param region_id id of the region, 0 for entries of the whole country.
+     * @return range of entries, empty if the table has no entries for the region.
+     */
+    Range<std::pair<Iterator, Iterator>> get_entries(int region_id) const
+    {
+        auto it = std::lower_bound(m_region_ids.begin(), m_region_ids.end(), region_id);
+        if (it == m_region_ids.end() || *it != region_id) {
+            return make_range(m_entries.end(), m_entries.end());
+        }
+        auto idx = size_t(it - m_region_ids.begin());
+        return make_range(m_entries.begin() + m_region_offsets[idx], m_entries.begin() + m_region_offsets[idx + 1]);
+    }
+
+    /**
+     * Entries of one region on one day.
+     * @param region_id id of the region, 0 for entries of the whole country.
+     * @param date date of the entries.
+     * @return range of entries, empty if the table has no entries for the region and date.
+     */
+    template <class E                                                                                  = Entry,
+              std::enable_if_t<is_expression_valid<details::epi_data_date_expr_t, E>::value, void*> = nullptr>
+    Range<std::pair<Iterator, Iterator>> get_entries(int region_id, Date date) const
+    {
+        auto region_entries = get_entries(region_id);
+        return make_range(std::equal_range(region_entries.begin(), region_entries.end(), date, DateLess{}));
+    }
+
+    /**
+     * Entries of one age group of one region on one day.
+     * @param region_id id of the region, 0 for entries of the whole country.
+     * @param date date of the entries.
+     * @param age_group age group of the entries.
+     * @return range of entries, empty if the table has no entries for the region, date and age group.
+     */
+    template <class E                                                                                       = Entry,
+              std::enable_if_t<is_expression_valid<details::epi_data_age_group_expr_t, E>::value, void*> = nullptr>
+    Range<std::pair<Iterator, Iterator>> get_entries(int region_id, Date date, AgeGroup age_group) const
+    {
+        auto day_entries = get_entries(region_id, date);
+        return make_range(std::equal_range(day_entries.begin(), day_entries.end(), age_group, AgeGroupLess{}));
+    }
+
+    /**
+     * Latest date of any entry in the table.
+     * @return latest date, empty if the table is empty.
+     */
+    template <class E                                                                                  = Entry,
+              std::enable_if_t<is_expression_valid<details::epi_data_date_expr_t, E>::value, void*> = nullptr>
+    boost::optional<Date> get_max_date() const
+    {
+        auto it = std::max_element(m_entries.begin(), m_entries.end(), [](auto&& a, auto&& b) {
+            return a.date < b.date;
+        });
+        if (it == m_entries.end()) {
+            return {};
+        }
+        return it->date;
+    }
+
+private:
+    static auto get_key(const Entry& entry)
+    {
+        return std::make_tuple(get_region_id(entry), details::get_epi_data_date(entry),
+                               details::get_epi_data_age_group(entry));
+    }
+
+    //compare entries and dates, for searching entries of a day
+    struct DateLess {
+        bool operator()(const Entry& e, const Date& d) const
+        {
+            return e.date < d;
+        }
+        bool operator()(const Date& d, const Entry& e) const
+        {
+            return d < e.date;
+        }
+    };
+
+    //compare entries and age groups, for searching entries of an age group
+    struct AgeGroupLess {
+        bool operator()(const Entry& e, const AgeGroup& a) const
+        {
+            return e.age_group < a;
+        }
+        bool operator()(const AgeGroup& a, const Entry& e) const
+        {
+            return a < e.age_group;
+        }
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<int> m_region_ids; ///< sorted ids of all regions.
+    std::vector<size_t> m_region_offsets; ///< entries of region i are in [m_region_offsets[i], m_region_offsets[i+1]).
+};
+
+/**
+ * Read confirmed cases data from a json file into an indexed table.
+ * Tables are cached, so reading the same file again only costs a lookup as long as the file is not modified,
+ * see set_epi_data_cache_capacity.
+ * @param filename name of the json file. File content must be an array of objects, objects must match ConfirmedCasesDataEntry.
+ * @return shared table of entries; entries of unknown age group are omitted.
+ * @see read_confirmed_cases_data
+ */
+IOResult<std::shared_ptr<const EpiDataTable<ConfirmedCasesDataEntry>>>
+read_confirmed_cases_data_table(const std::string& filename);
+
+/**
+ * Read DIVI data from a json file into an indexed table.
+ * Tables are cached, so reading the same file again only costs a lookup as long as the file is not modified,
+ * see set_epi_data_cache_capacity.
+ * @param filename name of the json file. File content must be an array of objects, objects must match DiviEntry.
+ * @return shared table of entries.
+ * @see read_divi_data
+ */
+IOResult<std::shared_ptr<const EpiDataTable<DiviEntry>>> read_divi_data_table(const std::string& filename);
+
+/**
+ * Read population data from a json file into an indexed table.
+ * Age groups are interpolated to RKI age groups.
+ * Tables are cached, so reading the same file again only costs a lookup as long as the file is not modified,
+ * see set_epi_data_cache_capacity.
+ * @param filename name of the json file. File content must be an array of objects, objects must match PopulationDataEntry.
+ * @return shared table of entries.
+ * @see read_population_data
+ */
+IOResult<std::shared_ptr<const EpiDataTable<PopulationDataEntry>>>
+read_population_data_table(const std::string& filename);
+
+/**
+ * Read vaccination data from a json file into an indexed table.
+ * Tables are cached, so reading the same file again only costs a lookup as long as the file is not modified,
+ * see set_epi_data_cache_capacity.
+ * @param filename name of the json file. File content must be an array of objects, objects must match VaccinationDataEntry.
+ * @return shared table of entries.
+ * @see read_vaccination_data
+ */
+IOResult<std::shared_ptr<const EpiDataTable<VaccinationDataEntry>>>
+read_vaccination_data_table(const std::string& filename);
+
+/**
+ * Set the maximum number of tables of each type, e.g. confirmed cases, in the cache used by read_*_data_table.
+ * If there are more tables, the least recently used tables are removed. 0 disables the cache. Default is 4.
+ * Tables that are still in use elsewhere stay valid.
+ * @param capacity maximum number of tables of each type.
+ */
+void set_epi_data_cache_capacity(size_t capacity);
+
+/**
+ * Remove all tables from the cache used by read_*_data_table to free memory.
+ * Tables that are still in use elsewhere stay valid.
+ */
+void clear_epi_data_cache();
 
 } // namespace mio
 
@@ -712,11 +712,14 @@ using compare_iterators_t = decltype(std::declval<const C&>().begin() != std::de
 /**
  * Is std::true_type if C is a STL compatible container.
  * Is std::false_type otherwise.
+ * Eigen matrices are never considered containers even though newer versions of Eigen
+ * provide begin and end iterators, they are serialized with their shape instead.
  * See https://en.cppreference.com/w/cpp/named_req/Container.
  * @tparam C any type.
  */
 template <class C>
-using is_container = is_expression_valid<details::compare_iterators_t, C>;
+using is_container = conjunction<is_expression_valid<details::compare_iterators_t, C>,
+                                 negation<std::is_base_of<Eigen::EigenBase<C>, C>>>;
 
 /**
  * serialize an STL compatible container.
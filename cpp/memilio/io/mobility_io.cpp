@@ -2,9 +2,13 @@
 #include "memilio/math/eigen.h"
 #include "memilio/utils/logging.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace mio
@@ -37,102 +41,236 @@ IOResult<int> count_lines(const std::string& filename)
     return success(count);
 }
 
-IOResult<Eigen::MatrixXd> read_mobility_formatted(const std::string& filename)
+namespace
 {
-    BOOST_OUTCOME_TRY(num_lines, count_lines(filename));
-
-    if (num_lines == 0) {
-        return success(Eigen::MatrixXd(0, 0));
-    }
-
-    std::fstream file;
-    file.open(filename, std::ios::in);
+/**
+ * read the whole file into memory, so it can be parsed without any further copies.
+ * the returned string is null terminated, as required by the functions of the strto* family.
+ */
+IOResult<std::string> read_file(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         return failure(StatusCode::FileNotFound, filename);
     }
+    auto size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::string content(static_cast<size_t>(size), '\0');
+    file.read(&content[0], size);
+    if (!file) {
+        return failure(StatusCode::UnknownError, "Unknown error reading file " + filename + ".");
+    }
+    return success(std::move(content));
+}
+
+/**
+ * end of the line that starts at p, i.e. the position of the next newline character or the end of the data.
+ */
+const char* find_line_end(const char* p, const char* end)
+{
+    auto line_end = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+    return line_end ? line_end : end;
+}
 
-    Eigen::MatrixXd txt_matrix(num_lines - 1, 3);
-    std::vector<int> ids;
-
-    try {
-        std::string tp;
-        int linenumber = 0;
-        while (getline(file, tp)) {
-            if (linenumber > 0) {
-                auto line = split(tp, '\t');
-                if (line.size() < 5) {
-                    return failure(StatusCode::InvalidFileFormat,
-                                   filename + ":" + std::to_string(linenumber) + ": Not enough entries in line.");
-                }
-                ids.push_back(std::stoi(line[2]));
-                txt_matrix(linenumber - 1, 0) = std::stoi(line[2]);
-                txt_matrix(linenumber - 1, 1) = std::stoi(line[3]);
-                txt_matrix(linenumber - 1, 2) = std::stod(line[4]);
+/**
+ * skip blanks, but not line breaks.
+ */
+const char* skip_blanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * parse a number from the field [p, field_end). 
+ * Leading blanks and trailing characters are ignored like by std::stoi and std::stod.
+ * @return true if the number was parsed successfully.
+ */
+bool parse_field(const char* p, const char* field_end, long& value)
+{
+    p = skip_blanks(p, field_end);
+    char* number_end;
+    value = std::strtol(p, &number_end, 10);
+    return p < field_end && number_end != p && number_end <= field_end;
+}
+bool parse_field(const char* p, const char* field_end, double& value)
+{
+    p = skip_blanks(p, field_end);
+    char* number_end;
+    value = std::strtod(p, &number_end);
+    return p < field_end && number_end != p && number_end <= field_end;
+}
+
+/**
+ * parse formatted mobility data in a single pass.
+ * @return number of regions and entries of the mobility matrix.
+ */
+IOResult<std::pair<Eigen::Index, std::vector<Eigen::Triplet<double>>>>
+parse_mobility_formatted(const std::string& filename)
+{
+    BOOST_OUTCOME_TRY(content, read_file(filename));
+    const char* p   = content.data();
+    const char* end = content.data() + content.size();
+
+    //region ids of each entry
+    std::vector<std::pair<long, long>> entry_ids;
+    std::vector<double> entry_values;
+
+    //skip header
+    p = find_line_end(p, end);
+    p = p < end ? p + 1 : p;
+    for (int linenumber = 1; p < end; ++linenumber) {
+        auto line_end = find_line_end(p, end);
+        auto error    = [&](const std::string& msg) {
+            return failure(StatusCode::InvalidFileFormat, filename + ":" + std::to_string(linenumber) + ": " + msg);
+        };
+
+        //columns from_str to_str from_rs to_rs count_abs, the names of the regions are not used
+        const char* fields[5];
+        fields[0] = p;
+        for (auto i = 1; i < 5; ++i) {
+            auto tab = static_cast<const char*>(std::memchr(fields[i - 1], '\t', size_t(line_end - fields[i - 1])));
+            if (!tab) {
+                return error("Not enough entries in line.");
             }
-            linenumber++;
+            fields[i] = tab + 1;
         }
+        auto field_end = [&](size_t i) {
+            auto tab = static_cast<const char*>(std::memchr(fields[i], '\t', size_t(line_end - fields[i])));
+            return tab ? tab : line_end;
+        };
+
+        long from_id, to_id;
+        double value;
+        if (!parse_field(fields[2], field_end(2), from_id) || !parse_field(fields[3], field_end(3), to_id) ||
+            !parse_field(fields[4], field_end(4), value)) {
+            return error("Invalid entry in line.");
+        }
+        entry_ids.emplace_back(from_id, to_id);
+        entry_values.push_back(value);
+
+        p = line_end < end ? line_end + 1 : line_end;
+    }
+
+    //sorted ids of all regions, index in this list is the index in the matrix
+    std::vector<long> ids;
+    ids.reserve(entry_ids.size());
+    for (auto& entry : entry_ids) {
+        ids.push_back(entry.first);
     }
-    catch (std::runtime_error& ex) {
-        return failure(StatusCode::InvalidFileFormat, filename + ": " + ex.what());
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(entry_ids.size());
+    for (size_t k = 0; k < entry_ids.size(); ++k) {
+        auto row = std::lower_bound(ids.begin(), ids.end(), entry_ids[k].first);
+        auto col = std::lower_bound(ids.begin(), ids.end(), entry_ids[k].second);
+        if (col == ids.end() || *col != entry_ids[k].second) {
+            return failure(StatusCode::InvalidFileFormat,
+                           filename + ": Region " + std::to_string(entry_ids[k].second) +
+                               " is the destination of migration but not the origin of any migration.");
+        }
+        entries.emplace_back(Eigen::Index(row - ids.begin()), Eigen::Index(col - ids.begin()), entry_values[k]);
     }
 
-    sort(ids.begin(), ids.end());
-    std::vector<int>::iterator iter = std::unique(ids.begin(), ids.end());
-    ids.resize(std::distance(ids.begin(), iter));
+    return success(std::make_pair(Eigen::Index(ids.size()), std::move(entries)));
+}
 
-    Eigen::MatrixXd migration = Eigen::MatrixXd::Zero(ids.size(), ids.size());
+/**
+ * parse plain mobility data in a single pass.
+ * @param f function that is called for each entry with row, column and value.
+ * @return size of the mobility matrix.
+ */
+template <class F>
+IOResult<Eigen::Index> parse_mobility_plain(const std::string& filename, F f)
+{
+    BOOST_OUTCOME_TRY(content, read_file(filename));
+    const char* p   = content.data();
+    const char* end = content.data() + content.size();
 
-    for (int k = 0; k < num_lines - 1; k++) {
-        int row_ind = 0;
-        int col_ind = 0;
-        while (txt_matrix(k, 0) != ids[row_ind]) {
-            row_ind++;
+    Eigen::Index num_cols = -1;
+    Eigen::Index i        = 0;
+    for (; p < end; ++i) {
+        auto line_end = find_line_end(p, end);
+        Eigen::Index j = 0;
+        for (p = skip_blanks(p, line_end); p < line_end; p = skip_blanks(p, line_end), ++j) {
+            char* number_end;
+            auto value = std::strtod(p, &number_end);
+            if (number_end == p || number_end > line_end) {
+                return failure(StatusCode::InvalidFileFormat,
+                               filename + ":" + std::to_string(i) + ": Invalid entry in line.");
+            }
+            f(i, j, value);
+            p = number_end;
         }
-        while (txt_matrix(k, 1) != ids[col_ind]) {
-            col_ind++;
+        if (num_cols < 0) {
+            num_cols = j;
         }
-        migration(row_ind, col_ind) = txt_matrix(k, 2);
+        if (j != num_cols) {
+            return failure(StatusCode::InvalidFileFormat, filename + ": Not a square matrix.");
+        }
+        p = line_end < end ? line_end + 1 : line_end;
+    }
+    if (num_cols > 0 && i != num_cols) {
+        return failure(StatusCode::InvalidFileFormat, filename + ": Not a square matrix.");
     }
 
-    return success(migration);
+    return success(i);
 }
 
-IOResult<Eigen::MatrixXd> read_mobility_plain(const std::string& filename)
+/**
+ * keep the last of multiple values for the same entry of a sparse matrix.
+ */
+double keep_last(const double&, const double& b)
 {
-    BOOST_OUTCOME_TRY(num_lines, count_lines(filename));
+    return b;
+}
 
-    if (num_lines == 0) {
-        return success(Eigen::MatrixXd(0, 0));
-    }
+} // namespace
 
-    std::fstream file;
-    file.open(filename, std::ios::in);
-    if (!file.is_open()) {
-        return failure(StatusCode::FileNotFound, filename);
+IOResult<Eigen::MatrixXd> read_mobility_formatted(const std::string& filename)
+{
+    BOOST_OUTCOME_TRY(parsed, parse_mobility_formatted(filename));
+    Eigen::MatrixXd migration = Eigen::MatrixXd::Zero(parsed.first, parsed.first);
+    for (auto& entry : parsed.second) {
+        migration(entry.row(), entry.col()) = entry.value();
     }
+    return success(std::move(migration));
+}
 
-    Eigen::MatrixXd migration(num_lines, num_lines);
+IOResult<Eigen::SparseMatrix<double>> read_mobility_formatted_sparse(const std::string& filename)
+{
+    BOOST_OUTCOME_TRY(parsed, parse_mobility_formatted(filename));
+    Eigen::SparseMatrix<double> migration(parsed.first, parsed.first);
+    migration.setFromTriplets(parsed.second.begin(), parsed.second.end(), &keep_last);
+    return success(std::move(migration));
+}
 
-    try {
-        std::string tp;
-        int linenumber = 0;
-        while (getline(file, tp)) {
-            auto line = split(tp, ' ');
-            if (line.size() != size_t(num_lines)) {
-                return failure(StatusCode::InvalidFileFormat, filename + ": Not a square matrix.");
-            }
-            Eigen::Index i = static_cast<Eigen::Index>(linenumber);
-            for (Eigen::Index j = 0; j < static_cast<Eigen::Index>(line.size()); j++) {
-                migration(i, j) = std::stod(line[j]);
-            }
-            linenumber++;
-        }
-    }
-    catch (std::runtime_error& ex) {
-        return failure(StatusCode::InvalidFileFormat, filename + ": " + ex.what());
-    }
+IOResult<Eigen::MatrixXd> read_mobility_plain(const std::string& filename)
+{
+    std::vector<double> values;
+    BOOST_OUTCOME_TRY(size, parse_mobility_plain(filename, [&values](auto, auto, auto value) {
+                          values.push_back(value);
+                      }));
+    using RowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    Eigen::MatrixXd migration = Eigen::Map<RowMajorMatrix>(values.data(), size, size);
+    return success(std::move(migration));
+}
 
-    return success(migration);
+IOResult<Eigen::SparseMatrix<double>> read_mobility_plain_sparse(const std::string& filename)
+{
+    std::vector<Eigen::Triplet<double>> entries;
+    BOOST_OUTCOME_TRY(size, parse_mobility_plain(filename, [&entries](auto i, auto j, auto value) {
+                          if (value != 0.0) {
+                              entries.emplace_back(i, j, value);
+                          }
+                      }));
+    Eigen::SparseMatrix<double> migration(size, size);
+    migration.setFromTriplets(entries.begin(), entries.end());
+    return success(std::move(migration));
 }
 
 } // namespace mio
@@ -22,10 +22,16 @@
 
 #include "memilio/config.h"
 #include "memilio/math/eigen.h"
+#include "memilio/math/eigen_sparse.h"
 #include "memilio/io/json_serializer.h"
+#include "memilio/io/binary_serializer.h"
 #include "memilio/mobility/mobility.h"
+#include "memilio/utils/transform_iterator.h"
+#include "memilio/utils/parallel_for.h"
 #include <iostream>
 #include <fstream>
+#include <iterator>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -54,6 +60,14 @@ IOResult<int> count_lines(const std::string& filename);
  */
 IOResult<Eigen::MatrixXd> read_mobility_formatted(const std::string& filename);
 
+/**
+ * @brief Reads formatted migration or contact data like read_mobility_formatted
+ *        into a sparse NxN Eigen Matrix, where N is the number of regions.
+ *        Only the entries that are listed in the file are stored.
+ * @param filename name of file to be read
+ */
+IOResult<Eigen::SparseMatrix<double>> read_mobility_formatted_sparse(const std::string& filename);
+
 /**
  * @brief Reads txt migration data or contact which is given by values only
  *        and separated by spaces. Writes it into a NxN Eigen 
@@ -62,6 +76,105 @@ IOResult<Eigen::MatrixXd> read_mobility_formatted(const std::string& filename);
  */
 IOResult<Eigen::MatrixXd> read_mobility_plain(const std::string& filename);
 
+/**
+ * @brief Reads txt migration data or contact like read_mobility_plain
+ *        into a sparse NxN Eigen Matrix, where N is the number of regions.
+ *        Only the entries that are not zero are stored.
+ * @param filename name of file to be read
+ */
+IOResult<Eigen::SparseMatrix<double>> read_mobility_plain_sparse(const std::string& filename);
+
+/**
+ * @brief writes a simulation graph into a single file in binary format.
+ * The file contains the ids and models of all nodes as well as all edges with their parameters.
+ * Contains the same information as the files created by write_graph(), but is much faster to write 
+ * and read and needs less space for large graphs.
+ * @param graph Graph which should be written.
+ * @param filename path of the file.
+ * @param ioflags flags that set the behavior of serialization; see mio::IOFlags
+ */
+template <class Model>
+IOResult<void> write_graph_binary(const Graph<Model, MigrationParameters>& graph, const std::string& filename,
+                                  int ioflags = IOF_None)
+{
+    std::vector<unsigned char> buffer;
+    details::write_binary_header(buffer, ioflags);
+    auto ctxt = BinaryContext(std::make_shared<IOStatus>(), buffer, ioflags);
+    auto obj  = ctxt.create_object("Graph");
+
+    std::vector<int> node_ids;
+    std::vector<uint64_t> start_node_indices, end_node_indices;
+    for (auto& node : graph.nodes()) {
+        node_ids.push_back(node.id);
+    }
+    for (auto& edge : graph.edges()) {
+        start_node_indices.push_back(edge.start_node_idx);
+        end_node_indices.push_back(edge.end_node_idx);
+    }
+    auto get_property = [](auto&& node_or_edge) -> auto& {
+        return node_or_edge.property;
+    };
+    auto nodes = graph.nodes();
+    auto edges = graph.edges();
+    obj.add_list("NodeIds", node_ids.begin(), node_ids.end());
+    obj.add_list("Models", make_transform_iterator(nodes.begin(), get_property),
+                 make_transform_iterator(nodes.end(), get_property));
+    obj.add_list("StartNodeIndices", start_node_indices.begin(), start_node_indices.end());
+    obj.add_list("EndNodeIndices", end_node_indices.begin(), end_node_indices.end());
+    obj.add_list("Parameters", make_transform_iterator(edges.begin(), get_property),
+                 make_transform_iterator(edges.end(), get_property));
+    if (!ctxt.status()) {
+        return failure(ctxt.status());
+    }
+    return write_binary(filename, buffer);
+}
+
+/**
+ * @brief reads a simulation graph from a file in binary format.
+ * See write_graph_binary() for the contents of the file.
+ * @tparam the type of the simulation model.
+ * @param filename path of the file.
+ * @param ioflags flags that set the behavior of serialization, must be the same as during writing; see mio::IOFlags
+ */
+template <class Model>
+IOResult<Graph<Model, MigrationParameters>> read_graph_binary(const std::string& filename, int ioflags = IOF_None)
+{
+    BOOST_OUTCOME_TRY(buffer, read_binary(filename));
+    BOOST_OUTCOME_TRY(offset, details::read_binary_header(buffer, ioflags));
+    auto ctxt = BinaryContext(buffer.data() + offset, buffer.data() + buffer.size(), std::make_shared<IOStatus>(),
+                              ioflags);
+    auto obj  = ctxt.expect_object("Graph");
+    BOOST_OUTCOME_TRY(node_ids, obj.expect_list("NodeIds", Tag<int>{}));
+    BOOST_OUTCOME_TRY(models, obj.expect_list("Models", Tag<Model>{}));
+    BOOST_OUTCOME_TRY(start_node_indices, obj.expect_list("StartNodeIndices", Tag<uint64_t>{}));
+    BOOST_OUTCOME_TRY(end_node_indices, obj.expect_list("EndNodeIndices", Tag<uint64_t>{}));
+    BOOST_OUTCOME_TRY(parameters, obj.expect_list("Parameters", Tag<MigrationParameters>{}));
+    if (node_ids.size() != models.size()) {
+        return failure(StatusCode::InvalidFileFormat, filename + ", number of node ids and models does not match.");
+    }
+    if (start_node_indices.size() != parameters.size() || end_node_indices.size() != parameters.size()) {
+        return failure(StatusCode::InvalidFileFormat, filename + ", number of edge indices and parameters does not match.");
+    }
+
+    std::vector<Node<Model>> nodes;
+    nodes.reserve(models.size());
+    for (size_t inode = 0; inode < models.size(); ++inode) {
+        nodes.emplace_back(node_ids[inode], std::move(models[inode]));
+    }
+    std::vector<Edge<MigrationParameters>> edges;
+    edges.reserve(parameters.size());
+    for (size_t iedge = 0; iedge < parameters.size(); ++iedge) {
+        if (start_node_indices[iedge] >= nodes.size() || end_node_indices[iedge] >= nodes.size()) {
+            log_error("Edge node index not in range of number of graph nodes.");
+            return failure(StatusCode::OutOfRange, filename + ", edge node index not in range of number of graph nodes.");
+        }
+        edges.emplace_back(size_t(start_node_indices[iedge]), size_t(end_node_indices[iedge]),
+                           std::move(parameters[iedge]));
+    }
+    auto graph = Graph<Model, MigrationParameters>(std::move(nodes), std::move(edges));
+    return success(std::move(graph));
+}
+
 #ifdef MEMILIO_HAS_JSONCPP
 
 /**
@@ -138,47 +251,79 @@ IOResult<Graph<Model, MigrationParameters>> read_graph(const std::string& direct
         return failure(StatusCode::FileNotFound, directory);
     }
 
-    auto graph = Graph<Model, MigrationParameters>{};
-
-    //read nodes, as many as files are available
-    for (auto inode = 0;; ++inode) {
-        auto node_filename = path_join(abs_path, "GraphNode" + std::to_string(inode) + ".json");
+    //count nodes, as many as files are available
+    size_t num_nodes = 0;
+    for (;; ++num_nodes) {
+        auto node_filename = path_join(abs_path, "GraphNode" + std::to_string(num_nodes) + ".json");
         if (!file_exists(node_filename, node_filename)) {
             break;
         }
-        BOOST_OUTCOME_TRY(js_node, read_json(node_filename));
-        if (!js_node["NodeId"].isInt()) {
-            log_error("NodeId field must be an integer.");
-            return failure(StatusCode::InvalidType, node_filename + ", NodeId must be an integer.");
-        }
-        auto node_id = js_node["NodeId"].asInt();
-        BOOST_OUTCOME_TRY(model, deserialize_json(js_node["Model"], Tag<Model>{}, ioflags));
-        graph.add_node(node_id, model);
     }
 
-    //read edges; nodes must already be available for that)
-    for (auto inode = size_t(0); inode < graph.nodes().size(); ++inode) {
-        //list of edges
+    //read and deserialize the files of each node concurrently; the files are independent of each other.
+    //results are stored by node index, so the graph is the same as if the files were read sequentially.
+    std::vector<boost::optional<Node<Model>>> nodes(num_nodes);
+    std::vector<std::vector<Edge<MigrationParameters>>> edges(num_nodes);
+    std::vector<IOStatus> errors(num_nodes);
+    parallel_for(num_nodes, [&](size_t inode) {
+        auto node_filename = path_join(abs_path, "GraphNode" + std::to_string(inode) + ".json");
         auto edge_filename = path_join(abs_path, "GraphEdges_node" + std::to_string(inode) + ".json");
-        BOOST_OUTCOME_TRY(js_edges, read_json(edge_filename));
-
-        for (auto& e : js_edges) {
-            auto start_node_idx  = inode;
-            auto js_end_node_idx = e["EndNodeIndex"];
-            if (!js_end_node_idx.isUInt64()) {
-                log_error("EndNodeIndex must be an integer.");
-                return failure(StatusCode::InvalidType, edge_filename + ", EndNodeIndex must be an integer.");
+        auto result        = [&]() -> IOResult<void> {
+            BOOST_OUTCOME_TRY(js_node, read_json(node_filename));
+            if (!js_node["NodeId"].isInt()) {
+                log_error("NodeId field must be an integer.");
+                return failure(StatusCode::InvalidType, node_filename + ", NodeId must be an integer.");
             }
-            auto end_node_idx = js_end_node_idx.asUInt64();
-            if (end_node_idx >= graph.nodes().size()) {
-                log_error("EndNodeIndex not in range of number of graph nodes.");
-                return failure(StatusCode::OutOfRange,
-                               edge_filename + ", EndNodeIndex not in range of number of graph nodes.");
+            auto node_id = js_node["NodeId"].asInt();
+            BOOST_OUTCOME_TRY(model, deserialize_json(js_node["Model"], Tag<Model>{}, ioflags));
+            nodes[inode].emplace(node_id, std::move(model));
+
+            //list of edges
+            BOOST_OUTCOME_TRY(js_edges, read_json(edge_filename));
+            edges[inode].reserve(js_edges.size());
+            for (auto& e : js_edges) {
+                auto js_end_node_idx = e["EndNodeIndex"];
+                if (!js_end_node_idx.isUInt64()) {
+                    log_error("EndNodeIndex must be an integer.");
+                    return failure(StatusCode::InvalidType, edge_filename + ", EndNodeIndex must be an integer.");
+                }
+                auto end_node_idx = js_end_node_idx.asUInt64();
+                if (end_node_idx >= num_nodes) {
+                    log_error("EndNodeIndex not in range of number of graph nodes.");
+                    return failure(StatusCode::OutOfRange,
+                                   edge_filename + ", EndNodeIndex not in range of number of graph nodes.");
+                }
+                BOOST_OUTCOME_TRY(parameters,
+                                  deserialize_json(e["Parameters"], Tag<MigrationParameters>{}, ioflags));
+                edges[inode].emplace_back(inode, size_t(end_node_idx), std::move(parameters));
             }
-            BOOST_OUTCOME_TRY(parameters, deserialize_json(e["Parameters"], Tag<MigrationParameters>{}, ioflags));
-            graph.add_edge(start_node_idx, end_node_idx, parameters);
+            return success();
+        }();
+        if (!result) {
+            errors[inode] = result.error();
         }
+    });
+
+    //report the error of the first node that failed
+    for (auto& error : errors) {
+        if (error.is_error()) {
+            return failure(error);
+        }
+    }
+
+    std::vector<Node<Model>> graph_nodes;
+    graph_nodes.reserve(num_nodes);
+    for (auto& node : nodes) {
+        graph_nodes.emplace_back(std::move(*node));
+    }
+    std::vector<Edge<MigrationParameters>> graph_edges;
+    graph_edges.reserve(std::accumulate(edges.begin(), edges.end(), size_t(0), [](auto n, auto&& node_edges) {
+        return n + node_edges.size();
+    }));
+    for (auto& node_edges : edges) {
+        std::move(node_edges.begin(), node_edges.end(), std::back_inserter(graph_edges));
     }
+    auto graph = Graph<Model, MigrationParameters>(std::move(graph_nodes), std::move(graph_edges));
 
     return success(graph);
 }
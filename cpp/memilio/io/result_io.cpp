@@ -24,6 +24,7 @@
 #include "memilio/io/hdf5_cpp.h"
 #include "memilio/math/eigen_util.h"
 #include "memilio/epidemiology/damping.h"
+#include "memilio/utils/profiling.h"
 
 #include <vector>
 #include <iostream>
@@ -31,9 +32,29 @@
 
 namespace mio
 {
-IOResult<void> save_result(const std::vector<TimeSeries<double>>& results, const std::vector<int>& ids, int num_groups,
-                           const std::string& filename)
+namespace
+{
+/**
+ * native hdf5 type of the values of a result.
+ */
+template <class FP>
+hid_t h5_native_type();
+template <>
+hid_t h5_native_type<double>()
+{
+    return H5T_NATIVE_DOUBLE;
+}
+template <>
+hid_t h5_native_type<float>()
 {
+    return H5T_NATIVE_FLOAT;
+}
+
+template <class FP>
+IOResult<void> save_result_impl(const std::vector<TimeSeries<FP>>& results, const std::vector<int>& ids,
+                                int num_groups, const std::string& filename)
+{
+    MEMILIO_PROFILE_SCOPE("save_result");
     int region_idx = 0;
     H5File file{H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)};
     MEMILIO_H5_CHECK(file.id, StatusCode::FileNotFound, filename);
@@ -56,20 +77,21 @@ IOResult<void> save_result(const std::vector<TimeSeries<double>>& results, const
         MEMILIO_H5_CHECK(H5Dwrite(dset_t.id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values_t.data()),
                          StatusCode::UnknownError, "Time data could not be written.");
 
+        //the total over all groups is accumulated in double precision, hdf5 converts it to the type of the dataset
         auto total = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>::Zero(num_timepoints,
                                                                                                   num_infectionstates)
                          .eval();
 
         for (int group_idx = 0; group_idx <= num_groups; ++group_idx) {
-            auto group = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>::Zero(
-                             num_timepoints, num_infectionstates)
+            auto group = Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>::Zero(num_timepoints,
+                                                                                                  num_infectionstates)
                              .eval();
             if (group_idx < num_groups) {
                 for (Eigen::Index t_idx = 0; t_idx < result.get_num_time_points(); ++t_idx) {
                     auto v           = result[t_idx].transpose().eval();
                     auto group_slice = mio::slice(v, {group_idx * num_infectionstates, num_infectionstates});
                     mio::slice(group, {t_idx, 1}, {0, num_infectionstates}) = group_slice;
-                    mio::slice(total, {t_idx, 1}, {0, num_infectionstates}) += group_slice;
+                    mio::slice(total, {t_idx, 1}, {0, num_infectionstates}) += group_slice.template cast<double>();
                 }
             }
 
@@ -77,18 +99,34 @@ IOResult<void> save_result(const std::vector<TimeSeries<double>>& results, const
             H5DataSpace dspace_values{H5Screate_simple(2, dims_values, NULL)};
             MEMILIO_H5_CHECK(dspace_values.id, StatusCode::UnknownError, "Values DataSpace could not be created.");
             auto dset_name = group_idx == num_groups ? std::string("Total") : "Group" + std::to_string(group_idx + 1);
-            H5DataSet dset_values{H5Dcreate(region_h5group.id, dset_name.c_str(), H5T_NATIVE_DOUBLE, dspace_values.id,
-                                            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)};
+            H5DataSet dset_values{H5Dcreate(region_h5group.id, dset_name.c_str(), h5_native_type<FP>(),
+                                            dspace_values.id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)};
             MEMILIO_H5_CHECK(dset_values.id, StatusCode::UnknownError, "Values DataSet could not be created.");
 
-            MEMILIO_H5_CHECK(H5Dwrite(dset_values.id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
-                                      group_idx == num_groups ? total.data() : group.data()),
-                             StatusCode::UnknownError, "Values data could not be written.");
+            auto write_status = group_idx == num_groups
+                                    ? H5Dwrite(dset_values.id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                                               total.data())
+                                    : H5Dwrite(dset_values.id, h5_native_type<FP>(), H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                                               group.data());
+            MEMILIO_H5_CHECK(write_status, StatusCode::UnknownError, "Values data could not be written.");
         }
         region_idx++;
     }
     return success();
 }
+} // namespace
+
+IOResult<void> save_result(const std::vector<TimeSeries<double>>& results, const std::vector<int>& ids, int num_groups,
+                           const std::string& filename)
+{
+    return save_result_impl(results, ids, num_groups, filename);
+}
+
+IOResult<void> save_result(const std::vector<TimeSeries<float>>& results, const std::vector<int>& ids, int num_groups,
+                           const std::string& filename)
+{
+    return save_result_impl(results, ids, num_groups, filename);
+}
 
 herr_t store_group_name(hid_t /*id*/, const char* name, const H5L_info_t* /*linfo*/, void* opdata)
 {
@@ -99,6 +137,7 @@ herr_t store_group_name(hid_t /*id*/, const char* name, const H5L_info_t* /*linf
 
 IOResult<std::vector<SimulationResult>> read_result(const std::string& filename)
 {
+    MEMILIO_PROFILE_SCOPE("read_result");
     std::vector<SimulationResult> results;
 
     H5File file{H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT)};
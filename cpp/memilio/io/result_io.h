@@ -37,14 +37,20 @@ namespace mio
 
 /**
  * @brief Save the results of a graph simulation run.
+ * Results stored as float are written as single precision values to halve the size of the file,
+ * time points are always written in double precision. Both can be read by read_result.
  * @param result Simulation results per node of the graph.
  * @param ids Identifiers for each node of the graph. 
  * @param num_groups Number of groups in the results.
  * @param filename Name of file
  * @return Any io errors that occur during writing of the files. 
+ * @{
  */
 IOResult<void> save_result(const std::vector<TimeSeries<double>>& result, const std::vector<int>& ids, int num_groups,
                            const std::string& filename);
+IOResult<void> save_result(const std::vector<TimeSeries<float>>& result, const std::vector<int>& ids, int num_groups,
+                           const std::string& filename);
+/** @} */
 
 class SimulationResult
 {
@@ -108,8 +114,8 @@ IOResult<std::vector<SimulationResult>> read_result(const std::string& filename)
  * @param run_idx Index of the run; used in directory name.
  * @return Any io errors that occur during writing of the files.
  */
-template <class Model>
-IOResult<void> save_result_with_params(const std::vector<TimeSeries<double>>& result, const std::vector<Model>& params,
+template <class Model, class FP>
+IOResult<void> save_result_with_params(const std::vector<TimeSeries<FP>>& result, const std::vector<Model>& params,
                                        const std::vector<int>& county_ids, const fs::path& result_dir, size_t run_idx)
 {
     auto result_dir_run = result_dir / ("run" + std::to_string(run_idx));
@@ -132,8 +138,8 @@ IOResult<void> save_result_with_params(const std::vector<TimeSeries<double>>& re
  * @param save_single_runs [Default: true] Defines if percentiles are written to the disk.
  * @return Any io errors that occur during writing of the files.
  */
-template <class Model>
-IOResult<void> save_results(const std::vector<std::vector<TimeSeries<double>>>& ensemble_results,
+template <class Model, class FP>
+IOResult<void> save_results(const std::vector<std::vector<TimeSeries<FP>>>& ensemble_results,
                             const std::vector<std::vector<Model>>& ensemble_params, const std::vector<int>& county_ids,
                             const fs::path& result_dir, bool save_single_runs = true, bool save_percentiles = true)
 {
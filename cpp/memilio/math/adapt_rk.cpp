@@ -73,6 +73,15 @@ Tableau::Tableau()
 bool RKIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
                             Eigen::Ref<Eigen::VectorXd> ytp1) const
 {
+    size_t num_rejected_steps;
+    return step_and_count_rejections(f, yt, t, dt, ytp1, num_rejected_steps);
+}
+
+bool RKIntegratorCore::step_and_count_rejections(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt,
+                                                 double& t, double& dt, Eigen::Ref<Eigen::VectorXd> ytp1,
+                                                 size_t& num_rejected_steps) const
+{
+    num_rejected_steps = 0;
     double t_eval; // shifted time for evaluating yt
     double dt_new; // updated dt
 
@@ -118,7 +127,10 @@ bool RKIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::Vect
             // (higher order is not always higher accuracy)
             t += dt; // this is the t where ytp1 belongs to
         }
-        // else: repeat the calculation above (with updated dt)
+        else {
+            // repeat the calculation above (with updated dt)
+            ++num_rejected_steps;
+        }
 
         // compute new value for dt
         // converged implies eps/error_estimate >= 1, so dt will be increased for the next step
@@ -138,4 +150,63 @@ bool RKIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::Vect
     return !failed_step_size_adapt;
 }
 
+bool BatchRKIntegratorCore::step(const BatchDerivFunction& f, Eigen::Ref<const Eigen::MatrixXd> yt, double& t,
+                                 double& dt, Eigen::Ref<Eigen::MatrixXd> ytp1) const
+{
+    bool converged              = false;
+    bool failed_step_size_adapt = false;
+
+    auto num_stages = size_t(m_tab_final.entries_low.size());
+    if (m_kt_values.size() != num_stages || m_kt_values[0].rows() != yt.rows() ||
+        m_kt_values[0].cols() != yt.cols()) {
+        m_kt_values.assign(num_stages, Eigen::MatrixXd(yt.rows(), yt.cols()));
+    }
+
+    m_yt_eval = yt;
+
+    while (!converged && !failed_step_size_adapt) {
+        f(m_yt_eval, t, m_kt_values[0]);
+
+        for (size_t i = 1; i < num_stages; i++) {
+            // t_eval = t + c_i * h // note: line zero of Butcher tableau not stored in array
+            double t_eval = t + m_tab.entries[i - 1][0] * dt;
+            // use ytp1 as temporary storage for evaluating m_kt_values[i]
+            ytp1 = m_yt_eval;
+            for (Eigen::Index k = 1; k < m_tab.entries[i - 1].size(); k++) {
+                ytp1 += (dt * m_tab.entries[i - 1][k]) * m_kt_values[size_t(k - 1)];
+            }
+            f(ytp1, t_eval, m_kt_values[i]);
+        }
+
+        // low order estimate and truncation error estimate yt_low - yt_high of all systems
+        ytp1             = m_yt_eval;
+        m_error_estimate = Eigen::ArrayXXd::Zero(yt.rows(), yt.cols());
+        for (size_t i = 0; i < num_stages; i++) {
+            ytp1 += (dt * m_tab_final.entries_low[Eigen::Index(i)]) * m_kt_values[i];
+            m_error_estimate +=
+                (m_tab_final.entries_high[Eigen::Index(i)] - m_tab_final.entries_low[Eigen::Index(i)]) *
+                m_kt_values[i].array();
+        }
+        m_error_estimate = dt * m_error_estimate.abs();
+        m_eps            = m_abs_tol + ytp1.array().abs() * m_rel_tol;
+
+        // the step is only accepted if it is accurate enough for every system
+        converged = (m_error_estimate <= m_eps).all();
+        if (converged) {
+            t += dt;
+        }
+
+        // see RKIntegratorCore::step, the system with the largest error determines the step size
+        double dt_new = dt * std::pow((m_eps / m_error_estimate).minCoeff(), (1. / (num_stages - 1)));
+        dt_new *= 0.9;
+        if (m_dt_min < dt_new) {
+            dt = std::min(dt_new, m_dt_max);
+        }
+        else {
+            failed_step_size_adapt = true;
+        }
+    }
+    return !failed_step_size_adapt;
+}
+
 } // namespace mio
@@ -166,6 +166,15 @@ public:
     bool step(const DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
               Eigen::Ref<Eigen::VectorXd> ytp1) const override;
 
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size.
+     * Also counts the trial steps that did not reach the tolerances and were repeated with a smaller step size.
+     * @see IntegratorCore::step_and_count_rejections
+     */
+    bool step_and_count_rejections(const DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t,
+                                   double& dt, Eigen::Ref<Eigen::VectorXd> ytp1,
+                                   size_t& num_rejected_steps) const override;
+
 protected:
     Tableau m_tab;
     TableauFinal m_tab_final;
@@ -178,6 +187,95 @@ private:
     mutable Eigen::ArrayXd m_eps, m_error_estimate; // tolerance and estimate used for time step adaption
 };
 
+/**
+ * @brief Runge-Kutta integrator with adaptive step width for a batch of independent systems of ODEs.
+ *
+ * All systems are integrated in lockstep with the same step size. The step size is adapted so that the error
+ * estimate of every system is within the tolerances. Each step evaluates the right hand side of all systems
+ * together, the stages and error estimates are computed for all systems at once.
+ */
+class BatchRKIntegratorCore
+{
+public:
+    /**
+     * @brief Setting up the integrator
+     */
+    BatchRKIntegratorCore()
+        : m_abs_tol(1e-10)
+        , m_rel_tol(1e-5)
+        , m_dt_min(std::numeric_limits<double>::min())
+        , m_dt_max(std::numeric_limits<double>::max())
+    {
+    }
+
+    /**
+     * @brief Set up the integrator
+     * @param abs_tol absolute tolerance
+     * @param rel_tol relative tolerance 
+     * @param dt_min lower bound for time step dt
+     * @param dt_max upper bound for time step dt
+     */
+    BatchRKIntegratorCore(const double abs_tol, const double rel_tol, const double dt_min, const double dt_max)
+        : m_abs_tol(abs_tol)
+        , m_rel_tol(rel_tol)
+        , m_dt_min(dt_min)
+        , m_dt_max(dt_max)
+    {
+    }
+
+    /// @param tol the required absolute tolerance for the comparison with the Fehlberg approximation
+    void set_abs_tolerance(double tol)
+    {
+        m_abs_tol = tol;
+    }
+
+    /// @param tol the required relative tolerance for the comparison with the Fehlberg approximation
+    void set_rel_tolerance(double tol)
+    {
+        m_rel_tol = tol;
+    }
+
+    /// @param dt_min sets the minimum step size
+    void set_dt_min(double dt_min)
+    {
+        m_dt_min = dt_min;
+    }
+
+    /// @param dt_max sets the maximum step size
+    void set_dt_max(double dt_max)
+    {
+        m_dt_max = dt_max;
+    }
+
+    // Allow setting different RK tablea schemes
+    void set_tableaus(const Tableau& tab, const TableauFinal& final_tab)
+    {
+        m_tab       = tab;
+        m_tab_final = final_tab;
+    }
+
+    /**
+     * @brief Make a single integration step of all systems and adapt the step size
+     * @param[in] f right hand side of all systems
+     * @param[in] yt value of y at t, y(t), one column for each system
+     * @param[in,out] t current time
+     * @param[in,out] dt current time step size h=dt
+     * @param[out] ytp1 approximated value y(t+1), one column for each system
+     * @return false if the step size could not be adapted to the tolerances, true otherwise.
+     */
+    bool step(const BatchDerivFunction& f, Eigen::Ref<const Eigen::MatrixXd> yt, double& t, double& dt,
+              Eigen::Ref<Eigen::MatrixXd> ytp1) const;
+
+private:
+    Tableau m_tab;
+    TableauFinal m_tab_final;
+    double m_abs_tol, m_rel_tol;
+    double m_dt_min, m_dt_max;
+    mutable std::vector<Eigen::MatrixXd> m_kt_values; // one matrix for each stage
+    mutable Eigen::MatrixXd m_yt_eval;
+    mutable Eigen::ArrayXXd m_eps, m_error_estimate; // tolerance and estimate used for time step adaption
+};
+
 } // namespace mio
 
 #endif // ADAPT_RK_H_
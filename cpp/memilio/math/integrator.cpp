@@ -19,12 +19,16 @@
 */
 #include "memilio/math/integrator.h"
 #include "memilio/utils/logging.h"
+#include "memilio/utils/profiling.h"
+
+#include <chrono>
 
 namespace mio
 {
 
 Eigen::Ref<Eigen::VectorXd> OdeIntegrator::advance(double tmax)
 {
+    MEMILIO_PROFILE_SCOPE("OdeIntegrator::advance");
     const double t0 = m_result.get_time(m_result.get_num_time_points() - 1);
     assert(tmax > t0);
 
@@ -32,6 +36,23 @@ Eigen::Ref<Eigen::VectorXd> OdeIntegrator::advance(double tmax)
 
     m_result.reserve(m_result.get_num_time_points() + nb_steps);
 
+    //count the evaluations of the right hand side, time them only if requested
+    DerivFunction f;
+    if (m_rhs_timing) {
+        f = [this](Eigen::Ref<const Eigen::VectorXd> y, double t_eval, Eigen::Ref<Eigen::VectorXd> dydt) {
+            auto start = std::chrono::steady_clock::now();
+            m_f(y, t_eval, dydt);
+            m_statistics.rhs_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++m_statistics.num_rhs_evaluations;
+        };
+    }
+    else {
+        f = [this](Eigen::Ref<const Eigen::VectorXd> y, double t_eval, Eigen::Ref<Eigen::VectorXd> dydt) {
+            m_f(y, t_eval, dydt);
+            ++m_statistics.num_rhs_evaluations;
+        };
+    }
+
     bool step_okay = true;
 
     double t = t0;
@@ -41,10 +62,23 @@ Eigen::Ref<Eigen::VectorXd> OdeIntegrator::advance(double tmax)
         //may not be able to handle it. this is very conservative and maybe unnecessary,
         //but also unlikely to happen. may need to be reevaluated
 
-        auto dt_eff = std::min(m_dt, tmax - t);
+        auto dt_eff         = std::min(m_dt, tmax - t);
+        auto truncated      = dt_eff < m_dt;
+        auto t_old          = t;
+        size_t num_rejected = 0;
         m_result.add_time_point();
-        step_okay &= m_core->step(m_f, m_result[i], t, dt_eff, m_result[i + 1]);
+        step_okay &= m_core->step_and_count_rejections(f, m_result[i], t, dt_eff, m_result[i + 1], num_rejected);
         m_result.get_last_time() = t;
+        MEMILIO_PROFILE_COUNT("integrator steps", 1);
+
+        //the size of steps that were shortened to stop at tmax is not chosen by the step size control
+        m_statistics.num_rejected_steps += num_rejected;
+        if (!truncated || num_rejected > 0) {
+            m_statistics.add_accepted_step(t - t_old);
+        }
+        else {
+            ++m_statistics.num_accepted_steps;
+        }
 
         ++i;
 
@@ -62,7 +96,8 @@ Eigen::Ref<Eigen::VectorXd> OdeIntegrator::advance(double tmax)
         log_warning("Last time step too small. Could not reach tmax exactly.");
     }
     else {
-        log_info("Adaptive step sizing successful to tolerances.");
+        //logged for every node in every step of a graph simulation, so only for debugging
+        log_debug("Adaptive step sizing successful to tolerances.");
     }
 
     return m_result.get_last_value();
@@ -20,6 +20,7 @@
 #ifndef INTEGRATOR_H
 #define INTEGRATOR_H
 
+#include "memilio/config.h"
 #include "memilio/utils/time_series.h"
 
 #include "memilio/math/eigen.h"
@@ -27,6 +28,9 @@
 #include <vector>
 #include <functional>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 
 namespace mio
 {
@@ -37,6 +41,87 @@ namespace mio
 using DerivFunction =
     std::function<void(Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::VectorXd> dydt)>;
 
+/**
+ * Function template to be integrated for a batch of independent systems of equal size.
+ * Each column of y and dydt belongs to one system.
+ */
+using BatchDerivFunction =
+    std::function<void(Eigen::Ref<const Eigen::MatrixXd> y, double t, Eigen::Ref<Eigen::MatrixXd> dydt)>;
+
+/**
+ * Function that computes the jacobian df/dy of a function f(y, t) that is integrated, e.g. for implicit methods.
+ */
+using JacobianFunction =
+    std::function<void(Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::MatrixXd> jac)>;
+
+/**
+ * @brief statistics of the integration of an ODE, e.g., to find out which simulations make the step size control
+ * reduce the step size a lot, to tune tolerances or to detect stiffness.
+ * Statistics of multiple integrations, e.g., of all nodes of a graph, can be combined with operator+=.
+ */
+struct IntegratorStatistics {
+    /**
+     * number of buckets of the histogram of step sizes.
+     */
+    static constexpr size_t num_dt_buckets = 9;
+
+    size_t num_rhs_evaluations = 0; ///< number of evaluations of the right hand side.
+    size_t num_accepted_steps  = 0; ///< number of steps that were accepted.
+    size_t num_rejected_steps  = 0; ///< number of trial steps that were rejected by the step size control.
+    double min_dt              = std::numeric_limits<double>::infinity(); ///< smallest accepted step size.
+    double max_dt              = 0.0; ///< largest accepted step size.
+    double rhs_time            = 0.0; ///< time spent in the right hand side in seconds, if measured.
+    /**
+     * number of accepted steps by step size, see get_dt_bucket.
+     */
+    std::array<size_t, num_dt_buckets> dt_histogram = {};
+
+    /**
+     * @brief bucket of the histogram that contains a step size.
+     * Buckets are decades, bucket 0 contains steps smaller than 1e-5, bucket 1 steps in [1e-5, 1e-4), etc.,
+     * and the last bucket steps of at least 100.
+     * @param dt step size.
+     * @return index of the bucket.
+     */
+    static size_t get_dt_bucket(double dt)
+    {
+        if (!(dt >= 1e-5)) {
+            return 0;
+        }
+        auto bucket = std::floor(std::log10(dt)) + 6;
+        return std::min(size_t(bucket), num_dt_buckets - 1);
+    }
+
+    /**
+     * @brief record an accepted step that was chosen by the step size control.
+     * @param dt size of the step.
+     */
+    void add_accepted_step(double dt)
+    {
+        ++num_accepted_steps;
+        min_dt = std::min(min_dt, dt);
+        max_dt = std::max(max_dt, dt);
+        ++dt_histogram[get_dt_bucket(dt)];
+    }
+
+    /**
+     * @brief combine the statistics of another integration with these.
+     */
+    IntegratorStatistics& operator+=(const IntegratorStatistics& other)
+    {
+        num_rhs_evaluations += other.num_rhs_evaluations;
+        num_accepted_steps += other.num_accepted_steps;
+        num_rejected_steps += other.num_rejected_steps;
+        min_dt = std::min(min_dt, other.min_dt);
+        max_dt = std::max(max_dt, other.max_dt);
+        rhs_time += other.rhs_time;
+        for (size_t i = 0; i < num_dt_buckets; ++i) {
+            dt_histogram[i] += other.dt_histogram[i];
+        }
+        return *this;
+    }
+};
+
 class IntegratorCore
 {
 public:
@@ -53,6 +138,25 @@ public:
      */
     virtual bool step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
                       Eigen::Ref<Eigen::VectorXd> ytp1) const = 0;
+
+    /**
+     * @brief Step of the integration that also counts the trial steps that were rejected by the step size control.
+     * The default implementation calls step and doesn't reject any steps, integrators with step size control
+     * should override it.
+     * @param[in] f Right hand side of ODE
+     * @param[in] yt value of y at t, y(t)
+     * @param[in,out] t current time step h=dt
+     * @param[in,out] dt current time step h=dt
+     * @param[out] ytp1 approximated value y(t+1)
+     * @param[out] num_rejected_steps number of trial steps that were rejected.
+     */
+    virtual bool step_and_count_rejections(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t,
+                                           double& dt, Eigen::Ref<Eigen::VectorXd> ytp1,
+                                           size_t& num_rejected_steps) const
+    {
+        num_rejected_steps = 0;
+        return step(f, yt, t, dt, ytp1);
+    }
 };
 
 /**
@@ -99,11 +203,46 @@ public:
         m_core = integrator;
     }
 
+    /**
+     * @brief statistics of all integration steps since the integrator was created or the statistics were reset.
+     * Steps that were shortened to stop exactly at the end point of advance are counted as accepted steps,
+     * but their size is not recorded, unless the step size control reduced it further.
+     */
+    const IntegratorStatistics& get_statistics() const
+    {
+        return m_statistics;
+    }
+
+    /**
+     * @brief reset the statistics, e.g., to collect statistics of a part of the integration.
+     */
+    void reset_statistics()
+    {
+        m_statistics = IntegratorStatistics();
+    }
+
+    /**
+     * @brief measure the time spent evaluating the right hand side, see IntegratorStatistics::rhs_time.
+     * Reading the clock for every evaluation can take as long as the evaluation of small models, so the time is
+     * only measured if enabled here or if the library is built with MEMILIO_ENABLE_PROFILING.
+     * @param enable true to measure the time.
+     */
+    void set_rhs_timing(bool enable)
+    {
+        m_rhs_timing = enable;
+    }
+
 private:
     DerivFunction m_f;
     TimeSeries<double> m_result;
     double m_dt;
     std::shared_ptr<IntegratorCore> m_core;
+    IntegratorStatistics m_statistics;
+#ifdef MEMILIO_ENABLE_PROFILING
+    bool m_rhs_timing = true;
+#else
+    bool m_rhs_timing = false;
+#endif
 };
 
 } // namespace mio
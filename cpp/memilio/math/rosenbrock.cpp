@@ -0,0 +1,173 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/math/rosenbrock.h"
+
+#include <Eigen/LU>
+#include <cmath>
+
+namespace mio
+{
+
+std::vector<std::vector<Eigen::Index>> color_jacobian_columns(const Eigen::SparseMatrix<double>& pattern)
+{
+    std::vector<std::vector<Eigen::Index>> colors;
+    std::vector<std::vector<bool>> rows_of_color;
+    for (Eigen::Index col = 0; col < pattern.outerSize(); ++col) {
+        //find the first color where none of the rows of this column are used yet
+        size_t color = 0;
+        for (; color < colors.size(); ++color) {
+            auto is_free = true;
+            for (Eigen::SparseMatrix<double>::InnerIterator it(pattern, col); it; ++it) {
+                if (rows_of_color[color][size_t(it.row())]) {
+                    is_free = false;
+                    break;
+                }
+            }
+            if (is_free) {
+                break;
+            }
+        }
+        if (color == colors.size()) {
+            colors.emplace_back();
+            rows_of_color.emplace_back(size_t(pattern.rows()), false);
+        }
+        colors[color].push_back(col);
+        for (Eigen::SparseMatrix<double>::InnerIterator it(pattern, col); it; ++it) {
+            rows_of_color[color][size_t(it.row())] = true;
+        }
+    }
+    return colors;
+}
+
+void RosenbrockIntegratorCore::finite_difference_jacobian(const DerivFunction& f,
+                                                          Eigen::Ref<const Eigen::VectorXd> yt, double t) const
+{
+    const auto sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+    auto delta          = [&](Eigen::Index col) {
+        return sqrt_eps * std::max(std::abs(yt[col]), 1.0);
+    };
+
+    m_y_eval = yt;
+    if (m_column_colors.empty()) {
+        //dense, one evaluation for each column
+        for (Eigen::Index col = 0; col < yt.size(); ++col) {
+            auto h        = delta(col);
+            m_y_eval[col] = yt[col] + h;
+            f(m_y_eval, t, m_f1);
+            m_jac.col(col) = (m_f1 - m_f0) / h;
+            m_y_eval[col]  = yt[col];
+        }
+    }
+    else {
+        //sparse, one evaluation for each group of columns that don't share any rows
+        m_jac.setZero();
+        for (auto&& columns : m_column_colors) {
+            for (auto col : columns) {
+                m_y_eval[col] = yt[col] + delta(col);
+            }
+            f(m_y_eval, t, m_f1);
+            for (auto col : columns) {
+                auto h = m_y_eval[col] - yt[col];
+                for (Eigen::SparseMatrix<double>::InnerIterator it(m_pattern, col); it; ++it) {
+                    m_jac(it.row(), col) = (m_f1[it.row()] - m_f0[it.row()]) / h;
+                }
+                m_y_eval[col] = yt[col];
+            }
+        }
+    }
+}
+
+bool RosenbrockIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t,
+                                    double& dt, Eigen::Ref<Eigen::VectorXd> ytp1) const
+{
+    size_t num_rejected_steps;
+    return step_and_count_rejections(f, yt, t, dt, ytp1, num_rejected_steps);
+}
+
+bool RosenbrockIntegratorCore::step_and_count_rejections(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt,
+                                                         double& t, double& dt, Eigen::Ref<Eigen::VectorXd> ytp1,
+                                                         size_t& num_rejected_steps) const
+{
+    num_rejected_steps = 0;
+    const auto d   = 1.0 / (2.0 + std::sqrt(2.0));
+    const auto e32 = 6.0 + std::sqrt(2.0);
+    const auto n   = yt.size();
+
+    if (m_jac.rows() != n) {
+        m_jac.resize(n, n);
+        for (auto v : {&m_f0, &m_f1, &m_f2, &m_dfdt, &m_k1, &m_k2, &m_k3, &m_y_eval}) {
+            v->resize(n);
+        }
+    }
+
+    //jacobian and time derivative of the right hand side only need to be computed once per step
+    f(yt, t, m_f0);
+    if (m_jacobian) {
+        m_jacobian(yt, t, m_jac);
+    }
+    else {
+        finite_difference_jacobian(f, yt, t);
+    }
+    auto dt_fd = std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(std::abs(t), 1.0);
+    f(yt, t + dt_fd, m_dfdt);
+    m_dfdt = (m_dfdt - m_f0) / dt_fd;
+
+    bool converged              = false;
+    bool failed_step_size_adapt = false;
+    while (!converged && !failed_step_size_adapt) {
+        m_w = -dt * d * m_jac;
+        m_w.diagonal().array() += 1.0;
+        Eigen::PartialPivLU<Eigen::MatrixXd> lu(m_w);
+
+        m_k1     = lu.solve(m_f0 + dt * d * m_dfdt);
+        m_y_eval = yt + 0.5 * dt * m_k1;
+        f(m_y_eval, t + 0.5 * dt, m_f1);
+        m_k2 = lu.solve(m_f1 - m_k1) + m_k1;
+        ytp1 = yt + dt * m_k2;
+        f(ytp1, t + dt, m_f2);
+        m_k3 = lu.solve(m_f2 - e32 * (m_k2 - m_f1) - 2.0 * (m_k1 - m_f0) + dt * d * m_dfdt);
+
+        m_error_estimate = (dt / 6.0) * (m_k1 - 2.0 * m_k2 + m_k3).array().abs();
+        m_eps            = m_abs_tol + ytp1.array().abs() * m_rel_tol;
+
+        converged = (m_error_estimate <= m_eps).all();
+
+        //the method is of second order, so the error estimate is O(h^3)
+        //step increase is limited, the jacobian may change a lot in large steps
+        auto dt_new = 0.9 * dt * std::pow((m_eps / m_error_estimate).minCoeff(), 1. / 3.);
+        dt_new      = std::min(dt_new, 5 * dt);
+        if (!converged && dt_new <= m_dt_min) {
+            //tolerances can't be reached, accept the step so the integration doesn't stall
+            failed_step_size_adapt = true;
+        }
+        if (converged || failed_step_size_adapt) {
+            t += dt;
+        }
+        else {
+            ++num_rejected_steps;
+        }
+        if (m_dt_min < dt_new) {
+            dt = std::min(dt_new, m_dt_max);
+        }
+    }
+    return !failed_step_size_adapt;
+}
+
+} // namespace mio
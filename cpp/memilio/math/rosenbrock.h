@@ -0,0 +1,177 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_MATH_ROSENBROCK_H
+#define MIO_MATH_ROSENBROCK_H
+
+#include "memilio/math/integrator.h"
+#include "memilio/math/eigen_sparse.h"
+
+#include <limits>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * @brief group the columns of a sparse matrix so that no two columns in the same group have a nonzero in the same row.
+ * Columns in the same group can be approximated together by finite differences with one evaluation of the
+ * function, so a jacobian with this sparsity pattern only needs one evaluation per group.
+ * Uses a greedy algorithm, the number of groups is not necessarily minimal.
+ * @param pattern sparsity pattern of a jacobian, nonzero entries of the jacobian must be stored entries.
+ * @return the indices of the columns in each group.
+ */
+std::vector<std::vector<Eigen::Index>> color_jacobian_columns(const Eigen::SparseMatrix<double>& pattern);
+
+/**
+ * @brief Rosenbrock integrator with adaptive step width for stiff ODEs y'(t) = f(t,y).
+ *
+ * Implements the L-stable second order Rosenbrock method with third order error estimate by Shampine and Reichelt
+ * (The MATLAB ODE Suite, 1997) that is also used in MATLAB's ode23s. Each step solves three linear systems with
+ * the matrix W = I - h*d*J, where J is the jacobian of f with respect to y, d = 1/(2 + sqrt(2)).
+ * The step size is not limited by the stability of the method, only by the accuracy, so stiff systems,
+ * e.g. with fast transitions, can be integrated with much larger steps than with explicit Runge-Kutta methods.
+ * The jacobian is either computed by a user defined function or approximated by finite differences.
+ * If the sparsity pattern of the jacobian is known, finite differences need fewer evaluations of f.
+ */
+class RosenbrockIntegratorCore : public IntegratorCore
+{
+public:
+    /**
+     * @brief Setting up the integrator
+     */
+    RosenbrockIntegratorCore()
+        : m_abs_tol(1e-10)
+        , m_rel_tol(1e-5)
+        , m_dt_min(std::numeric_limits<double>::min())
+        , m_dt_max(std::numeric_limits<double>::max())
+    {
+    }
+
+    /**
+     * @brief Set up the integrator
+     * @param abs_tol absolute tolerance
+     * @param rel_tol relative tolerance 
+     * @param dt_min lower bound for time step dt
+     * @param dt_max upper bound for time step dt
+     */
+    RosenbrockIntegratorCore(const double abs_tol, const double rel_tol, const double dt_min, const double dt_max)
+        : m_abs_tol(abs_tol)
+        , m_rel_tol(rel_tol)
+        , m_dt_min(dt_min)
+        , m_dt_max(dt_max)
+    {
+    }
+
+    /// @param tol the required absolute tolerance for the error estimate
+    void set_abs_tolerance(double tol)
+    {
+        m_abs_tol = tol;
+    }
+
+    /// @param tol the required relative tolerance for the error estimate
+    void set_rel_tolerance(double tol)
+    {
+        m_rel_tol = tol;
+    }
+
+    /// @param dt_min sets the minimum step size
+    void set_dt_min(double dt_min)
+    {
+        m_dt_min = dt_min;
+    }
+
+    /// @param dt_max sets the maximum step size
+    void set_dt_max(double dt_max)
+    {
+        m_dt_max = dt_max;
+    }
+
+    /**
+     * @brief set a function that computes the jacobian of the right hand side.
+     * The function must compute the jacobian of the same right hand side that is integrated.
+     * If not set, the jacobian is approximated by finite differences.
+     * @param jacobian function that computes the jacobian, may be empty.
+     */
+    void set_jacobian(JacobianFunction jacobian)
+    {
+        m_jacobian = std::move(jacobian);
+    }
+
+    /**
+     * @brief set the sparsity pattern of the jacobian for finite differences.
+     * The columns of the jacobian are colored so that finite differences need only one evaluation of the right hand
+     * side for each color instead of for each column. Not used if a function for the jacobian is set.
+     * @param pattern sparsity pattern of the jacobian, all nonzero entries must be stored entries.
+     */
+    void set_jacobian_sparsity(const Eigen::SparseMatrix<double>& pattern)
+    {
+        m_pattern       = pattern;
+        m_column_colors = color_jacobian_columns(m_pattern);
+    }
+
+    /**
+     * @brief number of evaluations of the right hand side for one approximation of the jacobian by finite differences.
+     * @param num_equations number of equations of the system.
+     */
+    size_t get_num_jacobian_evaluations(Eigen::Index num_equations) const
+    {
+        return m_column_colors.empty() ? size_t(num_equations) : m_column_colors.size();
+    }
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size
+     * @param[in] f right hand side of the ODE
+     * @param[in] yt value of y at t, y(t)
+     * @param[in,out] t current time
+     * @param[in,out] dt current time step size h=dt
+     * @param[out] ytp1 approximated value y(t+1)
+     * @return false if the step size could not be adapted to the tolerances, true otherwise.
+     */
+    bool step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
+              Eigen::Ref<Eigen::VectorXd> ytp1) const override;
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size.
+     * Also counts the trial steps that did not reach the tolerances and were repeated with a smaller step size.
+     * @see IntegratorCore::step_and_count_rejections
+     */
+    bool step_and_count_rejections(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t,
+                                   double& dt, Eigen::Ref<Eigen::VectorXd> ytp1,
+                                   size_t& num_rejected_steps) const override;
+
+private:
+    /**
+     * @brief approximate the jacobian at (yt, t) by finite differences, m_f0 must contain f(yt, t).
+     */
+    void finite_difference_jacobian(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double t) const;
+
+    double m_abs_tol, m_rel_tol;
+    double m_dt_min, m_dt_max;
+    JacobianFunction m_jacobian;
+    Eigen::SparseMatrix<double> m_pattern;
+    std::vector<std::vector<Eigen::Index>> m_column_colors;
+    mutable Eigen::MatrixXd m_jac, m_w;
+    mutable Eigen::VectorXd m_f0, m_f1, m_f2, m_dfdt, m_k1, m_k2, m_k3, m_y_eval;
+    mutable Eigen::ArrayXd m_eps, m_error_estimate; // tolerance and estimate used for time step adaption
+};
+
+} // namespace mio
+
+#endif // MIO_MATH_ROSENBROCK_H
@@ -79,6 +79,21 @@ public:
     bool step(const mio::DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
               Eigen::Ref<Eigen::VectorXd> ytp1) const override
     {
+        size_t num_rejected_steps;
+        return step_and_count_rejections(f, yt, t, dt, ytp1, num_rejected_steps);
+    }
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt step width.
+     * Also counts the trial steps that did not reach the tolerances and were repeated with a smaller step size.
+     * @see IntegratorCore::step_and_count_rejections
+     */
+    bool step_and_count_rejections(const mio::DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t,
+                                   double& dt, Eigen::Ref<Eigen::VectorXd> ytp1,
+                                   size_t& num_rejected_steps) const override
+    {
+        num_rejected_steps = 0;
+
         // copy y(t) to dydt, to retrieve the VectorXd from the Ref
         dydt               = yt;
         const double t_old = t; // t is updated by try_step on a successfull step
@@ -92,6 +107,9 @@ public:
                     f(x, s, dxds);
                 },
                 dydt, t, dt);
+            if (t == t_old) {
+                ++num_rejected_steps;
+            }
             // stop on a successfull step or a failed step size adaption (w.r.t. the minimal step size)
         } while (t == t_old && dt > m_dt_min);
         ytp1 = dydt; // output new y(t)
@@ -0,0 +1,304 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_MOBILITY_COUPLED_MIGRATION_H
+#define MIO_MOBILITY_COUPLED_MIGRATION_H
+
+#include "memilio/mobility/graph.h"
+#include "memilio/mobility/mobility.h"
+#include "memilio/compartments/compartmentalmodel.h"
+#include "memilio/math/integrator.h"
+#include "memilio/math/stepper_wrapper.h"
+#include "memilio/utils/parallel_for.h"
+#include "memilio/utils/stl_util.h"
+#include "memilio/utils/time_series.h"
+
+#include <cassert>
+#include <memory>
+
+namespace mio
+{
+
+/**
+ * @brief Simulation of a migration graph as one coupled system of ODEs.
+ * Alternative to the operator splitting of make_migration_sim, where nodes are integrated separately
+ * and migration is applied between the integration steps.
+ *
+ * The state of the system consists of the residents of each node that are at home
+ * and the commuters of each edge that are currently in the end node of the edge.
+ * Commuters undergo the dynamics of the model of the node they are in, together with the residents of that node.
+ * The coefficients of an edge are the fraction of the residents in each compartment that commute per day,
+ * commuters return after the commute duration on average. Migration is continuous instead of at fixed times,
+ * so the step size is only determined by the accuracy of the integrator.
+ * All models must have the same number of compartments. The right hand side of the ODE has to be linear in the
+ * state y for a fixed total population, i.e. it must be possible to integrate subpopulations of a node separately.
+ * Dynamic NPIs on edges, migration factors and testing of commuters are not supported.
+ * @tparam M a CompartmentModel type.
+ */
+template <class M>
+class CoupledMigrationSimulation
+{
+    static_assert(is_compartment_model<M>::value, "Template parameter must be a compartment model.");
+
+public:
+    using Model = M;
+
+    /**
+     * @brief setup the simulation.
+     * @param graph graph of models and migration parameters.
+     * @param t0 start time.
+     * @param dt initial step size of integration.
+     * @param commute_duration average time that commuters stay in the end node of an edge, in days.
+     */
+    CoupledMigrationSimulation(Graph<Model, MigrationParameters> graph, double t0 = 0., double dt = 0.1,
+                               double commute_duration = 0.5)
+        : m_graph(std::move(graph))
+        , m_commute_duration(commute_duration)
+        , m_thread_pool(std::make_unique<ThreadPool>(1))
+        , m_integrator_core(
+              std::make_shared<ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>>())
+        , m_integrator(
+              [this](auto&& y, auto&& t, auto&& dydt) {
+                  eval_right_hand_side(y, t, dydt);
+              },
+              t0, get_initial_values(), dt, m_integrator_core)
+    {
+        assert(commute_duration > 0);
+        //compute the edge offsets of the graph before they are accessed by multiple threads
+        m_graph.out_edge_offsets();
+    }
+
+    //the integrator refers to this object
+    CoupledMigrationSimulation(const CoupledMigrationSimulation&) = delete;
+    CoupledMigrationSimulation& operator=(const CoupledMigrationSimulation&) = delete;
+
+    /**
+     * @brief set the core integrator used in the simulation.
+     */
+    void set_integrator(std::shared_ptr<IntegratorCore> integrator)
+    {
+        m_integrator_core = std::move(integrator);
+        m_integrator.set_integrator(m_integrator_core);
+    }
+
+    /**
+     * @brief get the core integrator used in the simulation.
+     * @{
+     */
+    IntegratorCore& get_integrator()
+    {
+        return *m_integrator_core;
+    }
+    const IntegratorCore& get_integrator() const
+    {
+        return *m_integrator_core;
+    }
+    /**@}*/
+
+    /**
+     * @brief set the number of threads that evaluate the nodes in the right hand side.
+     * More than one thread is only worth it if the graph is large or the models are expensive.
+     * The models must be safe to evaluate concurrently, i.e. no two nodes may share mutable state.
+     * The threads are started here and reused in every evaluation of the right hand side.
+     * @param num_threads number of threads, including the thread that advances the simulation, default 1.
+     */
+    void set_num_threads(size_t num_threads)
+    {
+        num_threads = std::max(num_threads, size_t(1));
+        if (num_threads != m_thread_pool->get_num_threads()) {
+            m_thread_pool = std::make_unique<ThreadPool>(num_threads);
+        }
+    }
+
+    /**
+     * @brief get the number of threads that evaluate the nodes in the right hand side.
+     */
+    size_t get_num_threads() const
+    {
+        return m_thread_pool->get_num_threads();
+    }
+
+    /**
+     * @brief advance the simulation to tmax.
+     * @param tmax next stopping point of the simulation, must be greater than the current time.
+     * @return the current state of the whole system.
+     */
+    Eigen::Ref<Eigen::VectorXd> advance(double tmax)
+    {
+        return m_integrator.advance(tmax);
+    }
+
+    /**
+     * @brief the result of the whole system.
+     * The state is ordered by the residents at home of each node, followed by the commuters of each edge,
+     * in the order of nodes and edges in the graph.
+     * @{
+     */
+    TimeSeries<ScalarType>& get_result()
+    {
+        return m_integrator.get_result();
+    }
+    const TimeSeries<ScalarType>& get_result() const
+    {
+        return m_integrator.get_result();
+    }
+    /**@}*/
+
+    /**
+     * @brief the population that lives in a node, whether at home or commuting.
+     * Corresponds to the result of a node in make_migration_sim after the commuters have returned.
+     * @param node_idx index of the node.
+     * @return TimeSeries with the same time points as the result of the whole system.
+     */
+    TimeSeries<ScalarType> get_node_result(size_t node_idx) const
+    {
+        auto& result = get_result();
+        TimeSeries<ScalarType> node_result(m_num_compartments);
+        node_result.reserve(result.get_num_time_points());
+        for (Eigen::Index i = 0; i < result.get_num_time_points(); ++i) {
+            auto value = node_result.add_time_point(result.get_time(i));
+            value      = get_node_state(result[i], node_idx);
+            for (auto edge_idx = m_graph.out_edge_offsets()[node_idx];
+                 edge_idx < m_graph.out_edge_offsets()[node_idx + 1]; ++edge_idx) {
+                value += get_edge_state(result[i], edge_idx);
+            }
+        }
+        return node_result;
+    }
+
+    /**
+     * @brief the graph of models and migration parameters.
+     * Changes to the models or parameters affect the simulation from the current time.
+     * Nodes and edges must not be added or removed.
+     * @{
+     */
+    Graph<Model, MigrationParameters>& get_graph()
+    {
+        return m_graph;
+    }
+    const Graph<Model, MigrationParameters>& get_graph() const
+    {
+        return m_graph;
+    }
+    /**@}*/
+
+    /**
+     * @brief evaluate the right hand side of the coupled system.
+     * @param y current state of the system.
+     * @param t current time.
+     * @param dydt derivative of the state.
+     */
+    void eval_right_hand_side(Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::VectorXd> dydt)
+    {
+        auto num_nodes = m_graph.nodes().size();
+
+        //dynamics in each node, of residents and commuters together
+        m_thread_pool->parallel_for(
+            num_nodes,
+            [&](size_t node_idx) {
+                auto& model    = m_graph.nodes()[node_idx].property;
+                auto total_pop = m_total_pop.col(Eigen::Index(node_idx));
+                total_pop      = get_node_state(y, node_idx);
+                for (auto&& edge_idx : in_edge_indices(node_idx)) {
+                    total_pop += get_edge_state(y, edge_idx);
+                }
+                model.eval_right_hand_side(total_pop, get_node_state(y, node_idx), t, get_node_state(dydt, node_idx));
+                for (auto&& edge_idx : in_edge_indices(node_idx)) {
+                    model.eval_right_hand_side(total_pop, get_edge_state(y, edge_idx), t,
+                                               get_edge_state(dydt, edge_idx));
+                }
+            });
+
+        //commuting from each node to other nodes and back
+        m_thread_pool->parallel_for(
+            num_nodes,
+            [&](size_t node_idx) {
+                auto residents   = get_node_state(y, node_idx);
+                auto d_residents = get_node_state(dydt, node_idx);
+                for (auto edge_idx = m_graph.out_edge_offsets()[node_idx];
+                     edge_idx < m_graph.out_edge_offsets()[node_idx + 1]; ++edge_idx) {
+                    auto& coeffs   = m_graph.edges()[edge_idx].property.get_coefficients();
+                    auto commuters = get_edge_state(y, edge_idx);
+                    auto flow      = m_flows.col(Eigen::Index(edge_idx));
+                    flow           = (coeffs.get_matrix_at(t).array() * residents.array()).matrix() -
+                           commuters / m_commute_duration;
+                    d_residents -= flow;
+                    get_edge_state(dydt, edge_idx) += flow;
+                }
+            });
+    }
+
+private:
+    Eigen::VectorXd get_initial_values()
+    {
+        assert(m_graph.nodes().size() > 0);
+        m_num_compartments = m_graph.nodes()[0].property.get_initial_values().size();
+        auto num_nodes     = Eigen::Index(m_graph.nodes().size());
+        auto num_edges     = Eigen::Index(m_graph.edges().size());
+        m_total_pop.resize(m_num_compartments, num_nodes);
+        m_flows.resize(m_num_compartments, num_edges);
+
+        //no one is commuting at the start
+        Eigen::VectorXd y0 = Eigen::VectorXd::Zero((num_nodes + num_edges) * m_num_compartments);
+        for (size_t node_idx = 0; node_idx < m_graph.nodes().size(); ++node_idx) {
+            auto node_y0 = m_graph.nodes()[node_idx].property.get_initial_values();
+            assert(node_y0.size() == m_num_compartments && "All models must have the same number of compartments.");
+            get_node_state(y0, node_idx) = node_y0;
+        }
+        for (auto&& edge : m_graph.edges()) {
+            unused(edge);
+            assert(edge.property.get_coefficients().get_shape().rows() == m_num_compartments &&
+                   "Migration coefficients must have the same size as the models.");
+        }
+        return y0;
+    }
+
+    template <class V>
+    auto get_node_state(V&& y, size_t node_idx) const
+    {
+        return y.segment(Eigen::Index(node_idx) * m_num_compartments, m_num_compartments);
+    }
+
+    template <class V>
+    auto get_edge_state(V&& y, size_t edge_idx) const
+    {
+        return y.segment((Eigen::Index(m_graph.nodes().size()) + Eigen::Index(edge_idx)) * m_num_compartments,
+                         m_num_compartments);
+    }
+
+    auto in_edge_indices(size_t node_idx) const
+    {
+        auto& indices = m_graph.in_edge_indices();
+        auto& offsets = m_graph.in_edge_offsets();
+        return make_range(indices.begin() + offsets[node_idx], indices.begin() + offsets[node_idx + 1]);
+    }
+
+    Graph<Model, MigrationParameters> m_graph;
+    double m_commute_duration;
+    std::unique_ptr<ThreadPool> m_thread_pool;
+    Eigen::Index m_num_compartments;
+    Eigen::MatrixXd m_total_pop; //one column for each node
+    Eigen::MatrixXd m_flows; //one column for each edge
+    std::shared_ptr<IntegratorCore> m_integrator_core;
+    OdeIntegrator m_integrator;
+};
+
+} // namespace mio
+
+#endif // MIO_MOBILITY_COUPLED_MIGRATION_H
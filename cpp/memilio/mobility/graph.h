@@ -22,7 +22,12 @@
 
 #include <functional>
 #include "memilio/utils/stl_util.h"
+#include "memilio/utils/transform_iterator.h"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <numeric>
+#include <vector>
 
 namespace mio
 {
@@ -130,6 +135,9 @@ std::enable_if_t<!has_ostream_op<T>::value, std::ostream&> operator<<(std::ostre
 
 /**
  * @brief generic graph structure
+ * After nodes or edges are added one by one, the offsets of the out and in edges are computed by the next
+ * access to them, which is not thread safe. Access them once, e.g. using out_edge_offsets(), before the
+ * graph is shared between threads.
  */
 template <class NodePropertyT, class EdgePropertyT>
 class Graph
@@ -141,6 +149,27 @@ public:
     using NodeProperty = NodePropertyT;
     using EdgeProperty = EdgePropertyT;
 
+    /**
+     * @brief create an empty graph.
+     */
+    Graph() = default;
+
+    /**
+     * @brief create a graph from nodes and edges in bulk.
+     * The edges are sorted once, which is much faster than adding them one by one using add_edge
+     * for large graphs. The edges may be in any order. If there are multiple edges between the same
+     * pair of nodes, only the last one is kept, same as if they were added one by one.
+     * @see GraphBuilder
+     * @param nodes nodes of the graph.
+     * @param edges edges of the graph, start and end node indices must refer to the nodes.
+     */
+    Graph(std::vector<Node<NodePropertyT>> nodes, std::vector<Edge<EdgePropertyT>> edges)
+        : m_nodes(std::move(nodes))
+        , m_edges(std::move(edges))
+    {
+        sort_edges();
+    }
+
     /**
      * @brief add a node to the graph. property of the node is constructed from arguments.
      */
@@ -148,23 +177,42 @@ public:
     Node<NodePropertyT>& add_node(int id, Args&&... args)
     {
         m_nodes.emplace_back(id, std::forward<Args>(args)...);
+        m_offsets_outdated = true;
         return m_nodes.back();
     }
 
     /**
      * @brief add an edge to the graph. property of the edge is constructed from arguments.
+     * If there already is an edge between the nodes, it is replaced.
+     * Adding an edge is linear in the number of edges, use GraphBuilder, add_edges or the bulk constructor
+     * to create large graphs. The offsets of the out and in edges are computed again on the next access.
      */
     template <class... Args>
     Edge<EdgePropertyT>& add_edge(size_t start_node_idx, size_t end_node_idx, Args&&... args)
     {
         assert(m_nodes.size() > start_node_idx && m_nodes.size() > end_node_idx);
-        return *insert_sorted_replace(m_edges,
-                                      Edge<EdgePropertyT>(start_node_idx, end_node_idx, std::forward<Args>(args)...),
-                                      [](auto&& e1, auto&& e2) {
-                                          return e1.start_node_idx == e2.start_node_idx
-                                                     ? e1.end_node_idx < e2.end_node_idx
-                                                     : e1.start_node_idx < e2.start_node_idx;
-                                      });
+        auto edge = Edge<EdgePropertyT>(start_node_idx, end_node_idx, std::forward<Args>(args)...);
+        auto iter = std::lower_bound(m_edges.begin(), m_edges.end(), edge, &is_edge_less);
+        if (iter != m_edges.end() && !is_edge_less(edge, *iter)) {
+            *iter = std::move(edge);
+            return *iter;
+        }
+        m_offsets_outdated = true;
+        return *m_edges.insert(iter, std::move(edge));
+    }
+
+    /**
+     * @brief add many edges to the graph at once.
+     * The edges are sorted once, which is much faster than adding them one by one using add_edge.
+     * The edges may be in any order. Existing edges between the same nodes are replaced.
+     * If there are multiple new edges between the same nodes, the last one is kept.
+     * @param edges new edges, start and end node indices must refer to nodes of the graph.
+     */
+    void add_edges(std::vector<Edge<EdgePropertyT>> edges)
+    {
+        m_edges.reserve(m_edges.size() + edges.size());
+        std::move(edges.begin(), edges.end(), std::back_inserter(m_edges));
+        sort_edges();
     }
 
     /**
@@ -200,35 +248,215 @@ public:
     }
 
     /**
-     * @brief range of edges going out from a specific node
+     * @brief range of edges going out from a specific node.
+     * Edges are ordered by end node.
      */
     auto out_edges(size_t node_idx)
     {
-        return out_edges(begin(m_edges), end(m_edges), node_idx);
+        update_offsets();
+        return make_range(begin(m_edges) + m_out_offsets[node_idx], begin(m_edges) + m_out_offsets[node_idx + 1]);
     }
 
     /**
-     * @brief range of edges going out from a specific node
+     * @brief range of edges going out from a specific node.
+     * Edges are ordered by end node.
      */
     auto out_edges(size_t node_idx) const
     {
-        return out_edges(begin(m_edges), end(m_edges), node_idx);
+        update_offsets();
+        return make_range(begin(m_edges) + m_out_offsets[node_idx], begin(m_edges) + m_out_offsets[node_idx + 1]);
+    }
+
+    /**
+     * @brief range of edges coming in to a specific node.
+     * Edges are ordered by start node.
+     */
+    auto in_edges(size_t node_idx)
+    {
+        return in_edges(m_edges.data(), node_idx);
+    }
+
+    /**
+     * @brief range of edges coming in to a specific node.
+     * Edges are ordered by start node.
+     */
+    auto in_edges(size_t node_idx) const
+    {
+        return in_edges(m_edges.data(), node_idx);
+    }
+
+    /**
+     * @brief offsets of the out edges of each node in the range of all edges.
+     * The out edges of node i are the edges with indices in [offsets[i], offsets[i + 1]).
+     * Size is the number of nodes + 1.
+     */
+    const std::vector<size_t>& out_edge_offsets() const
+    {
+        update_offsets();
+        return m_out_offsets;
+    }
+
+    /**
+     * @brief offsets of the in edges of each node in the in edge indices.
+     * The in edges of node i are the edges with indices in_edge_indices()[j] for j in [offsets[i], offsets[i + 1]).
+     * Size is the number of nodes + 1.
+     */
+    const std::vector<size_t>& in_edge_offsets() const
+    {
+        update_offsets();
+        return m_in_offsets;
+    }
+
+    /**
+     * @brief indices of all edges in the range of all edges, ordered by end node and then by start node.
+     * @see in_edge_offsets
+     */
+    const std::vector<size_t>& in_edge_indices() const
+    {
+        update_offsets();
+        return m_in_edge_indices;
     }
 
 private:
-    template <typename Iter>
-    static auto out_edges(Iter b, Iter e, size_t idx)
+    static bool is_edge_less(const Edge<EdgePropertyT>& e1, const Edge<EdgePropertyT>& e2)
+    {
+        return e1.start_node_idx == e2.start_node_idx ? e1.end_node_idx < e2.end_node_idx
+                                                      : e1.start_node_idx < e2.start_node_idx;
+    }
+
+    template <class EdgePtr>
+    auto in_edges(EdgePtr edges, size_t node_idx) const
+    {
+        update_offsets();
+        auto get_edge = [edges](size_t edge_idx) -> decltype(*edges) {
+            return edges[edge_idx];
+        };
+        return make_range(make_transform_iterator(begin(m_in_edge_indices) + m_in_offsets[node_idx], get_edge),
+                          make_transform_iterator(begin(m_in_edge_indices) + m_in_offsets[node_idx + 1], get_edge));
+    }
+
+    /**
+     * sort edges, remove duplicates and compute out and in edge offsets.
+     */
+    void sort_edges()
     {
-        return make_range(std::equal_range(b, e, OutEdgeBase(idx), [](auto&& e1, auto&& e2) {
-            return e1.start_node_idx < e2.start_node_idx;
-        }));
+        //stable so that the last of multiple equal edges is still the last after sorting
+        std::stable_sort(m_edges.begin(), m_edges.end(), &is_edge_less);
+        //keep only the last of each run of equal edges
+        auto out = m_edges.begin();
+        for (auto it = m_edges.begin(); it != m_edges.end(); ++it) {
+            assert(it->start_node_idx < m_nodes.size() && it->end_node_idx < m_nodes.size());
+            auto next = std::next(it);
+            if (next == m_edges.end() || is_edge_less(*it, *next)) {
+                if (out != it) {
+                    *out = std::move(*it);
+                }
+                ++out;
+            }
+        }
+        m_edges.erase(out, m_edges.end());
+        build_offsets();
+    }
+
+    /**
+     * compute out and in edge offsets again if edges or nodes were added one by one.
+     */
+    void update_offsets() const
+    {
+        if (m_offsets_outdated) {
+            build_offsets();
+        }
+    }
+
+    /**
+     * compute out and in edge offsets of sorted edges.
+     */
+    void build_offsets() const
+    {
+        auto num_nodes = m_nodes.size();
+        m_out_offsets.assign(num_nodes + 1, 0);
+        m_in_offsets.assign(num_nodes + 1, 0);
+        for (auto& e : m_edges) {
+            ++m_out_offsets[e.start_node_idx + 1];
+            ++m_in_offsets[e.end_node_idx + 1];
+        }
+        std::partial_sum(m_out_offsets.begin(), m_out_offsets.end(), m_out_offsets.begin());
+        std::partial_sum(m_in_offsets.begin(), m_in_offsets.end(), m_in_offsets.begin());
+
+        //counting sort by end node, stable so in edges stay ordered by start node
+        m_in_edge_indices.resize(m_edges.size());
+        auto next_in_pos = m_in_offsets;
+        for (size_t edge_idx = 0; edge_idx < m_edges.size(); ++edge_idx) {
+            m_in_edge_indices[next_in_pos[m_edges[edge_idx].end_node_idx]++] = edge_idx;
+        }
+        m_offsets_outdated = false;
     }
 
 private:
     std::vector<Node<NodePropertyT>> m_nodes;
     std::vector<Edge<EdgePropertyT>> m_edges;
+    //offsets are computed lazily after adding nodes or edges one by one
+    mutable std::vector<size_t> m_out_offsets = {0}; ///< offsets of out edges of each node in m_edges.
+    mutable std::vector<size_t> m_in_offsets  = {0}; ///< offsets of in edges of each node in m_in_edge_indices.
+    mutable std::vector<size_t> m_in_edge_indices; ///< indices of edges in m_edges ordered by end node.
+    mutable bool m_offsets_outdated = false;
 }; // namespace mio
 
+/**
+ * @brief builds a graph from nodes and edges that are added in any order.
+ * Adding edges is constant time, the edges are sorted once when the graph is built.
+ * Use this instead of Graph::add_edge to create large graphs.
+ */
+template <class NodePropertyT, class EdgePropertyT>
+class GraphBuilder
+{
+public:
+    /**
+     * @brief reserve memory for a number of nodes and edges.
+     */
+    void reserve(size_t num_nodes, size_t num_edges)
+    {
+        m_nodes.reserve(num_nodes);
+        m_edges.reserve(num_edges);
+    }
+
+    /**
+     * @brief add a node to the graph. property of the node is constructed from arguments.
+     */
+    template <class... Args>
+    void add_node(int id, Args&&... args)
+    {
+        m_nodes.emplace_back(id, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief add an edge to the graph. property of the edge is constructed from arguments.
+     * If an edge between the same nodes is added multiple times, the last one is kept.
+     * Nodes don't have to be added before the edges that refer to them.
+     */
+    template <class... Args>
+    void add_edge(size_t start_node_idx, size_t end_node_idx, Args&&... args)
+    {
+        m_edges.emplace_back(start_node_idx, end_node_idx, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief build the graph from the added nodes and edges.
+     * The builder is empty afterwards.
+     */
+    Graph<NodePropertyT, EdgePropertyT> build()
+    {
+        auto graph = Graph<NodePropertyT, EdgePropertyT>(std::move(m_nodes), std::move(m_edges));
+        m_nodes.clear();
+        m_edges.clear();
+        return graph;
+    }
+
+private:
+    std::vector<Node<NodePropertyT>> m_nodes;
+    std::vector<Edge<EdgePropertyT>> m_edges;
+};
+
 /**
  * Create an unconnected graph.
  * Can be used to save space on disk when writing parameters if the edges are not required.
@@ -21,6 +21,7 @@
 #define EPI_MOBILITY_GRAPH_SIMULATION_H
 
 #include "memilio/mobility/graph.h"
+#include "memilio/utils/profiling.h"
 
 namespace mio
 {
@@ -58,21 +59,28 @@ public:
 
     void advance(double t_max = 1.0)
     {
+        MEMILIO_PROFILE_SCOPE("GraphSimulation::advance");
         auto dt = m_dt;
         while (m_t < t_max) {
             if (m_t + dt > t_max) {
                 dt = t_max - m_t;
             }
 
-            for (auto& n : m_graph.nodes()) {
-                m_node_func(m_t, dt, n.property);
+            {
+                MEMILIO_PROFILE_SCOPE("nodes");
+                for (auto& n : m_graph.nodes()) {
+                    m_node_func(m_t, dt, n.property);
+                }
             }
 
             m_t += dt;
 
-            for (auto& e : m_graph.edges()) {
-                m_edge_func(m_t, dt, e.property, m_graph.nodes()[e.start_node_idx].property,
-                            m_graph.nodes()[e.end_node_idx].property);
+            {
+                MEMILIO_PROFILE_SCOPE("edges");
+                for (auto& e : m_graph.edges()) {
+                    m_edge_func(m_t, dt, e.property, m_graph.nodes()[e.start_node_idx].property,
+                                m_graph.nodes()[e.end_node_idx].property);
+                }
             }
         }
     }
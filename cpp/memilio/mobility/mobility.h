@@ -26,12 +26,18 @@
 #include "memilio/math/eigen_util.h"
 #include "memilio/utils/metaprogramming.h"
 #include "memilio/utils/compiler_diagnostics.h"
+#include "memilio/utils/profiling.h"
 #include "memilio/math/euler.h"
 #include "memilio/epidemiology/contact_matrix.h"
 #include "memilio/epidemiology/dynamic_npis.h"
 #include "memilio/compartments/simulation.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace mio
 {
@@ -49,6 +55,7 @@ public:
         , m_last_state(m_simulation.get_result().get_last_value())
         , m_t0(m_simulation.get_result().get_last_time())
     {
+        m_step_start_states.fill({std::numeric_limits<double>::quiet_NaN(), Eigen::VectorXd()});
     }
 
     /**
@@ -79,6 +86,14 @@ public:
     }
     /**@}*/
 
+    /**
+     * get the statistics of the integration of the simulation in this node.
+     */
+    decltype(auto) get_integrator_statistics() const
+    {
+        return m_simulation.get_integrator_statistics();
+    }
+
     Eigen::Ref<const Eigen::VectorXd> get_last_state() const
     {
         return m_last_state;
@@ -89,16 +104,80 @@ public:
         return m_t0;
     }
 
+    /**
+     * get the state of the simulation at the start of one of the last time steps.
+     * The start of a time step is after the migration at that time, so the state is the same as
+     * the value in the result at that time. Only the states of the last few time steps are stored.
+     * @param t time at the start of a time step.
+     * @return pointer to the state, nullptr if the state at that time is not stored.
+     */
+    const Eigen::VectorXd* get_step_start_state(double t) const
+    {
+        for (auto& state : m_step_start_states) {
+            if (floating_point_equal(state.first, t, 1e-10, 1e-10)) {
+                return &state.second;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * get the migration factors of this node at time t.
+     * The factors are the same for all edges that start in this node, so they are computed only once
+     * for each time step and shared by all edges.
+     * @param t the current simulation time.
+     * @see get_migration_factors
+     */
+    const Eigen::VectorXd& get_migration_factors_cached(double t)
+    {
+        if (m_migration_factors_time != t) {
+            m_migration_factors      = get_migration_factors(*this, t, m_last_state);
+            m_migration_factors_time = t;
+        }
+        return m_migration_factors;
+    }
+
+    /**
+     * get the relative number of infected people in this node at time t for dynamic NPIs.
+     * Computed only once for each time step and shared by all edges that start in this node.
+     * @param t the current simulation time.
+     * @see get_infections_relative
+     */
+    double get_infections_relative_cached(double t)
+    {
+        if (m_infections_relative_time != t) {
+            m_infections_relative      = get_infections_relative(*this, t, m_last_state);
+            m_infections_relative_time = t;
+        }
+        return m_infections_relative;
+    }
+
     void evolve(double t, double dt)
     {
+        //migrants return after one time step, so a few states are enough
+        auto& state  = m_step_start_states[m_next_step_start_state];
+        state.first  = m_simulation.get_result().get_last_time();
+        state.second = m_simulation.get_result().get_last_value();
+
+        m_next_step_start_state = (m_next_step_start_state + 1) % m_step_start_states.size();
+
         m_simulation.advance(t + dt);
         m_last_state = m_simulation.get_result().get_last_value();
+
+        m_migration_factors_time   = std::numeric_limits<double>::quiet_NaN();
+        m_infections_relative_time = std::numeric_limits<double>::quiet_NaN();
     }
 
 private:
     Sim m_simulation;
     Eigen::VectorXd m_last_state;
     double m_t0;
+    std::array<std::pair<double, Eigen::VectorXd>, 2> m_step_start_states; ///< ring buffer of time and state.
+    size_t m_next_step_start_state = 0;
+    Eigen::VectorXd m_migration_factors;
+    double m_migration_factors_time   = std::numeric_limits<double>::quiet_NaN();
+    double m_infections_relative      = 0.0;
+    double m_infections_relative_time = std::numeric_limits<double>::quiet_NaN();
 };
 
 /**
@@ -246,13 +325,18 @@ class MigrationEdge
 public:
     /**
      * create edge with coefficients.
-     * @param coeffs % of people in each group and compartment that migrate in each time step.
+     * Only the coefficients of the compartments that can migrate are stored.
+     * @param params migration coefficients and dynamic NPIs.
      */
     MigrationEdge(const MigrationParameters& params)
-        : m_parameters(params)
-        , m_migrated(params.get_coefficients().get_shape().rows())
+        : m_num_compartments(params.get_coefficients().get_shape().rows())
+        , m_coefficient_indices(get_migrating_indices(params.get_coefficients()))
+        , m_parameters(compress_parameters(params, m_coefficient_indices))
+        , m_migrating_indices(m_coefficient_indices)
+        , m_migrated(Eigen::Index(m_migrating_indices.size()))
         , m_return_times(0)
         , m_return_migrated(false)
+        , m_buffer(m_num_compartments)
     {
     }
 
@@ -261,19 +345,18 @@ public:
      * @param coeffs % of people in each group and compartment that migrate in each time step.
      */
     MigrationEdge(const Eigen::VectorXd& coeffs)
-        : m_parameters(coeffs)
-        , m_migrated(coeffs.rows())
-        , m_return_times(0)
-        , m_return_migrated(false)
+        : MigrationEdge(MigrationParameters(coeffs))
     {
     }
 
     /**
      * get the migration parameters.
+     * The coefficients are restored from the stored coefficients of the compartments that can migrate,
+     * dampings of all other compartments are zero.
      */
-    const MigrationParameters& get_parameters() const
+    MigrationParameters get_parameters() const
     {
-        return m_parameters;
+        return expand_parameters(m_parameters, m_coefficient_indices, m_num_compartments);
     }
 
     /**
@@ -289,11 +372,122 @@ public:
     template <class Sim>
     void apply_migration(double t, double dt, SimulationNode<Sim>& node_from, SimulationNode<Sim>& node_to);
 
+    /**
+     * get the indices of the compartments that can migrate.
+     * Only the migrants in these compartments are computed and stored.
+     * Compartments that test_commuters moved migrants into are added during the simulation.
+     */
+    const std::vector<Eigen::Index>& get_migrating_indices() const
+    {
+        return m_migrating_indices;
+    }
+
 private:
-    MigrationParameters m_parameters;
-    TimeSeries<double> m_migrated;
+    /**
+     * compartments where baseline or minimum of any coefficient matrix are not zero.
+     * dampings only move the coefficients between baseline and minimum, so all other coefficients stay zero.
+     */
+    static std::vector<Eigen::Index> get_migrating_indices(const MigrationCoefficientGroup& coeffs)
+    {
+        std::vector<Eigen::Index> indices;
+        for (Eigen::Index i = 0; i < coeffs.get_shape().rows(); ++i) {
+            if (std::any_of(coeffs.begin(), coeffs.end(), [i](auto& m) {
+                    return m.get_baseline()[i] != 0.0 || m.get_minimum()[i] != 0.0;
+                })) {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
+    /**
+     * copy the parameters with baseline, minimum and dampings reduced to the compartments in indices.
+     */
+    static MigrationParameters compress_parameters(const MigrationParameters& params,
+                                                   const std::vector<Eigen::Index>& indices)
+    {
+        auto compress = [&indices](const Eigen::VectorXd& v) {
+            Eigen::VectorXd compressed(Eigen::Index(indices.size()));
+            for (size_t k = 0; k < indices.size(); ++k) {
+                compressed[Eigen::Index(k)] = v[indices[k]];
+            }
+            return compressed;
+        };
+        return transform_parameters(params, compress);
+    }
+
+    /**
+     * copy the parameters with baseline, minimum and dampings of all compartments.
+     * inverse of compress_parameters, the coefficients of compartments that are not in indices are zero.
+     */
+    static MigrationParameters expand_parameters(const MigrationParameters& params,
+                                                 const std::vector<Eigen::Index>& indices, Eigen::Index num_compartments)
+    {
+        auto expand = [&indices, num_compartments](const Eigen::VectorXd& v) {
+            Eigen::VectorXd expanded = Eigen::VectorXd::Zero(num_compartments);
+            for (size_t k = 0; k < indices.size(); ++k) {
+                expanded[indices[k]] = v[Eigen::Index(k)];
+            }
+            return expanded;
+        };
+        return transform_parameters(params, expand);
+    }
+
+    /**
+     * copy the parameters with transform applied to baseline, minimum and dampings of each coefficient matrix.
+     */
+    template <class F>
+    static MigrationParameters transform_parameters(const MigrationParameters& params, F transform)
+    {
+        std::vector<MigrationCoefficients> matrices;
+        matrices.reserve(params.get_coefficients().get_num_matrices());
+        for (auto& m : params.get_coefficients()) {
+            MigrationCoefficients transformed(transform(m.get_baseline()), transform(m.get_minimum()));
+            for (auto& d : m.get_dampings()) {
+                transformed.add_damping(transform(d.get_coeffs()), d.get_level(), d.get_type(), d.get_time());
+            }
+            matrices.push_back(std::move(transformed));
+        }
+        auto transformed_params = MigrationParameters(MigrationCoefficientGroup(matrices));
+        transformed_params.set_dynamic_npis_infected(params.get_dynamic_npis_infected());
+        return transformed_params;
+    }
+
+    /**
+     * add all compartments where migrants are not zero to the migrating compartments.
+     * the stored migrants are copied to the new set of compartments.
+     * @param migrated migrants in all compartments.
+     */
+    void add_migrating_indices(Eigen::Ref<const Eigen::VectorXd> migrated)
+    {
+        auto indices = m_migrating_indices;
+        for (Eigen::Index i = 0; i < migrated.size(); ++i) {
+            if (migrated[i] != 0.0 && !std::binary_search(m_migrating_indices.begin(), m_migrating_indices.end(), i)) {
+                indices.push_back(i);
+            }
+        }
+        std::sort(indices.begin(), indices.end());
+
+        TimeSeries<double> stored(Eigen::Index(indices.size()));
+        for (Eigen::Index i = 0; i < m_migrated.get_num_time_points(); ++i) {
+            stored.add_time_point(m_migrated.get_time(i), Eigen::VectorXd::Zero(Eigen::Index(indices.size())));
+            for (size_t k = 0; k < m_migrating_indices.size(); ++k) {
+                auto new_k = std::lower_bound(indices.begin(), indices.end(), m_migrating_indices[k]) - indices.begin();
+                stored.get_last_value()[new_k] = m_migrated[i][Eigen::Index(k)];
+            }
+        }
+        m_migrating_indices = std::move(indices);
+        m_migrated          = std::move(stored);
+    }
+
+    Eigen::Index m_num_compartments;
+    std::vector<Eigen::Index> m_coefficient_indices; ///< compartments that have migration coefficients.
+    MigrationParameters m_parameters; ///< coefficients of the compartments in m_coefficient_indices.
+    std::vector<Eigen::Index> m_migrating_indices;
+    TimeSeries<double> m_migrated; ///< migrants in the migrating compartments, in the order of the indices.
     TimeSeries<double> m_return_times;
     bool m_return_migrated;
+    Eigen::VectorXd m_buffer; ///< migrants or returns in all compartments, reused in every step.
     double m_t_last_dynamic_npi_check               = -std::numeric_limits<double>::infinity();
     std::pair<double, SimulationTime> m_dynamic_npi = {-std::numeric_limits<double>::max(), SimulationTime(0)};
 };
@@ -392,6 +586,8 @@ using test_commuters_expr_t = decltype(
 /**
  * Test persons when migrating from their source node.
  * May transfer persons between compartments, e.g., if an infection was detected.
+ * If migrants are added to compartments that don't migrate otherwise, these compartments are added to
+ * MigrationEdge::get_migrating_indices.
  * This feature is optional, default implementation does nothing.
  * In order to support this feature for your model, implement a test_commuters overload 
  * that can be found with argument-dependent lookup.
@@ -412,6 +608,8 @@ void test_commuters(SimulationNode<Sim>& node, Eigen::Ref<Eigen::VectorXd> migra
 template <class Sim>
 void MigrationEdge::apply_migration(double t, double dt, SimulationNode<Sim>& node_from, SimulationNode<Sim>& node_to)
 {
+    MEMILIO_PROFILE_SCOPE("MigrationEdge::apply_migration");
+
     //check dynamic npis
     if (m_t_last_dynamic_npi_check == -std::numeric_limits<double>::infinity()) {
         m_t_last_dynamic_npi_check = node_from.get_t0();
@@ -420,7 +618,8 @@ void MigrationEdge::apply_migration(double t, double dt, SimulationNode<Sim>& no
     auto& dyn_npis = m_parameters.get_dynamic_npis_infected();
     if (dyn_npis.get_thresholds().size() > 0 &&
         floating_point_greater_equal(t, m_t_last_dynamic_npi_check + dyn_npis.get_interval().get())) {
-        auto inf_rel = get_infections_relative(node_from, t, node_from.get_last_state()) * dyn_npis.get_base_value();
+        MEMILIO_PROFILE_SCOPE("dynamic_npis");
+        auto inf_rel            = node_from.get_infections_relative_cached(t) * dyn_npis.get_base_value();
         auto exceeded_threshold = dyn_npis.get_max_exceeded_threshold(inf_rel);
         if (exceeded_threshold != dyn_npis.get_thresholds().end() &&
             (exceeded_threshold->first > m_dynamic_npi.first ||
@@ -429,7 +628,13 @@ void MigrationEdge::apply_migration(double t, double dt, SimulationNode<Sim>& no
             m_dynamic_npi = std::make_pair(exceeded_threshold->first, t_end);
             implement_dynamic_npis(
                 m_parameters.get_coefficients(), exceeded_threshold->second, SimulationTime(t), t_end, [this](auto& g) {
-                    return make_migration_damping_vector(m_parameters.get_coefficients().get_shape(), g);
+                    //only the values of the compartments with stored coefficients are needed
+                    auto values = make_migration_damping_vector(ColumnVectorShape(m_num_compartments), g).eval();
+                    Eigen::VectorXd compressed(Eigen::Index(m_coefficient_indices.size()));
+                    for (size_t k = 0; k < m_coefficient_indices.size(); ++k) {
+                        compressed[Eigen::Index(k)] = values[m_coefficient_indices[k]];
+                    }
+                    return compressed;
                 });
         }
         m_t_last_dynamic_npi_check = t;
@@ -438,49 +643,92 @@ void MigrationEdge::apply_migration(double t, double dt, SimulationNode<Sim>& no
     //returns
     for (Eigen::Index i = m_return_times.get_num_time_points() - 1; i >= 0; --i) {
         if (m_return_times.get_time(i) <= t) {
-            auto v0 = find_value_reverse(node_to.get_result(), m_migrated.get_time(i), 1e-10, 1e-10);
-            assert(v0 != node_to.get_result().rend() && "unexpected error.");
-            calculate_migration_returns(m_migrated[i], node_to.get_simulation(), *v0, m_migrated.get_time(i), dt);
+            MEMILIO_PROFILE_SCOPE("returns");
+            //state of node_to after the migration, the result only needs to be searched
+            //if the node was not advanced using evolve
+            //migrants may change compartments, so the returns are computed for all compartments
+            auto t_migrated = m_migrated.get_time(i);
+            auto& returns   = m_buffer;
+            returns.setZero();
+            for (size_t k = 0; k < m_migrating_indices.size(); ++k) {
+                returns[m_migrating_indices[k]] = m_migrated[i][Eigen::Index(k)];
+            }
+            if (auto v0 = node_to.get_step_start_state(t_migrated)) {
+                calculate_migration_returns(returns, node_to.get_simulation(), *v0, t_migrated, dt);
+            }
+            else {
+                auto v0_result = find_value_reverse(node_to.get_result(), t_migrated, 1e-10, 1e-10);
+                assert(v0_result != node_to.get_result().rend() && "unexpected error.");
+                calculate_migration_returns(returns, node_to.get_simulation(), *v0_result, t_migrated, dt);
+            }
 
             //the lower-order return calculation may in rare cases produce negative compartments,
             //especially at the beginning of the simulation.
             //fix by subtracting the supernumerous returns from the biggest compartment of the age group.
-            Eigen::VectorXd remaining_after_return = (node_to.get_result().get_last_value() - m_migrated[i]).eval();
+            //the underflows are logged once per return, they can happen on many edges in the same step.
+            Eigen::VectorXd remaining_after_return = (node_to.get_result().get_last_value() - returns).eval();
+            Eigen::Index num_underflows            = 0;
+            double min_underflow                   = 0.0;
             for (Eigen::Index j = 0; j < node_to.get_result().get_last_value().size(); ++j) {
                 if (remaining_after_return(j) < 0) {
                     auto num_comparts = (Eigen::Index)Sim::Model::Compartments::Count;
                     auto group        = Eigen::Index(j / num_comparts);
                     auto compart      = j % num_comparts;
-                    log(remaining_after_return(j) < -1e-3 ? LogLevel::warn : LogLevel::info,
-                        "Underflow during migration returns at time {}, compartment {}, age group {}: {}", t, compart,
-                        group, remaining_after_return(j));
+                    log_debug("Underflow during migration returns at time {}, compartment {}, age group {}: {}", t,
+                              compart, group, remaining_after_return(j));
                     Eigen::Index max_index;
                     slice(remaining_after_return, {group * num_comparts, num_comparts}).maxCoeff(&max_index);
-                    log_info("Transferring to compartment {}", max_index);
+                    log_debug("Transferring to compartment {}", max_index);
                     max_index += group * num_comparts;
-                    m_migrated[i](max_index) -= remaining_after_return(j);
-                    m_migrated[i](j) += remaining_after_return(j);
+                    returns(max_index) -= remaining_after_return(j);
+                    returns(j) += remaining_after_return(j);
+                    ++num_underflows;
+                    min_underflow = std::min(min_underflow, remaining_after_return(j));
                 }
             }
-            node_from.get_result().get_last_value() += m_migrated[i];
-            node_to.get_result().get_last_value() -= m_migrated[i];
+            if (num_underflows > 0) {
+                log(min_underflow < -1e-3 ? LogLevel::warn : LogLevel::info,
+                    "{} underflows during migration returns at time {}, largest: {}", num_underflows, t,
+                    min_underflow);
+            }
+            node_from.get_result().get_last_value() += returns;
+            node_to.get_result().get_last_value() -= returns;
             m_migrated.remove_time_point(i);
             m_return_times.remove_time_point(i);
         }
     }
 
-    if (!m_return_migrated && (m_parameters.get_coefficients().get_matrix_at(t).array() > 0.0).any()) {
-        //normal daily migration
-        m_migrated.add_time_point(
-            t, (node_from.get_last_state().array() * m_parameters.get_coefficients().get_matrix_at(t).array() *
-                get_migration_factors(node_from, t, node_from.get_last_state()).array())
-                   .matrix());
-        m_return_times.add_time_point(t + dt);
+    if (!m_return_migrated) {
+        //normal daily migration, only the coefficients of the migrating compartments are stored and evaluated
+        MEMILIO_PROFILE_SCOPE("migration");
+        auto& coeffs = m_parameters.get_coefficients().get_scheduled_matrix_at(t);
+        if ((coeffs.array() > 0.0).any()) {
+            auto state     = node_from.get_last_state();
+            auto& factors  = node_from.get_migration_factors_cached(t);
+            auto& migrated = m_buffer;
+            migrated.setZero();
+            for (size_t k = 0; k < m_coefficient_indices.size(); ++k) {
+                auto idx      = m_coefficient_indices[k];
+                migrated[idx] = state[idx] * coeffs[Eigen::Index(k)] * factors[idx];
+            }
+
+            test_commuters(node_from, migrated, t);
+            //test_commuters may move migrants into compartments that don't migrate otherwise
+            if (std::count_if(m_migrating_indices.begin(), m_migrating_indices.end(), [&migrated](auto idx) {
+                    return migrated[idx] != 0.0;
+                }) != (migrated.array() != 0.0).count()) {
+                add_migrating_indices(migrated);
+            }
 
-        test_commuters(node_from, m_migrated.get_last_value(), t);
+            m_migrated.add_time_point(t);
+            for (Eigen::Index k = 0; k < Eigen::Index(m_migrating_indices.size()); ++k) {
+                m_migrated.get_last_value()[k] = migrated[m_migrating_indices[size_t(k)]];
+            }
+            m_return_times.add_time_point(t + dt);
 
-        node_to.get_result().get_last_value() += m_migrated.get_last_value();
-        node_from.get_result().get_last_value() -= m_migrated.get_last_value();
+            node_to.get_result().get_last_value() += migrated;
+            node_from.get_result().get_last_value() -= migrated;
+        }
     }
     m_return_migrated = !m_return_migrated;
 }
@@ -531,6 +779,35 @@ make_migration_sim(double t0, double dt, Graph<SimulationNode<Sim>, MigrationEdg
 }
 /** @} */
 
+/**
+ * combined statistics of the integration in all nodes of a graph.
+ * Use the statistics of the single nodes to find out which nodes require the most steps.
+ * @param graph graph of a migration simulation.
+ */
+template <class Sim>
+IntegratorStatistics get_integrator_statistics(const Graph<SimulationNode<Sim>, MigrationEdge>& graph)
+{
+    IntegratorStatistics statistics;
+    for (auto& node : graph.nodes()) {
+        statistics += node.property.get_integrator_statistics();
+    }
+    return statistics;
+}
+
+/**
+ * combined statistics of the integration in all nodes of all graphs of an ensemble, e.g., of a parameter study.
+ * @param ensemble graphs of migration simulations.
+ */
+template <class Sim>
+IntegratorStatistics get_integrator_statistics(const std::vector<Graph<SimulationNode<Sim>, MigrationEdge>>& ensemble)
+{
+    IntegratorStatistics statistics;
+    for (auto& graph : ensemble) {
+        statistics += get_integrator_statistics(graph);
+    }
+    return statistics;
+}
+
 } // namespace mio
 
 #endif //MOBILITY_H
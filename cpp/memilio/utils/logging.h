@@ -26,8 +26,12 @@
 #define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #endif
 
+#include "memilio/config.h"
 #include "memilio/utils/compiler_diagnostics.h"
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+
+#include <type_traits>
 
 namespace mio
 {
@@ -43,6 +47,29 @@ enum class LogLevel
     off
 };
 
+/**
+ * @brief Minimum level of log messages that are compiled.
+ * Calls of log functions with a lower level are removed at compile time, so they don't have any cost.
+ * Set with the cmake option MEMILIO_LOG_LEVEL_MIN, e.g. to warn for large production runs.
+ * Default is trace for debug builds and info for release builds.
+ */
+#if defined(MEMILIO_LOG_LEVEL_MIN)
+constexpr LogLevel log_level_min = LogLevel::MEMILIO_LOG_LEVEL_MIN;
+#elif defined(NDEBUG)
+constexpr LogLevel log_level_min = LogLevel::info;
+#else
+constexpr LogLevel log_level_min = LogLevel::trace;
+#endif
+
+/**
+ * @brief True if log messages of the level are compiled.
+ * @see log_level_min
+ */
+constexpr bool is_log_level_compiled(LogLevel level)
+{
+    return level >= log_level_min;
+}
+
 namespace details
 {
 inline spdlog::level::level_enum get_spdlog_level(LogLevel level)
@@ -76,6 +103,22 @@ inline spdlog::level::level_enum get_spdlog_level(LogLevel level)
     }
     return l;
 }
+
+template <typename... Args>
+inline void log_impl(std::true_type /*compiled*/, spdlog::level::level_enum level, spdlog::string_view_t fmt,
+                     const Args&... args)
+{
+    spdlog::default_logger_raw()->log(level, fmt, args...);
+}
+template <typename... Args>
+inline void log_impl(std::false_type /*compiled*/, spdlog::level::level_enum /*level*/, spdlog::string_view_t fmt,
+                     const Args&... args)
+{
+    unused(fmt, args...);
+}
+
+template <LogLevel Level>
+using is_log_level_compiled_t = std::integral_constant<bool, is_log_level_compiled(Level)>;
 } // namespace details
 
 /**
@@ -86,38 +129,71 @@ inline void set_log_level(LogLevel level)
     spdlog::set_level(details::get_spdlog_level(level));
 }
 
+/**
+ * @brief Log messages from a background thread.
+ * Replaces the default logger with an asynchronous logger that writes to the same sinks.
+ * Messages are formatted by the calling thread, but the calling thread does not wait for the sinks,
+ * e.g. for writing to the console or to a file.
+ * @param queue_size maximum number of queued messages, the calling thread waits if the queue is full.
+ */
+inline void enable_async_logging(size_t queue_size = 8192)
+{
+    auto logger = spdlog::default_logger();
+    spdlog::init_thread_pool(queue_size, 1);
+    auto async_logger =
+        std::make_shared<spdlog::async_logger>(logger->name(), logger->sinks().begin(), logger->sinks().end(),
+                                               spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+    async_logger->set_level(logger->level());
+    spdlog::set_default_logger(async_logger);
+}
+
+/**
+ * @brief Log messages from the calling thread again after enable_async_logging.
+ * Waits until all queued messages are written.
+ */
+inline void disable_async_logging()
+{
+    auto logger      = spdlog::default_logger();
+    auto sync_logger = std::make_shared<spdlog::logger>(logger->name(), logger->sinks().begin(), logger->sinks().end());
+    sync_logger->set_level(logger->level());
+    spdlog::set_default_logger(sync_logger);
+    //the thread pool writes all queued messages before it is destroyed
+    spdlog::details::registry::instance().set_tp(nullptr);
+}
+
 template <typename... Args>
 inline void log_info(spdlog::string_view_t fmt, const Args&... args)
 {
-    spdlog::default_logger_raw()->info(fmt, args...);
+    details::log_impl(details::is_log_level_compiled_t<LogLevel::info>{}, spdlog::level::info, fmt, args...);
 }
 
 template <typename... Args>
 inline void log_error(spdlog::string_view_t fmt, const Args&... args)
 {
-    spdlog::default_logger_raw()->error(fmt, args...);
+    details::log_impl(details::is_log_level_compiled_t<LogLevel::err>{}, spdlog::level::err, fmt, args...);
 }
 
 template <typename... Args>
 inline void log_warning(spdlog::string_view_t fmt, const Args&... args)
 {
-    spdlog::default_logger_raw()->warn(fmt, args...);
+    details::log_impl(details::is_log_level_compiled_t<LogLevel::warn>{}, spdlog::level::warn, fmt, args...);
 }
 
 template <typename... Args>
 inline void log_debug(spdlog::string_view_t fmt, const Args&... args)
 {
-#ifndef NDEBUG
-    spdlog::default_logger_raw()->debug(fmt, args...);
-#else
-    unused(fmt, args...);
-#endif
+    details::log_impl(details::is_log_level_compiled_t<LogLevel::debug>{}, spdlog::level::debug, fmt, args...);
 }
 
 template <typename... Args>
 inline void log(LogLevel level, spdlog::string_view_t fmt, const Args&... args)
 {
-    spdlog::default_logger_raw()->log(details::get_spdlog_level(level), fmt, args...);
+    if (is_log_level_compiled(level)) {
+        spdlog::default_logger_raw()->log(details::get_spdlog_level(level), fmt, args...);
+    }
+    else {
+        unused(fmt, args...);
+    }
 }
 
 } // namespace mio
@@ -0,0 +1,248 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_UTILS_PARALLEL_FOR_H
+#define MIO_UTILS_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * @brief number of threads that can run concurrently on this machine, at least 1.
+ */
+inline size_t get_num_hardware_threads()
+{
+    return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief call a function for each index in [0, n) using a pool of threads.
+ * The indices are distributed dynamically, so the function may take a different amount of time for each index.
+ * Calls with different indices must not interfere with each other, e.g., by writing to the same object.
+ * If the function throws, remaining indices are skipped and the first exception is rethrown
+ * after all threads have finished.
+ * @param n number of indices.
+ * @param f function with signature `void f(size_t i)`.
+ * @param num_threads maximum number of threads to use; no additional threads are started if 1.
+ */
+template <class F>
+void parallel_for(size_t n, F&& f, size_t num_threads = get_num_hardware_threads())
+{
+    num_threads = std::min(num_threads, n);
+    if (num_threads <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_idx{0};
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+    auto work = [&]() {
+        for (auto i = next_idx++; i < n; i = next_idx++) {
+            try {
+                f(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+                next_idx = n;
+            }
+        }
+    };
+
+    //the calling thread does its share of the work as well
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t t = 0; t < num_threads - 1; ++t) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+/**
+ * @brief pool of threads that are started once and reused for many parallel loops.
+ * Starting threads takes longer than many small loops, e.g. over the nodes of a graph in every evaluation of
+ * a right hand side, so the threads wait for the next loop instead of being started by every loop.
+ * Only one loop can run at a time, the pool must not be used by multiple threads concurrently.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief start the threads of the pool.
+     * @param num_threads number of threads that execute a loop, including the thread that calls parallel_for,
+     * so num_threads - 1 threads are started.
+     */
+    explicit ThreadPool(size_t num_threads = get_num_hardware_threads())
+    {
+        num_threads = std::max(num_threads, size_t(1));
+        m_workers.reserve(num_threads - 1);
+        for (size_t t = 0; t < num_threads - 1; ++t) {
+            m_workers.emplace_back([this]() {
+                wait_and_work();
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief stop the threads of the pool.
+     */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief number of threads that execute a loop, including the calling thread.
+     */
+    size_t get_num_threads() const
+    {
+        return m_workers.size() + 1;
+    }
+
+    /**
+     * @brief call a function for each index in [0, n) using the threads of the pool.
+     * Same as the free function parallel_for, but without starting threads.
+     * @param n number of indices.
+     * @param f function with signature `void f(size_t i)`.
+     */
+    template <class F>
+    void parallel_for(size_t n, F&& f)
+    {
+        if (m_workers.empty() || n <= 1) {
+            for (size_t i = 0; i < n; ++i) {
+                f(i);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = [&f](size_t i) {
+                f(i);
+            };
+            m_num_indices = n;
+            m_next_idx    = 0;
+            m_num_active  = m_workers.size();
+            m_exception   = nullptr;
+            ++m_generation;
+        }
+        m_start.notify_all();
+
+        //the calling thread does its share of the work as well
+        work();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() {
+            return m_num_active == 0;
+        });
+        m_task = nullptr;
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    void work()
+    {
+        for (auto i = m_next_idx++; i < m_num_indices; i = m_next_idx++) {
+            try {
+                m_task(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_exception) {
+                    m_exception = std::current_exception();
+                }
+                m_next_idx = m_num_indices;
+            }
+        }
+    }
+
+    void wait_and_work()
+    {
+        uint64_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [&]() {
+                    return m_stop || m_generation != generation;
+                });
+                if (m_stop) {
+                    return;
+                }
+                generation = m_generation;
+            }
+            work();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_num_active == 0) {
+                    m_done.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start; ///< signals a new loop or the end of the pool to the workers.
+    std::condition_variable m_done; ///< signals the calling thread that all workers finished the loop.
+    std::function<void(size_t)> m_task;
+    size_t m_num_indices = 0;
+    std::atomic<size_t> m_next_idx{0};
+    size_t m_num_active   = 0; ///< number of workers that have not finished the current loop.
+    uint64_t m_generation = 0; ///< number of loops, workers wait until it changes.
+    bool m_stop           = false;
+    std::exception_ptr m_exception;
+};
+
+} // namespace mio
+
+#endif //MIO_UTILS_PARALLEL_FOR_H
@@ -25,6 +25,7 @@
 #include "memilio/utils/random_number_generator.h"
 #include "memilio/io/io.h"
 
+#include <memory>
 #include <vector>
 #include <random>
 
@@ -149,6 +150,18 @@ public:
 
     virtual double get_rand_sample() = 0;
 
+    /**
+     * @brief returns a random sample without changing the state of this distribution.
+     * Predefined samples are not used. Allows sampling from a distribution that is shared, e.g., between
+     * copies of an UncertainValue, without copying it. The default implementation samples from a copy,
+     * derived classes should override it if they can sample without copying.
+     */
+    virtual double get_rand_sample_const() const
+    {
+        std::unique_ptr<ParameterDistribution> copy(clone());
+        return copy->get_rand_sample();
+    }
+
     virtual ParameterDistribution* clone() const = 0;
 
     /**
@@ -299,23 +312,23 @@ public:
             m_distribution = std::normal_distribution<double>{m_mean, m_standard_dev};
         }
 
-        int i        = 0;
-        int retries  = 10;
-        double rnumb = m_distribution(thread_local_rng());
-        while ((rnumb > m_upper_bound || rnumb < m_lower_bound) && i < retries) {
-            rnumb = m_distribution(thread_local_rng());
-            i++;
-            if (i == retries) {
-                log_warning("Not successfully sampled within [min,max].");
-                if (rnumb > m_upper_bound) {
-                    rnumb = m_upper_bound;
-                }
-                else {
-                    rnumb = m_lower_bound;
-                }
-            }
+        return sample_within_bounds(m_distribution);
+    }
+
+    double get_rand_sample_const() const override
+    {
+        if (m_upper_bound == m_lower_bound) {
+            return m_lower_bound;
         }
-        return rnumb;
+
+        //the mean or standard deviation would be adapted before sampling, which changes this distribution
+        if (m_mean < m_lower_bound || m_mean > m_upper_bound || m_mean + m_standard_dev * m_quantile > m_upper_bound ||
+            m_mean - m_standard_dev * m_quantile < m_lower_bound) {
+            return ParameterDistribution::get_rand_sample_const();
+        }
+
+        auto distribution = std::normal_distribution<double>{m_mean, m_standard_dev};
+        return sample_within_bounds(distribution);
     }
 
     template <class IOContext>
@@ -352,6 +365,30 @@ public:
     }
 
 private:
+    /**
+     * draw samples until one is within the bounds, the sample is clamped to the bounds after some retries.
+     */
+    double sample_within_bounds(std::normal_distribution<double>& distribution) const
+    {
+        int i        = 0;
+        int retries  = 10;
+        double rnumb = distribution(thread_local_rng());
+        while ((rnumb > m_upper_bound || rnumb < m_lower_bound) && i < retries) {
+            rnumb = distribution(thread_local_rng());
+            i++;
+            if (i == retries) {
+                log_warning("Not successfully sampled within [min,max].");
+                if (rnumb > m_upper_bound) {
+                    rnumb = m_upper_bound;
+                }
+                else {
+                    rnumb = m_lower_bound;
+                }
+            }
+        }
+        return rnumb;
+    }
+
     double m_mean; // the mean value of the normal distribution
     double m_standard_dev; // the standard deviation of the normal distribution
     constexpr static double m_quantile = 2.5758; // 0.995 quartile
@@ -395,6 +432,12 @@ public:
         return m_distribution(thread_local_rng());
     }
 
+    double get_rand_sample_const() const override
+    {
+        auto distribution = std::uniform_real_distribution<double>{m_lower_bound, m_upper_bound};
+        return distribution(thread_local_rng());
+    }
+
     ParameterDistribution* clone() const override
     {
         return new ParameterDistributionUniform(*this);
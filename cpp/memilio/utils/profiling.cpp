@@ -0,0 +1,352 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/utils/profiling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+namespace mio
+{
+
+struct ProfilingRegistry::ThreadData {
+    struct Timer {
+        const char* name;
+        size_t parent;
+        std::vector<size_t> children;
+        size_t num_calls;
+        double total_time;
+        double min_time;
+        double max_time;
+    };
+
+    //times in microseconds since the start of the registry
+    struct TraceEvent {
+        size_t timer;
+        double start;
+        double duration;
+    };
+
+    ThreadData(std::thread::id thread_id, size_t thread_index)
+        : id(thread_id)
+        , index(thread_index)
+        , timers({Timer{"", 0, {}, 0, 0.0, 0.0, 0.0}})
+        , current(0)
+        , depth(0)
+    {
+    }
+
+    std::thread::id id;
+    size_t index;
+    std::vector<Timer> timers; //first timer is the root that encloses all scopes
+    size_t current;
+    size_t depth;
+    std::vector<std::pair<const char*, int64_t>> counters;
+    std::vector<TraceEvent> trace;
+};
+
+namespace
+{
+//identifies registries for the cache of the thread data, addresses may be reused
+size_t get_next_registry_id()
+{
+    static std::atomic<size_t> next_id{0};
+    return next_id++;
+}
+
+thread_local struct {
+    size_t registry_id = std::numeric_limits<size_t>::max();
+    ProfilingRegistry::ThreadData* data = nullptr;
+} thread_data_cache;
+
+//scopes of all threads, combined by path
+struct MergedTimer {
+    std::string name;
+    std::vector<MergedTimer> children;
+    ProfilingTimerStatistics statistics;
+};
+
+void merge_timers(const ProfilingRegistry::ThreadData& thread, size_t timer_idx, MergedTimer& merged)
+{
+    auto& timer = thread.timers[timer_idx];
+    auto& stats = merged.statistics;
+    if (timer.num_calls > 0) {
+        stats.min_time = stats.num_calls > 0 ? std::min(stats.min_time, timer.min_time) : timer.min_time;
+        stats.max_time = std::max(stats.max_time, timer.max_time);
+        stats.num_calls += timer.num_calls;
+        stats.total_time += timer.total_time;
+        ++stats.num_threads;
+    }
+    for (auto child_idx : thread.timers[timer_idx].children) {
+        auto& child = thread.timers[child_idx];
+        auto iter   = std::find_if(merged.children.begin(), merged.children.end(), [&child](auto& m) {
+            return m.name == child.name;
+        });
+        if (iter == merged.children.end()) {
+            auto path = merged.statistics.path.empty() ? std::string(child.name)
+                                                       : merged.statistics.path + "/" + child.name;
+            auto depth = merged.statistics.path.empty() ? size_t(0) : merged.statistics.depth + 1;
+            merged.children.push_back({child.name, {}, {path, depth, 0, 0, 0.0, 0.0, 0.0}});
+            iter = merged.children.end() - 1;
+        }
+        merge_timers(thread, child_idx, *iter);
+    }
+}
+
+void flatten_timers(const MergedTimer& merged, std::vector<ProfilingTimerStatistics>& statistics)
+{
+    for (auto& child : merged.children) {
+        statistics.push_back(child.statistics);
+        flatten_timers(child, statistics);
+    }
+}
+
+void write_json_string(std::ostream& os, const char* str)
+{
+    os << '"';
+    for (; *str != '\0'; ++str) {
+        if (*str == '"' || *str == '\\') {
+            os << '\\';
+        }
+        os << *str;
+    }
+    os << '"';
+}
+} // namespace
+
+ProfilingRegistry& ProfilingRegistry::get_instance()
+{
+    static ProfilingRegistry instance;
+    return instance;
+}
+
+ProfilingRegistry::ProfilingRegistry()
+    : m_id(get_next_registry_id())
+    , m_start_time(Clock::now())
+    , m_trace_enabled(false)
+    , m_trace_max_depth(std::numeric_limits<size_t>::max())
+{
+}
+
+ProfilingRegistry::~ProfilingRegistry() = default;
+
+ProfilingRegistry::ThreadData& ProfilingRegistry::get_thread_data()
+{
+    if (thread_data_cache.registry_id != m_id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto id   = std::this_thread::get_id();
+        auto iter = std::find_if(m_threads.begin(), m_threads.end(), [id](auto& t) {
+            return t->id == id;
+        });
+        if (iter == m_threads.end()) {
+            m_threads.push_back(std::make_unique<ThreadData>(id, m_threads.size()));
+            iter = m_threads.end() - 1;
+        }
+        thread_data_cache.registry_id = m_id;
+        thread_data_cache.data        = iter->get();
+    }
+    return *thread_data_cache.data;
+}
+
+void ProfilingRegistry::begin_scope(const char* name)
+{
+    auto& thread   = get_thread_data();
+    auto& children = thread.timers[thread.current].children;
+    auto iter      = std::find_if(children.begin(), children.end(), [&thread, name](auto child_idx) {
+        auto child_name = thread.timers[child_idx].name;
+        return child_name == name || std::strcmp(child_name, name) == 0;
+    });
+    if (iter != children.end()) {
+        thread.current = *iter;
+    }
+    else {
+        thread.timers.push_back({name, thread.current, {}, 0, 0.0, 0.0, 0.0});
+        auto new_idx = thread.timers.size() - 1;
+        thread.timers[thread.current].children.push_back(new_idx);
+        thread.current = new_idx;
+    }
+    ++thread.depth;
+}
+
+void ProfilingRegistry::end_scope(Clock::time_point start)
+{
+    auto end      = Clock::now();
+    auto& thread  = get_thread_data();
+    auto& timer   = thread.timers[thread.current];
+    auto duration = std::chrono::duration<double>(end - start).count();
+
+    timer.min_time = timer.num_calls > 0 ? std::min(timer.min_time, duration) : duration;
+    timer.max_time = std::max(timer.max_time, duration);
+    timer.total_time += duration;
+    ++timer.num_calls;
+
+    if (m_trace_enabled && thread.depth - 1 <= m_trace_max_depth) {
+        auto start_us = std::chrono::duration<double, std::micro>(start - m_start_time).count();
+        thread.trace.push_back({thread.current, start_us, duration * 1e6});
+    }
+
+    thread.current = timer.parent;
+    --thread.depth;
+}
+
+void ProfilingRegistry::add_count(const char* name, int64_t value)
+{
+    auto& counters = get_thread_data().counters;
+    auto iter      = std::find_if(counters.begin(), counters.end(), [name](auto& c) {
+        return c.first == name || std::strcmp(c.first, name) == 0;
+    });
+    if (iter != counters.end()) {
+        iter->second += value;
+    }
+    else {
+        counters.emplace_back(name, value);
+    }
+}
+
+void ProfilingRegistry::set_trace_enabled(bool enabled, size_t max_depth)
+{
+    m_trace_enabled   = enabled;
+    m_trace_max_depth = max_depth;
+}
+
+std::vector<ProfilingTimerStatistics> ProfilingRegistry::get_timer_statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MergedTimer root{"", {}, {"", 0, 0, 0, 0.0, 0.0, 0.0}};
+    for (auto& thread : m_threads) {
+        merge_timers(*thread, 0, root);
+    }
+    std::vector<ProfilingTimerStatistics> statistics;
+    flatten_timers(root, statistics);
+    return statistics;
+}
+
+std::vector<ProfilingCounterStatistics> ProfilingRegistry::get_counter_statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ProfilingCounterStatistics> statistics;
+    for (auto& thread : m_threads) {
+        for (auto& counter : thread->counters) {
+            auto iter = std::find_if(statistics.begin(), statistics.end(), [&counter](auto& s) {
+                return s.name == counter.first;
+            });
+            if (iter != statistics.end()) {
+                iter->value += counter.second;
+            }
+            else {
+                statistics.push_back({counter.first, counter.second});
+            }
+        }
+    }
+    std::sort(statistics.begin(), statistics.end(), [](auto& a, auto& b) {
+        return a.name < b.name;
+    });
+    return statistics;
+}
+
+void ProfilingRegistry::print_summary(std::ostream& os) const
+{
+    auto timers   = get_timer_statistics();
+    auto counters = get_counter_statistics();
+
+    //scopes are indented by depth and only show the last name of their path
+    std::vector<std::string> labels;
+    size_t width = 5;
+    for (auto& timer : timers) {
+        auto name = timer.path.substr(timer.path.find_last_of('/') + 1);
+        labels.push_back(std::string(2 * timer.depth, ' ') + name);
+        width = std::max(width, labels.back().size());
+    }
+    for (auto& counter : counters) {
+        width = std::max(width, counter.name.size());
+    }
+
+    auto flags     = os.flags();
+    auto precision = os.precision();
+    os << std::left << std::setw(int(width)) << "Scope" << std::right << std::setw(12) << "Calls"
+       << std::setw(9) << "Threads" << std::setw(14) << "Total [s]" << std::setw(14) << "Mean [ms]"
+       << std::setw(14) << "Min [ms]" << std::setw(14) << "Max [ms]" << '\n';
+    os << std::fixed << std::setprecision(4);
+    for (size_t i = 0; i < timers.size(); ++i) {
+        auto& timer = timers[i];
+        os << std::left << std::setw(int(width)) << labels[i] << std::right << std::setw(12) << timer.num_calls
+           << std::setw(9) << timer.num_threads << std::setw(14) << timer.total_time << std::setw(14)
+           << 1e3 * timer.total_time / double(std::max(timer.num_calls, size_t(1))) << std::setw(14)
+           << 1e3 * timer.min_time << std::setw(14) << 1e3 * timer.max_time << '\n';
+    }
+    if (!counters.empty()) {
+        os << '\n' << std::left << std::setw(int(width)) << "Counter" << std::right << std::setw(12) << "Value" << '\n';
+        for (auto& counter : counters) {
+            os << std::left << std::setw(int(width)) << counter.name << std::right << std::setw(12) << counter.value
+               << '\n';
+        }
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+IOResult<void> ProfilingRegistry::write_chrome_trace(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    file << "{\"traceEvents\":[";
+    file << std::fixed << std::setprecision(3);
+    auto first = true;
+    for (auto& thread : m_threads) {
+        for (auto& event : thread->trace) {
+            file << (first ? "\n" : ",\n") << "{\"name\":";
+            write_json_string(file, thread->timers[event.timer].name);
+            file << ",\"cat\":\"memilio\",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration
+                 << ",\"pid\":0,\"tid\":" << thread->index << "}";
+            first = false;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!file) {
+        return failure(StatusCode::UnknownError, "Failed to write trace to " + filename);
+    }
+    return success();
+}
+
+void ProfilingRegistry::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& thread : m_threads) {
+        for (auto& timer : thread->timers) {
+            timer.num_calls  = 0;
+            timer.total_time = 0.0;
+            timer.min_time   = 0.0;
+            timer.max_time   = 0.0;
+        }
+        thread->counters.clear();
+        thread->trace.clear();
+    }
+    m_start_time = Clock::now();
+}
+
+} // namespace mio
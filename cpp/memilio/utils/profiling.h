@@ -0,0 +1,219 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_UTILS_PROFILING_H
+#define MIO_UTILS_PROFILING_H
+
+#include "memilio/config.h"
+#include "memilio/io/io.h"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * @brief aggregated measurements of one timed scope.
+ * Scopes are identified by their path, i.e. the names of all enclosing timed scopes and their own name
+ * separated by '/', e.g. "GraphSimulation::advance/nodes/OdeIntegrator::advance".
+ */
+struct ProfilingTimerStatistics {
+    std::string path; ///< names of the enclosing scopes and the scope itself.
+    size_t depth; ///< number of enclosing timed scopes.
+    size_t num_calls; ///< number of times the scope was entered, summed over all threads.
+    size_t num_threads; ///< number of threads that entered the scope.
+    double total_time; ///< time spent in the scope in seconds, summed over all threads.
+    double min_time; ///< shortest time spent in the scope in seconds.
+    double max_time; ///< longest time spent in the scope in seconds.
+};
+
+/**
+ * @brief aggregated value of one counter.
+ */
+struct ProfilingCounterStatistics {
+    std::string name; ///< name of the counter.
+    int64_t value; ///< value of the counter, summed over all threads.
+};
+
+/**
+ * @brief collects the measurements of ScopedProfilingTimer and the values of counters.
+ * Each thread records into its own data, so measurements don't require synchronization.
+ * The data of all threads is combined when the statistics are queried, which must not happen
+ * while timed code is running on other threads, e.g., at the end of a run.
+ * The data of threads that have finished is kept.
+ * Names of scopes and counters must be string literals or otherwise outlive the registry.
+ * Usually, the registry is not used directly but through the macros MEMILIO_PROFILE_SCOPE and
+ * MEMILIO_PROFILE_COUNT, which are compiled out unless the cmake option MEMILIO_ENABLE_PROFILING is set.
+ */
+class ProfilingRegistry
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief the registry that is used by the profiling macros.
+     */
+    static ProfilingRegistry& get_instance();
+
+    ProfilingRegistry();
+    ~ProfilingRegistry();
+    ProfilingRegistry(const ProfilingRegistry&) = delete;
+    ProfilingRegistry& operator=(const ProfilingRegistry&) = delete;
+
+    /**
+     * @brief enter a timed scope on the calling thread.
+     * Scopes must be left in reverse order, see ScopedProfilingTimer.
+     * @param name name of the scope.
+     */
+    void begin_scope(const char* name);
+
+    /**
+     * @brief leave the innermost timed scope of the calling thread.
+     * @param start time the scope was entered.
+     */
+    void end_scope(Clock::time_point start);
+
+    /**
+     * @brief add a value to a counter of the calling thread.
+     * @param name name of the counter.
+     * @param value value added to the counter.
+     */
+    void add_count(const char* name, int64_t value);
+
+    /**
+     * @brief record every single scope in addition to the aggregated times, required for write_chrome_trace.
+     * Requires memory for every single scope, so this may only be feasible for short runs or coarse scopes.
+     * @param enabled true to record scopes, false to stop recording.
+     * @param max_depth scopes with more enclosing timed scopes are not recorded, e.g., right hand side evaluations.
+     */
+    void set_trace_enabled(bool enabled, size_t max_depth = std::numeric_limits<size_t>::max());
+
+    /**
+     * @brief the measurements of all scopes, combined for all threads.
+     * Sorted depth first, so each scope is followed by the scopes it encloses.
+     */
+    std::vector<ProfilingTimerStatistics> get_timer_statistics() const;
+
+    /**
+     * @brief the values of all counters, combined for all threads, sorted by name.
+     */
+    std::vector<ProfilingCounterStatistics> get_counter_statistics() const;
+
+    /**
+     * @brief print a table of the timer statistics and the counters.
+     * @param os stream that the table is written to.
+     */
+    void print_summary(std::ostream& os) const;
+
+    /**
+     * @brief write the recorded scopes in the chrome trace event format.
+     * The file can be viewed in chrome://tracing or https://ui.perfetto.dev.
+     * @see set_trace_enabled
+     * @param filename name of the file.
+     */
+    IOResult<void> write_chrome_trace(const std::string& filename) const;
+
+    /**
+     * @brief reset all measurements and counters, e.g., between benchmark runs.
+     * Scopes that are currently entered can still be left.
+     */
+    void clear();
+
+    struct ThreadData;
+
+private:
+    ThreadData& get_thread_data();
+
+    size_t m_id;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadData>> m_threads;
+    Clock::time_point m_start_time;
+    bool m_trace_enabled;
+    size_t m_trace_max_depth;
+};
+
+/**
+ * @brief measures the time from construction to destruction.
+ * Scopes that are entered while another timer of the same thread exists are recorded as enclosed in its scope.
+ */
+class ScopedProfilingTimer
+{
+public:
+    /**
+     * @brief enter the timed scope.
+     * @param name name of the scope, must be a string literal.
+     * @param registry registry that records the measurement.
+     */
+    explicit ScopedProfilingTimer(const char* name,
+                                  ProfilingRegistry& registry = ProfilingRegistry::get_instance())
+        : m_registry(registry)
+    {
+        m_registry.begin_scope(name);
+        m_start = ProfilingRegistry::Clock::now();
+    }
+
+    ~ScopedProfilingTimer()
+    {
+        m_registry.end_scope(m_start);
+    }
+
+    ScopedProfilingTimer(const ScopedProfilingTimer&) = delete;
+    ScopedProfilingTimer& operator=(const ScopedProfilingTimer&) = delete;
+
+private:
+    ProfilingRegistry& m_registry;
+    ProfilingRegistry::Clock::time_point m_start;
+};
+
+} // namespace mio
+
+#define MEMILIO_PROFILE_CONCAT_(a, b) a##b
+#define MEMILIO_PROFILE_CONCAT(a, b) MEMILIO_PROFILE_CONCAT_(a, b)
+
+#ifdef MEMILIO_ENABLE_PROFILING
+
+/**
+ * @brief measure the time until the end of the enclosing block, see ScopedProfilingTimer.
+ * @param name name of the scope, must be a string literal.
+ */
+#define MEMILIO_PROFILE_SCOPE(name)                                                                                    \
+    ::mio::ScopedProfilingTimer MEMILIO_PROFILE_CONCAT(mio_profile_scope_, __LINE__)(name)
+
+/**
+ * @brief add a value to a counter, see ProfilingRegistry::add_count.
+ * @param name name of the counter, must be a string literal.
+ * @param value value added to the counter.
+ */
+#define MEMILIO_PROFILE_COUNT(name, value) ::mio::ProfilingRegistry::get_instance().add_count(name, value)
+
+#else
+
+#define MEMILIO_PROFILE_SCOPE(name) static_cast<void>(0)
+#define MEMILIO_PROFILE_COUNT(name, value) static_cast<void>(sizeof(value))
+
+#endif
+
+#endif // MIO_UTILS_PROFILING_H
@@ -127,6 +127,23 @@ public:
         return value_matrix;
     }
 
+    /**
+     * @brief copy of this TimeSeries with time and values converted to a different floating point type.
+     * E.g. results computed in double precision can be stored as float to halve the memory of large ensembles.
+     * @tparam FP2 floating point type of the new TimeSeries.
+     * @return converted TimeSeries with the same number of time points and elements.
+     */
+    template <class FP2>
+    TimeSeries<FP2> cast() const
+    {
+        TimeSeries<FP2> converted(get_num_elements());
+        converted.reserve(m_num_time_points);
+        for (Eigen::Index i = 0; i < m_num_time_points; ++i) {
+            converted.add_time_point(static_cast<FP2>(get_time(i)), get_value(i).template cast<FP2>());
+        }
+        return converted;
+    }
+
     /** copy assignment */
     TimeSeries& operator=(const TimeSeries& other)
     {
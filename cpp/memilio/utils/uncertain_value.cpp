@@ -27,8 +27,16 @@ void UncertainValue::set_distribution(const ParameterDistribution& dist)
     m_dist.reset(dist.clone());
 }
 
+void UncertainValue::detach_distribution()
+{
+    if (m_dist && m_dist.use_count() > 1) {
+        m_dist.reset(m_dist->clone());
+    }
+}
+
 observer_ptr<ParameterDistribution> UncertainValue::get_distribution()
 {
+    detach_distribution();
     return m_dist.get();
 }
 
@@ -40,7 +48,14 @@ observer_ptr<const ParameterDistribution> UncertainValue::get_distribution() con
 double UncertainValue::draw_sample()
 {
     if (m_dist) {
-        m_value = m_dist->get_sample();
+        if (m_dist.use_count() > 1 && m_dist->get_predefined_samples().empty()) {
+            //sampling a shared distribution without predefined samples does not change it, so it is not copied
+            m_value = m_dist->get_rand_sample_const();
+        }
+        else {
+            detach_distribution();
+            m_value = m_dist->get_sample();
+        }
     }
 
     return m_value;
@@ -39,6 +39,11 @@ namespace mio
  * The uncertainty is represented by a distribution object of kind
  * ParameterDistribution and the current scalar value can be 
  * replaced by drawing a new sample from the the distribution
+ *
+ * Copies of an UncertainValue share the same distribution object, so copying a model does not allocate
+ * for distributions. The distribution is copied when it is modified through a copy (copy-on-write), i.e.
+ * by non-const access with get_distribution() or by draw_sample() with predefined samples, so copies behave
+ * like independent values. Random samples are drawn from a shared distribution without copying it.
  */
 class UncertainValue
 {
@@ -54,31 +59,19 @@ public:
     {
     }
 
-    UncertainValue(UncertainValue&& other) = default;
-
     /**
-    * @brief Create an UncertainValue by cloning scalar value 
-    *        and distribution of another UncertainValue
+    * @brief Create an UncertainValue by copying the scalar value 
+    *        and sharing the distribution of another UncertainValue
     */
-    UncertainValue(const UncertainValue& other)
-        : m_value(other.m_value)
-    {
-        if (other.m_dist) {
-            m_dist.reset(other.m_dist->clone());
-        }
-    }
+    UncertainValue(const UncertainValue& other) = default;
+    UncertainValue(UncertainValue&& other)      = default;
 
     /**
     * @brief Set an UncertainValue from another UncertainValue
     *        containing a scalar and a distribution
     */
-    UncertainValue& operator=(const UncertainValue& other)
-    {
-        UncertainValue tmp(other);
-        m_value = tmp.m_value;
-        std::swap(m_dist, tmp.m_dist);
-        return *this;
-    }
+    UncertainValue& operator=(const UncertainValue& other) = default;
+    UncertainValue& operator=(UncertainValue&& other) = default;
 
     /**
      * @brief Conversion to scalar by returning the scalar contained in UncertainValue
@@ -128,6 +121,11 @@ public:
      * @brief Returns the parameter distribution.
      *
      * If it is not set, a nullptr is returned.
+     * If the distribution is shared with copies of this value, it is copied first,
+     * so changes only affect this value. Use the const overload for read only access.
+     * The returned pointer must not be used to modify the distribution after this value has been copied,
+     * because the copy shares the distribution and would be modified as well. Call this function again
+     * after copying instead.
      */
     observer_ptr<ParameterDistribution> get_distribution();
 
@@ -136,6 +134,9 @@ public:
      *        and returns the new value
      *
      * If no distribution is set, the value is not changed.
+     * Predefined samples are used first. Using them changes the distribution, so a distribution
+     * that is shared with copies of this value is copied first. Otherwise, a shared distribution is
+     * sampled without copying it, see ParameterDistribution::get_rand_sample_const().
      */
     ScalarType draw_sample();
 
@@ -206,8 +207,13 @@ public:
     }
 
 private:
+    /**
+     * @brief make the distribution unique to this value before it is modified.
+     */
+    void detach_distribution();
+
     ScalarType m_value;
-    std::unique_ptr<ParameterDistribution> m_dist;
+    std::shared_ptr<ParameterDistribution> m_dist; //shared between copies, only modified if unique
 };
 
 //gtest printer
@@ -22,6 +22,7 @@
 #include "abm/person.h"
 #include "abm/location.h"
 #include "abm/migration_rules.h"
+#include "memilio/utils/profiling.h"
 #include "memilio/utils/random_number_generator.h"
 #include "memilio/utils/stl_util.h"
 
@@ -50,14 +51,19 @@ Person& World::add_person(LocationId id, InfectionState infection_state, AgeGrou
 
 void World::evolve(TimePoint t, TimeSpan dt)
 {
+    MEMILIO_PROFILE_SCOPE("abm::World::evolve");
     begin_step(t, dt);
     interaction(t, dt);
-    m_testing_strategy.update_activity_status(t);
+    {
+        MEMILIO_PROFILE_SCOPE("update_testing");
+        m_testing_strategy.update_activity_status(t);
+    }
     migration(t, dt);
 }
 
 void World::interaction(TimePoint /*t*/, TimeSpan dt)
 {
+    MEMILIO_PROFILE_SCOPE("interaction");
     for (auto&& person : m_persons) {
         auto& loc = get_location(*person);
         person->interact(dt, m_infection_parameters, loc);
@@ -74,6 +80,7 @@ void World::set_infection_state(Person& person, InfectionState inf_state)
 
 void World::migration(TimePoint t, TimeSpan dt)
 {
+    MEMILIO_PROFILE_SCOPE("migration");
     for (auto&& person : m_persons) {
         for (auto rule : m_migration_rules) {
             //check if transition rule can be applied
@@ -113,6 +120,7 @@ void World::migration(TimePoint t, TimeSpan dt)
 
 void World::begin_step(TimePoint /*t*/, TimeSpan dt)
 {
+    MEMILIO_PROFILE_SCOPE("begin_step");
     for (auto&& locations : m_locations) {
         for (auto& location : locations) {
             location.begin_step(dt, m_infection_parameters);
@@ -23,6 +23,8 @@
 #include "ide_seir/parameters.h"
 #include "ide_seir/infection_state.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 namespace mio
@@ -58,17 +60,35 @@ double IdeSeirModel::central_difference_quotient(TimeSeries<double> const& ts_id
     return (ts_ide[idx + 1][Eigen::Index(compartment)] - ts_ide[idx - 1][Eigen::Index(compartment)]) / (2 * m_dt);
 }
 
-double IdeSeirModel::num_integration_inner_integral(Eigen::Index idx) const
+void IdeSeirModel::tabulate_generalized_beta_distribution()
 {
-    double res     = 0.5 * (generalized_beta_distribution(m_result.get_time(idx) - m_result.get_time(idx - m_k)) *
-                            central_difference_quotient(m_result, InfectionState::S, m_k) +
-                        generalized_beta_distribution(m_result.get_time(idx) - m_result.get_time(idx - m_l)) *
-                            central_difference_quotient(m_result, InfectionState::S, idx - m_l));
-    Eigen::Index i = idx - m_k + 1;
-    while (i <= idx - m_l - 2) {
-        res += (generalized_beta_distribution(m_result.get_time(idx) - m_result.get_time(i)) *
-                central_difference_quotient(m_result, InfectionState::S, i));
-        ++i;
+    m_beta_distribution_k = generalized_beta_distribution(m_k * m_dt);
+    m_beta_distribution_l = generalized_beta_distribution(m_l * m_dt);
+    m_beta_distribution_reversed.resize(std::max(m_k - m_l - 2, Eigen::Index(0)));
+    for (Eigen::Index j = 0; j < m_beta_distribution_reversed.size(); ++j) {
+        m_beta_distribution_reversed[j] = generalized_beta_distribution((m_k - 1 - j) * m_dt);
+    }
+}
+
+double IdeSeirModel::num_integration_inner_integral(Eigen::Index idx)
+{
+    // central differences at index i require the value at i + 1
+    auto max_idx = std::max(m_k, idx - m_l);
+    assert(max_idx + 1 < m_result.get_num_time_points() && "Not enough time points for the inner integral.");
+    if (m_central_differences.empty()) {
+        // not used, the first time point does not have a central difference
+        m_central_differences.push_back(0.0);
+    }
+    for (auto i = Eigen::Index(m_central_differences.size()); i <= max_idx; ++i) {
+        m_central_differences.push_back(central_difference_quotient(m_result, InfectionState::S, i));
+    }
+
+    double res = 0.5 * (m_beta_distribution_k * m_central_differences[m_k] +
+                        m_beta_distribution_l * m_central_differences[idx - m_l]);
+    // sum over the indices idx - m_k + 1, ..., idx - m_l - 2
+    if (m_beta_distribution_reversed.size() > 0) {
+        res += m_beta_distribution_reversed.dot(Eigen::Map<const Eigen::VectorXd>(
+            m_central_differences.data() + idx - m_k + 1, m_beta_distribution_reversed.size()));
     }
     return res;
 }
@@ -83,23 +103,42 @@ TimeSeries<double> const& IdeSeirModel::simulate(int t_max)
                     "Start the data at time {:.4f} at the latest.",
                     -(m_k - 1) * m_dt);
     }
+    if (m_l < 2) {
+        // the inner integral at a new time point would need the derivative at a neighbour of the new time point,
+        // which is not computed yet, so the result would be wrong
+        log_error("Constraint check: Parameter LatencyTime {:.4f} smaller than two time steps {:.4f}. "
+                  "The model is not simulated.",
+                  parameters.get<LatencyTime>(), 2 * m_dt);
+        return m_result;
+    }
+    tabulate_generalized_beta_distribution();
+    m_central_differences.clear();
+
+    // R0t is the effective reproduction number at time t
+    auto& contact_matrix = parameters.get<ContactFrequency>().get_cont_freq_mat();
+    auto R0t             = [&](double t) {
+        return contact_matrix.get_matrix_at(t)(0, 0) * parameters.get<TransmissionRisk>() *
+               parameters.get<InfectiousTime>();
+    };
 
+    // the values at the previous time point are reused from the previous step
+    double R0t1 = 0, inner1 = 0;
+    if (m_result.get_last_time() < t_max) {
+        R0t1   = R0t(m_result.get_last_time());
+        inner1 = num_integration_inner_integral(m_result.get_num_time_points() - 1);
+    }
     while (m_result.get_last_time() < t_max) {
         m_result.add_time_point(m_result.get_last_time() + m_dt);
         Eigen::Index idx = m_result.get_num_time_points();
 
-        // R0t is the effective reproduction number at time t
-        auto R0t1 =
-            parameters.get<ContactFrequency>().get_cont_freq_mat().get_matrix_at(m_result.get_time(idx - 2))(0, 0) *
-            parameters.get<TransmissionRisk>() * parameters.get<InfectiousTime>();
-        auto R0t2 =
-            parameters.get<ContactFrequency>().get_cont_freq_mat().get_matrix_at(m_result.get_last_time())(0, 0) *
-            parameters.get<TransmissionRisk>() * parameters.get<InfectiousTime>();
+        auto R0t2   = R0t(m_result.get_last_time());
+        auto inner2 = num_integration_inner_integral(idx - 1);
 
         m_result.get_last_value() =
-            Vec::Constant(1, m_result[idx - 2][0] * exp(m_dt * (0.5 * 1 / m_N) *
-                                                        (R0t1 * num_integration_inner_integral(idx - 2) +
-                                                         R0t2 * num_integration_inner_integral(idx - 1))));
+            Vec::Constant(1, m_result[idx - 2][0] * exp(m_dt * (0.5 * 1 / m_N) * (R0t1 * inner1 + R0t2 * inner2)));
+
+        R0t1   = R0t2;
+        inner1 = inner2;
     }
     return m_result;
 }
@@ -57,6 +57,7 @@ public:
         *
         * The simulation is performed by solving the underlying model equation numerically. 
         * Here, an integro-differential equation is to be solved. The model parameters and the initial data are used.
+        * The LatencyTime must be at least two time steps, otherwise an error is logged and nothing is simulated.
         *
         * @param[in] t_max Last simulation day. 
         *   If the last point of time of the initial TimeSeries was 0, the simulation will be executed for t_max days.
@@ -117,11 +118,22 @@ private:
     /**
         * @brief Numerical integration of the inner integral of the integro-differential equation for the group S using
         *    a trapezoidal sum.
+        *
+        * Uses the tabulated values of the generalized beta distribution and the cached central differences, so the
+        * integral is a dot product over the support of the distribution.
+        * The central differences are extended to the indices that are required.
         * 
         * @param[in] idx Index of the point of time used in the inner integral.
         * @return Result of the numerical integration.
         */
-    double num_integration_inner_integral(Eigen::Index idx) const;
+    double num_integration_inner_integral(Eigen::Index idx);
+
+    /**
+        * @brief Tabulate the generalized beta distribution at multiples of the time step.
+        *
+        * Called at the start of the simulation, since the table depends on the parameters and the time step.
+        */
+    void tabulate_generalized_beta_distribution();
 
     // TimeSeries containing points of time and the corresponding number of susceptibles.
     TimeSeries<double> m_result;
@@ -137,6 +149,15 @@ private:
     // Two Indices used for simulation.
     Eigen::Index m_k{0};
     Eigen::Index m_l{0};
+
+    // Generalized beta distribution at the time differences (m_k - 1) * dt, ..., (m_l + 2) * dt in this order,
+    // so the sum of the inner integral is a dot product with consecutive central differences.
+    Eigen::VectorXd m_beta_distribution_reversed;
+    // Generalized beta distribution at the time differences m_k * dt and m_l * dt for the trapezoidal sum.
+    double m_beta_distribution_k{0};
+    double m_beta_distribution_l{0};
+    // Central difference quotients of S at each time index of m_result, computed once when the neighbors are known.
+    std::vector<double> m_central_differences;
 };
 } // namespace iseir
 } // namespace mio
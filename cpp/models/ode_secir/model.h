@@ -66,6 +66,7 @@ public:
         AgeGroup n_agegroups = params.get_num_groups();
 
         ContactMatrixGroup const& contact_matrix = params.get<ContactPatterns>();
+        auto const& cont_freq_mat                = contact_matrix.get_scheduled_matrix_at(t);
 
         auto icu_occupancy           = 0.0;
         auto test_and_trace_required = 0.0;
@@ -115,8 +116,8 @@ public:
                     (1 + params.get<Seasonality>() *
                              sin(3.141592653589793 * (std::fmod((params.get<StartDay>() + t), 365.0) / 182.5 + 0.5)));
                 double cont_freq_eff =
-                    season_val * contact_matrix.get_matrix_at(t)(static_cast<Eigen::Index>((size_t)i),
-                                                                 static_cast<Eigen::Index>((size_t)j));
+                    season_val *
+                    cont_freq_mat(static_cast<Eigen::Index>((size_t)i), static_cast<Eigen::Index>((size_t)j));
                 double Nj =
                     pop[Sj] + pop[Ej] + pop[INSj] + pop[ISyj] + pop[ISevj] + pop[ICrj] + pop[Rj]; // without died people
                 double divNj   = 1.0 / Nj; // precompute 1.0/Nj
@@ -157,6 +158,130 @@ public:
         }
     }
 
+protected:
+    /**
+     * @brief implementation of get_derivatives for a number of age groups that is known at compile time.
+     * All temporaries have a fixed size and loops over groups can be unrolled, see FixedSizeModel.
+     * Model itself does not use it, because temporaries of dynamic size would be allocated in every evaluation.
+     * @tparam NumGroups number of age groups.
+     */
+    template <int NumGroups>
+    void get_derivatives_impl(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
+                              Eigen::Ref<Eigen::VectorXd> dydt) const
+    {
+        // alpha  // percentage of asymptomatic cases
+        // beta // risk of infection from the infected symptomatic patients
+        // rho   // hospitalized per infectious
+        // theta // icu per hospitalized
+        // delta  // deaths per ICUs
+        // 0: S,      1: E,     2: C,     3: I,     4: H,     5: U,     6: R,     7: D
+        using GroupArray       = Eigen::Array<double, NumGroups, 1>;
+        using GroupMatrix      = Eigen::Matrix<double, NumGroups, NumGroups>;
+        constexpr int num_states = int(InfectionState::Count);
+        using CompartmentArray = Eigen::Array<double, num_states, NumGroups>;
+
+        auto const& params = this->parameters;
+        auto n_agegroups   = Eigen::Index((size_t)params.get_num_groups());
+        assert(NumGroups == Eigen::Dynamic || NumGroups == n_agegroups);
+
+        // compartments are stored by age group first, so each column contains one age group
+        Eigen::Map<const CompartmentArray> pop_c(pop.data(), num_states, n_agegroups);
+        Eigen::Map<const CompartmentArray> y_c(y.data(), num_states, n_agegroups);
+        Eigen::Map<CompartmentArray> dydt_c(dydt.data(), num_states, n_agegroups);
+        auto compartment = [](auto&& c, InfectionState s) {
+            return c.row(Eigen::Index(s)).transpose();
+        };
+
+        const GroupArray incubation_time       = get_group_values<NumGroups, IncubationTime>();
+        const GroupArray serial_interval       = get_group_values<NumGroups, SerialInterval>();
+        const GroupArray time_symptoms         = get_group_values<NumGroups, TimeInfectedSymptoms>();
+        const GroupArray time_severe           = get_group_values<NumGroups, TimeInfectedSevere>();
+        const GroupArray time_critical         = get_group_values<NumGroups, TimeInfectedCritical>();
+        const GroupArray transmission_prob     = get_group_values<NumGroups, TransmissionProbabilityOnContact>();
+        const GroupArray rel_transmission_ns   = get_group_values<NumGroups, RelativeTransmissionNoSymptoms>();
+        const GroupArray recovered_per_ns      = get_group_values<NumGroups, RecoveredPerInfectedNoSymptoms>();
+        const GroupArray risk_from_symptomatic = get_group_values<NumGroups, RiskOfInfectionFromSymptomatic>();
+        const GroupArray max_risk_symptomatic  = get_group_values<NumGroups, MaxRiskOfInfectionFromSymptomatic>();
+        const GroupArray severe_per_symptoms   = get_group_values<NumGroups, SeverePerInfectedSymptoms>();
+        const GroupArray critical_per_severe   = get_group_values<NumGroups, CriticalPerSevere>();
+        const GroupArray deaths_per_critical   = get_group_values<NumGroups, DeathsPerCritical>();
+        const GroupArray rateE                 = 1.0 / (2 * serial_interval - incubation_time); // R2 = 1/(2SI-TINC)
+        const GroupArray rateINS               = 0.5 / (incubation_time - serial_interval); // R3 = 1/(2(TINC-SI))
+
+        auto test_and_trace_required = ((1 - recovered_per_ns) * rateINS *
+                                        compartment(pop_c, InfectionState::InfectedNoSymptoms))
+                                           .sum();
+        auto icu_occupancy = compartment(pop_c, InfectionState::InfectedCritical).sum();
+
+        //symptomatic are less well quarantined when testing and tracing is overwhelmed so they infect more people
+        GroupArray risk_symptomatic_adjusted(n_agegroups);
+        // ICU capacity shortage is close
+        GroupArray critical_per_severe_adjusted(n_agegroups);
+        for (Eigen::Index i = 0; i < n_agegroups; ++i) {
+            risk_symptomatic_adjusted[i] = smoother_cosine(test_and_trace_required, params.get<TestAndTraceCapacity>(),
+                                                           params.get<TestAndTraceCapacity>() * 5,
+                                                           risk_from_symptomatic[i], max_risk_symptomatic[i]);
+            critical_per_severe_adjusted[i] = smoother_cosine(icu_occupancy, 0.90 * params.get<ICUCapacity>(),
+                                                              params.get<ICUCapacity>(), critical_per_severe[i], 0);
+        }
+        const GroupArray deaths_per_severe_adjusted = critical_per_severe - critical_per_severe_adjusted;
+
+        // effective contact rate by contact rate between groups i and j and damping j
+        double season_val =
+            (1 + params.get<Seasonality>() *
+                     sin(3.141592653589793 * (std::fmod((params.get<StartDay>() + t), 365.0) / 182.5 + 0.5)));
+        ContactMatrixGroup const& contact_matrix = params.get<ContactPatterns>();
+        const GroupMatrix cont_freq_eff          = season_val * contact_matrix.get_scheduled_matrix_at(t);
+        // infectious people of each group relative to the living people of the group
+        const GroupArray living_pop = pop_c.topRows(num_states - 1).colwise().sum().transpose(); // without died people
+        const GroupArray infectious_frac =
+            (rel_transmission_ns * compartment(pop_c, InfectionState::InfectedNoSymptoms) +
+             risk_symptomatic_adjusted * compartment(pop_c, InfectionState::InfectedSymptoms)) /
+            living_pop;
+        const GroupArray new_exposed = compartment(y_c, InfectionState::Susceptible) * transmission_prob *
+                                       (cont_freq_eff * infectious_frac.matrix()).array();
+
+        auto y_E    = compartment(y_c, InfectionState::Exposed);
+        auto y_INS  = compartment(y_c, InfectionState::InfectedNoSymptoms);
+        auto y_ISy  = compartment(y_c, InfectionState::InfectedSymptoms);
+        auto y_ISev = compartment(y_c, InfectionState::InfectedSevere);
+        auto y_ICr  = compartment(y_c, InfectionState::InfectedCritical);
+
+        compartment(dydt_c, InfectionState::Susceptible) = -new_exposed;
+        // only exchange of E and INS done here
+        compartment(dydt_c, InfectionState::Exposed)            = new_exposed - rateE * y_E;
+        compartment(dydt_c, InfectionState::InfectedNoSymptoms) = rateE * y_E - rateINS * y_INS;
+        compartment(dydt_c, InfectionState::InfectedSymptoms) =
+            (1 - recovered_per_ns) * rateINS * y_INS - (1 / time_symptoms) * y_ISy;
+        compartment(dydt_c, InfectionState::InfectedSevere) =
+            severe_per_symptoms / time_symptoms * y_ISy - (1 / time_severe) * y_ISev;
+        // add flow from hosp to icu according to potentially adjusted probability due to ICU limits
+        compartment(dydt_c, InfectionState::InfectedCritical) =
+            -(1 / time_critical) * y_ICr + critical_per_severe_adjusted / time_severe * y_ISev;
+        compartment(dydt_c, InfectionState::Recovered) =
+            recovered_per_ns * rateINS * y_INS + (1 - severe_per_symptoms) / time_symptoms * y_ISy +
+            (1 - critical_per_severe) / time_severe * y_ISev + (1 - deaths_per_critical) / time_critical * y_ICr;
+        // add potential, additional deaths due to ICU overflow
+        compartment(dydt_c, InfectionState::Dead) =
+            deaths_per_critical / time_critical * y_ICr + deaths_per_severe_adjusted / time_severe * y_ISev;
+    }
+
+private:
+    /**
+     * @brief copy the values of an age resolved parameter.
+     */
+    template <int NumGroups, class Tag>
+    Eigen::Array<double, NumGroups, 1> get_group_values() const
+    {
+        auto& values = this->parameters.template get<Tag>();
+        Eigen::Array<double, NumGroups, 1> result(Eigen::Index((size_t)values.template size<AgeGroup>()));
+        for (auto i = AgeGroup(0); i < values.template size<AgeGroup>(); ++i) {
+            result[Eigen::Index((size_t)i)] = values[i];
+        }
+        return result;
+    }
+
+public:
 #endif // USE_DERIV_FUNC
 
     /**
@@ -190,6 +315,59 @@ public:
     }
 };
 
+/**
+ * @brief secir model with a number of age groups that is fixed at compile time.
+ * Behaves like Model, but the right hand side is evaluated with fixed size temporaries and loops over age groups
+ * that can be unrolled, which is faster for small numbers of age groups, e.g., the 6 age groups of RKI data.
+ * The number of age groups of the populations and parameters must not be changed.
+ * @tparam NumAgeGroups number of age groups.
+ */
+template <int NumAgeGroups>
+class FixedSizeModel : public Model
+{
+public:
+    FixedSizeModel(const Populations& pop, const ParameterSet& params)
+        : Model(pop, params)
+    {
+        assert(Eigen::Index((size_t)params.get_num_groups()) == NumAgeGroups);
+    }
+
+    FixedSizeModel()
+        : Model(NumAgeGroups)
+    {
+    }
+
+    /**
+     * @brief create a model with a fixed number of age groups from a model with the same number of age groups.
+     */
+    explicit FixedSizeModel(const Model& model)
+        : FixedSizeModel(model.populations, model.parameters)
+    {
+    }
+
+#if USE_DERIV_FUNC
+    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
+                         Eigen::Ref<Eigen::VectorXd> dydt) const override
+    {
+        get_derivatives_impl<NumAgeGroups>(pop, y, t, dydt);
+    }
+#endif // USE_DERIV_FUNC
+
+    /**
+     * deserialize an object of this class.
+     * @see mio::deserialize
+     */
+    template <class IOContext>
+    static IOResult<FixedSizeModel> deserialize(IOContext& io)
+    {
+        BOOST_OUTCOME_TRY(model, Model::deserialize(io));
+        if (Eigen::Index((size_t)model.parameters.get_num_groups()) != NumAgeGroups) {
+            return failure(StatusCode::InvalidValue, "Number of age groups does not match the model.");
+        }
+        return success(FixedSizeModel(model));
+    }
+};
+
 //forward declaration, see below.
 template <class Base = mio::Simulation<Model>>
 class Simulation;
@@ -153,7 +153,8 @@ void draw_sample(Model& model)
 
 Graph<Model, MigrationParameters> draw_sample(Graph<Model, MigrationParameters>& graph)
 {
-    Graph<Model, MigrationParameters> sampled_graph;
+    GraphBuilder<Model, MigrationParameters> sampled_graph;
+    sampled_graph.reserve(graph.nodes().size(), graph.edges().size());
 
     //sample global parameters
     auto& shared_params_model = graph.nodes()[0].property;
@@ -194,7 +195,7 @@ Graph<Model, MigrationParameters> draw_sample(Graph<Model, MigrationParameters>&
         sampled_graph.add_edge(edge.start_node_idx, edge.end_node_idx, edge_params);
     }
 
-    return sampled_graph;
+    return sampled_graph.build();
 }
 
 } // namespace osecir
@@ -20,7 +20,7 @@
 
 #include "memilio/utils/compiler_diagnostics.h"
 
-//see below for line that causes this warning
+//some versions of gcc report false maybe-uninitialized warnings in included headers
 GCC_CLANG_DIAGNOSTIC(push)
 GCC_CLANG_DIAGNOSTIC(ignored "-Wmaybe-uninitialized")
 
@@ -60,19 +60,6 @@ namespace osecir
 
 namespace details
 {
-//county or state id of a data entry if available, 0 (for whole country) otherwise
-//used to compare data entries to integer ids in STL algorithms
-template <class EpiDataEntry>
-int get_region_id(const EpiDataEntry& entry)
-{
-    return entry.county_id ? entry.county_id->get() : (entry.state_id ? entry.state_id->get() : 0);
-}
-//overload for integers, so the comparison of data entry to integers is symmetric (required by e.g. equal_range)
-int get_region_id(int id)
-{
-    return id;
-}
-
 IOResult<void> read_confirmed_cases_data(
     std::string const& path, std::vector<int> const& vregion, Date date, std::vector<std::vector<double>>& vnum_Exposed,
     std::vector<std::vector<double>>& vnum_InfectedNoSymptoms, std::vector<std::vector<double>>& vnum_InfectedSymptoms,
@@ -84,96 +71,111 @@ IOResult<void> read_confirmed_cases_data(
     const std::vector<std::vector<double>>& vmu_I_H, const std::vector<std::vector<double>>& vmu_H_U,
     const std::vector<double>& scaling_factor_inf)
 {
-    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data(path));
-    auto max_date_entry = std::max_element(rki_data.begin(), rki_data.end(), [](auto&& a, auto&& b) {
-        return a.date < b.date;
-    });
-    if (max_date_entry == rki_data.end()) {
+    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data_table(path));
+    auto result = read_confirmed_cases_data(*rki_data, vregion, date, vnum_Exposed, vnum_InfectedNoSymptoms,
+                                            vnum_InfectedSymptoms, vnum_InfectedSevere, vnum_icu, vnum_death, vnum_rec,
+                                            vt_Exposed, vt_InfectedNoSymptoms, vt_InfectedSymptoms, vt_InfectedSevere,
+                                            vt_InfectedCritical, vmu_C_R, vmu_I_H, vmu_H_U, scaling_factor_inf);
+    if (!result) {
+        //add the file name to errors about the content
+        return failure(result.error().code(), path + ", " + result.error().message());
+    }
+    return result;
+}
+
+IOResult<void> read_confirmed_cases_data(
+    const EpiDataTable<ConfirmedCasesDataEntry>& rki_data, std::vector<int> const& vregion, Date date,
+    std::vector<std::vector<double>>& vnum_Exposed, std::vector<std::vector<double>>& vnum_InfectedNoSymptoms,
+    std::vector<std::vector<double>>& vnum_InfectedSymptoms, std::vector<std::vector<double>>& vnum_InfectedSevere,
+    std::vector<std::vector<double>>& vnum_icu, std::vector<std::vector<double>>& vnum_death,
+    std::vector<std::vector<double>>& vnum_rec, const std::vector<std::vector<int>>& vt_Exposed,
+    const std::vector<std::vector<int>>& vt_InfectedNoSymptoms,
+    const std::vector<std::vector<int>>& vt_InfectedSymptoms, const std::vector<std::vector<int>>& vt_InfectedSevere,
+    const std::vector<std::vector<int>>& vt_InfectedCritical, const std::vector<std::vector<double>>& vmu_C_R,
+    const std::vector<std::vector<double>>& vmu_I_H, const std::vector<std::vector<double>>& vmu_H_U,
+    const std::vector<double>& scaling_factor_inf)
+{
+    auto max_date = rki_data.get_max_date();
+    if (!max_date) {
         log_error("RKI data file is empty.");
-        return failure(StatusCode::InvalidFileFormat, path + ", file is empty.");
+        return failure(StatusCode::InvalidFileFormat, "RKI data file is empty.");
     }
-    auto max_date = max_date_entry->date;
-    if (max_date < date) {
+    if (*max_date < date) {
         log_error("Specified date does not exist in RKI data");
-        return failure(StatusCode::OutOfRange, path + ", specified date does not exist in RKI data.");
+        return failure(StatusCode::OutOfRange, "Specified date does not exist in RKI data.");
     }
-    auto days_surplus = std::min(get_offset_in_days(max_date, date) - 6, 0);
-
-    //this statement causes maybe-uninitialized warning for some versions of gcc.
-    //the error is reported in an included header, so the warning is disabled for the whole file
-    std::sort(rki_data.begin(), rki_data.end(), [](auto&& a, auto&& b) {
-        return std::make_tuple(get_region_id(a), a.date) < std::make_tuple(get_region_id(b), b.date);
-    });
+    auto days_surplus = std::min(get_offset_in_days(*max_date, date) - 6, 0);
 
     for (auto region_idx = size_t(0); region_idx < vregion.size(); ++region_idx) {
-        auto region_entry_range_it =
-            std::equal_range(rki_data.begin(), rki_data.end(), vregion[region_idx], [](auto&& a, auto&& b) {
-                return get_region_id(a) < get_region_id(b);
-            });
-        auto region_entry_range = make_range(region_entry_range_it);
-        if (region_entry_range.begin() == region_entry_range.end()) {
-            log_error("No entries found for region {}", vregion[region_idx]);
-            return failure(StatusCode::InvalidFileFormat,
-                           "No entries found for region " + std::to_string(vregion[region_idx]));
+        auto region = vregion[region_idx];
+        if (rki_data.get_entries(region).size() == 0) {
+            log_error("No entries found for region {}", region);
+            return failure(StatusCode::InvalidFileFormat, "No entries found for region " + std::to_string(region));
         }
-        for (auto&& region_entry : region_entry_range) {
 
-            auto& t_Exposed            = vt_Exposed[region_idx];
-            auto& t_InfectedNoSymptoms = vt_InfectedNoSymptoms[region_idx];
-            auto& t_InfectedSymptoms   = vt_InfectedSymptoms[region_idx];
-            auto& t_InfectedSevere     = vt_InfectedSevere[region_idx];
-            auto& t_InfectedCritical   = vt_InfectedCritical[region_idx];
+        auto& t_Exposed            = vt_Exposed[region_idx];
+        auto& t_InfectedNoSymptoms = vt_InfectedNoSymptoms[region_idx];
+        auto& t_InfectedSymptoms   = vt_InfectedSymptoms[region_idx];
+        auto& t_InfectedSevere     = vt_InfectedSevere[region_idx];
+        auto& t_InfectedCritical   = vt_InfectedCritical[region_idx];
 
-            auto& num_InfectedNoSymptoms = vnum_InfectedNoSymptoms[region_idx];
-            auto& num_InfectedSymptoms   = vnum_InfectedSymptoms[region_idx];
-            auto& num_rec                = vnum_rec[region_idx];
-            auto& num_Exposed            = vnum_Exposed[region_idx];
-            auto& num_InfectedSevere     = vnum_InfectedSevere[region_idx];
-            auto& num_death              = vnum_death[region_idx];
-            auto& num_icu                = vnum_icu[region_idx];
+        auto& num_InfectedNoSymptoms = vnum_InfectedNoSymptoms[region_idx];
+        auto& num_InfectedSymptoms   = vnum_InfectedSymptoms[region_idx];
+        auto& num_rec                = vnum_rec[region_idx];
+        auto& num_Exposed            = vnum_Exposed[region_idx];
+        auto& num_InfectedSevere     = vnum_InfectedSevere[region_idx];
+        auto& num_death              = vnum_death[region_idx];
+        auto& num_icu                = vnum_icu[region_idx];
 
-            auto& mu_C_R = vmu_C_R[region_idx];
-            auto& mu_I_H = vmu_I_H[region_idx];
-            auto& mu_H_U = vmu_H_U[region_idx];
+        auto& mu_C_R = vmu_C_R[region_idx];
+        auto& mu_I_H = vmu_I_H[region_idx];
+        auto& mu_H_U = vmu_H_U[region_idx];
 
-            auto date_df = region_entry.date;
-            auto age     = size_t(region_entry.age_group);
+        for (size_t age = 0; age < ConfirmedCasesDataEntry::age_group_names.size(); ++age) {
+            //look up the entries of the days that are required, instead of searching through all entries
+            auto for_each_entry = [&](int days, auto f) {
+                auto day = offset_date_by_days(date, days);
+                for (auto&& region_entry : rki_data.get_entries(region, day, AgeGroup(age))) {
+                    f(region_entry);
+                }
+            };
 
             bool read_icu = false; //params.populations.get({age, SecirCompartments::U}) == 0;
 
-            if (date_df == offset_date_by_days(date, 0)) {
+            for_each_entry(0, [&](auto&& region_entry) {
                 num_InfectedSymptoms[age] += scaling_factor_inf[age] * region_entry.num_confirmed;
                 num_rec[age] += region_entry.num_confirmed;
-            }
-            if (date_df == offset_date_by_days(date, days_surplus)) {
+            });
+            for_each_entry(days_surplus, [&](auto&& region_entry) {
                 num_InfectedNoSymptoms[age] -=
                     1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * region_entry.num_confirmed;
-            }
-            if (date_df == offset_date_by_days(date, t_InfectedNoSymptoms[age] + days_surplus)) {
+            });
+            for_each_entry(t_InfectedNoSymptoms[age] + days_surplus, [&](auto&& region_entry) {
                 num_InfectedNoSymptoms[age] +=
                     1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * region_entry.num_confirmed;
                 num_Exposed[age] -= 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * region_entry.num_confirmed;
-            }
-            if (date_df == offset_date_by_days(date, t_Exposed[age] + t_InfectedNoSymptoms[age] + days_surplus)) {
+            });
+            for_each_entry(t_Exposed[age] + t_InfectedNoSymptoms[age] + days_surplus, [&](auto&& region_entry) {
                 num_Exposed[age] += 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * region_entry.num_confirmed;
-            }
-            if (date_df == offset_date_by_days(date, -t_InfectedSymptoms[age])) {
+            });
+            for_each_entry(-t_InfectedSymptoms[age], [&](auto&& region_entry) {
                 num_InfectedSymptoms[age] -= scaling_factor_inf[age] * region_entry.num_confirmed;
                 num_InfectedSevere[age] += mu_I_H[age] * scaling_factor_inf[age] * region_entry.num_confirmed;
-            }
-            if (date_df == offset_date_by_days(date, -t_InfectedSymptoms[age] - t_InfectedSevere[age])) {
+            });
+            for_each_entry(-t_InfectedSymptoms[age] - t_InfectedSevere[age], [&](auto&& region_entry) {
                 num_InfectedSevere[age] -= mu_I_H[age] * scaling_factor_inf[age] * region_entry.num_confirmed;
                 if (read_icu) {
                     num_icu[age] += mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] * region_entry.num_confirmed;
                 }
-            }
-            if (date_df ==
-                offset_date_by_days(date, -t_InfectedSymptoms[age] - t_InfectedSevere[age] - t_InfectedCritical[age])) {
-                num_death[age] += region_entry.num_deaths;
-                if (read_icu) {
-                    num_icu[age] -= mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] * region_entry.num_confirmed;
-                }
-            }
+            });
+            for_each_entry(-t_InfectedSymptoms[age] - t_InfectedSevere[age] - t_InfectedCritical[age],
+                           [&](auto&& region_entry) {
+                               num_death[age] += region_entry.num_deaths;
+                               if (read_icu) {
+                                   num_icu[age] -= mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] *
+                                                   region_entry.num_confirmed;
+                               }
+                           });
         }
     }
 
@@ -297,29 +299,41 @@ IOResult<void> set_rki_data(std::vector<Model>& model, const std::string& path,
 IOResult<void> read_divi_data(const std::string& path, const std::vector<int>& vregion, Date date,
                               std::vector<double>& vnum_icu)
 {
-    BOOST_OUTCOME_TRY(divi_data, mio::read_divi_data(path));
+    BOOST_OUTCOME_TRY(divi_data, mio::read_divi_data_table(path));
+    auto result = read_divi_data(*divi_data, vregion, date, vnum_icu);
+    if (!result) {
+        //add the file name to errors about the content
+        return failure(result.error().code(), path + ", " + result.error().message());
+    }
+    return result;
+}
 
-    auto max_date_entry = std::max_element(divi_data.begin(), divi_data.end(), [](auto&& a, auto&& b) {
-        return a.date < b.date;
-    });
-    if (max_date_entry == divi_data.end()) {
+IOResult<void> read_divi_data(const EpiDataTable<DiviEntry>& divi_data, const std::vector<int>& vregion, Date date,
+                              std::vector<double>& vnum_icu)
+{
+    auto max_date = divi_data.get_max_date();
+    if (!max_date) {
         log_error("DIVI data file is empty.");
-        return failure(StatusCode::InvalidFileFormat, path + ", file is empty.");
+        return failure(StatusCode::InvalidFileFormat, "DIVI data file is empty.");
     }
-    auto max_date = max_date_entry->date;
-    if (max_date < date) {
+    if (*max_date < date) {
         log_error("Specified date does not exist in DIVI data.");
-        return failure(StatusCode::OutOfRange, path + ", specified date does not exist in DIVI data.");
+        return failure(StatusCode::OutOfRange, "Specified date does not exist in DIVI data.");
     }
 
-    for (auto&& entry : divi_data) {
-        auto it      = std::find_if(vregion.begin(), vregion.end(), [&entry](auto r) {
-            return r == 0 || r == get_region_id(entry);
-        });
-        auto date_df = entry.date;
-        if (it != vregion.end() && date_df == date) {
-            auto region_idx      = size_t(it - vregion.begin());
-            vnum_icu[region_idx] = entry.num_icu;
+    for (auto region_idx = size_t(0); region_idx < vregion.size(); ++region_idx) {
+        if (vregion[region_idx] == 0) {
+            //whole country, entries of any region
+            for (auto&& entry : divi_data.get_entries()) {
+                if (entry.date == date) {
+                    vnum_icu[region_idx] = entry.num_icu;
+                }
+            }
+        }
+        else {
+            for (auto&& entry : divi_data.get_entries(vregion[region_idx], date)) {
+                vnum_icu[region_idx] = entry.num_icu;
+            }
         }
     }
 
@@ -329,12 +343,17 @@ IOResult<void> read_divi_data(const std::string& path, const std::vector<int>& v
 IOResult<std::vector<std::vector<double>>> read_population_data(const std::string& path,
                                                                 const std::vector<int>& vregion)
 {
-    BOOST_OUTCOME_TRY(population_data, mio::read_population_data(path));
+    BOOST_OUTCOME_TRY(population_data, mio::read_population_data_table(path));
+    return read_population_data(*population_data, vregion);
+}
 
+IOResult<std::vector<std::vector<double>>>
+read_population_data(const EpiDataTable<PopulationDataEntry>& population_data, const std::vector<int>& vregion)
+{
     std::vector<std::vector<double>> vnum_population(
         vregion.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
 
-    for (auto&& entry : population_data) {
+    for (auto&& entry : population_data.get_entries()) {
         auto it = std::find_if(vregion.begin(), vregion.end(), [&entry](auto r) {
             return r == 0 ||
                    (entry.county_id && regions::de::StateId(r) == regions::de::get_state_id(*entry.county_id)) ||
@@ -55,6 +55,7 @@ void interpolate_ages(const std::vector<double>& age_ranges, std::vector<std::ve
 /**
      * @brief reads populations data from RKI
      * @param path Path to RKI file
+     * @param rki_data indexed table of RKI data, e.g. from mio::read_confirmed_cases_data_table
      * @param region vector of keys of the region of interest
      * @param year Specifies year at which the data is read
      * @param month Specifies month at which the data is read
@@ -62,7 +63,19 @@ void interpolate_ages(const std::vector<double>& age_ranges, std::vector<std::ve
      * @param num_* output vector for number of people in the corresponding compartement
      * @param t_* vector average time it takes to get from one compartement to another for each age group
      * @param mu_* vector probabilities to get from one compartement to another for each age group
+     * @{
      */
+IOResult<void> read_confirmed_cases_data(
+    const EpiDataTable<ConfirmedCasesDataEntry>& rki_data, std::vector<int> const& vregion, Date date,
+    std::vector<std::vector<double>>& vnum_Exposed, std::vector<std::vector<double>>& vnum_InfectedNoSymptoms,
+    std::vector<std::vector<double>>& vnum_InfectedSymptoms, std::vector<std::vector<double>>& vnum_InfectedSevere,
+    std::vector<std::vector<double>>& vnum_icu, std::vector<std::vector<double>>& vnum_death,
+    std::vector<std::vector<double>>& vnum_rec, const std::vector<std::vector<int>>& vt_Exposed,
+    const std::vector<std::vector<int>>& vt_InfectedNoSymptoms,
+    const std::vector<std::vector<int>>& vt_InfectedSymptoms, const std::vector<std::vector<int>>& vt_InfectedSevere,
+    const std::vector<std::vector<int>>& vt_InfectedCritical, const std::vector<std::vector<double>>& vmu_C_R,
+    const std::vector<std::vector<double>>& vmu_I_H, const std::vector<std::vector<double>>& vmu_H_U,
+    const std::vector<double>& scaling_factor_inf);
 IOResult<void> read_confirmed_cases_data(
     std::string const& path, std::vector<int> const& vregion, Date date, std::vector<std::vector<double>>& vnum_Exposed,
     std::vector<std::vector<double>>& vnum_InfectedNoSymptoms, std::vector<std::vector<double>>& vnum_InfectedSymptoms,
@@ -73,6 +86,7 @@ IOResult<void> read_confirmed_cases_data(
     const std::vector<std::vector<int>>& vt_InfectedCritical, const std::vector<std::vector<double>>& vmu_C_R,
     const std::vector<std::vector<double>>& vmu_I_H, const std::vector<std::vector<double>>& vmu_H_U,
     const std::vector<double>& scaling_factor_inf);
+/**@}*/
 
 /**
      * @brief sets populations data from RKI into a Model
@@ -90,14 +104,19 @@ IOResult<void> set_rki_data(std::vector<Model>& model, const std::string& path,
 /**
      * @brief reads number of ICU patients from DIVI register into Parameters
      * @param path Path to DIVI file
+     * @param divi_data indexed table of DIVI data, e.g. from mio::read_divi_data_table
      * @param vregion Keys of the region of interest
      * @param year Specifies year at which the data is read
      * @param month Specifies month at which the data is read
      * @param day Specifies day at which the data is read
      * @param vnum_icu number of ICU patients
+     * @{
      */
+IOResult<void> read_divi_data(const EpiDataTable<DiviEntry>& divi_data, const std::vector<int>& vregion, Date date,
+                              std::vector<double>& vnum_icu);
 IOResult<void> read_divi_data(const std::string& path, const std::vector<int>& vregion, Date date,
                               std::vector<double>& vnum_icu);
+/**@}*/
 
 /**
      * @brief sets populations data from DIVI register into Model
@@ -115,10 +134,15 @@ IOResult<void> set_divi_data(std::vector<Model>& model, const std::string& path,
 /**
      * @brief reads population data from census data
      * @param path Path to RKI file
+     * @param population_data indexed table of population data, e.g. from mio::read_population_data_table
      * @param vregion vector of keys of the regions of interest
+     * @{
      */
+IOResult<std::vector<std::vector<double>>>
+read_population_data(const EpiDataTable<PopulationDataEntry>& population_data, const std::vector<int>& vregion);
 IOResult<std::vector<std::vector<double>>> read_population_data(const std::string& path,
                                                                 const std::vector<int>& vregion);
+/**@}*/
 
 /**
      * @brief sets population data from census data
@@ -193,34 +217,59 @@ IOResult<void> export_input_data_county_timeseries(std::vector<Model>& model, co
         }
     }
 
+    // each file is read and indexed only once, each day is then a lookup in the tables
+    auto rki_path = path_join(data_dir, "cases_all_county_age_ma7.json");
+    BOOST_OUTCOME_TRY(rki_data_table, read_confirmed_cases_data_table(rki_path));
+    auto divi_path = path_join(data_dir, "county_divi_ma7.json");
+    BOOST_OUTCOME_TRY(divi_data_table, read_divi_data_table(divi_path));
+    auto population_path = path_join(data_dir, "county_current_population.json");
+    BOOST_OUTCOME_TRY(population_data_table, read_population_data_table(population_path));
+
+    //population does not depend on the date
+    auto population_result = details::read_population_data(*population_data_table, region);
+    if (!population_result) {
+        return failure(population_result.error().code(), population_path + ", " + population_result.error().message());
+    }
+    auto& num_population = population_result.value();
+
     std::vector<TimeSeries<double>> rki_data(
         region.size(), TimeSeries<double>::zero(num_days, (size_t)InfectionState::Count *
                                                               ConfirmedCasesDataEntry::age_group_names.size()));
 
-    for (size_t j = 0; j < static_cast<size_t>(num_days); j++) {
-        std::vector<std::vector<double>> num_InfectedSymptoms(
-            model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<std::vector<double>> num_death(
-            model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<std::vector<double>> num_rec(
+    //compartments read for each day, allocated once and reset every day
+    auto make_compartment = [&]() {
+        return std::vector<std::vector<double>>(
             model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<std::vector<double>> num_Exposed(
-            model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<std::vector<double>> num_InfectedNoSymptoms(
-            model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<std::vector<double>> num_InfectedSevere(
-            model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<std::vector<double>> dummy_icu(
-            model.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
-        std::vector<double> num_icu(model.size(), 0.0);
-
-        BOOST_OUTCOME_TRY(details::read_confirmed_cases_data(
-            path_join(data_dir, "cases_all_county_age_ma7.json"), region, date, num_Exposed, num_InfectedNoSymptoms,
-            num_InfectedSymptoms, num_InfectedSevere, dummy_icu, num_death, num_rec, t_Exposed, t_InfectedNoSymptoms,
-            t_InfectedSymptoms, t_InfectedSevere, t_InfectedCritical, mu_C_R, mu_I_H, mu_H_U, scaling_factor_inf));
-        BOOST_OUTCOME_TRY(details::read_divi_data(path_join(data_dir, "county_divi_ma7.json"), region, date, num_icu));
-        BOOST_OUTCOME_TRY(num_population,
-                          details::read_population_data(path_join(data_dir, "county_current_population.json"), region));
+    };
+    auto num_InfectedSymptoms   = make_compartment();
+    auto num_death              = make_compartment();
+    auto num_rec                = make_compartment();
+    auto num_Exposed            = make_compartment();
+    auto num_InfectedNoSymptoms = make_compartment();
+    auto num_InfectedSevere     = make_compartment();
+    auto dummy_icu              = make_compartment();
+    std::vector<double> num_icu(model.size(), 0.0);
+
+    for (size_t j = 0; j < static_cast<size_t>(num_days); j++) {
+        for (auto compartment : {&num_InfectedSymptoms, &num_death, &num_rec, &num_Exposed, &num_InfectedNoSymptoms,
+                                 &num_InfectedSevere, &dummy_icu}) {
+            for (auto&& county_compartment : *compartment) {
+                std::fill(county_compartment.begin(), county_compartment.end(), 0.0);
+            }
+        }
+        std::fill(num_icu.begin(), num_icu.end(), 0.0);
+
+        auto rki_result = details::read_confirmed_cases_data(
+            *rki_data_table, region, date, num_Exposed, num_InfectedNoSymptoms, num_InfectedSymptoms,
+            num_InfectedSevere, dummy_icu, num_death, num_rec, t_Exposed, t_InfectedNoSymptoms, t_InfectedSymptoms,
+            t_InfectedSevere, t_InfectedCritical, mu_C_R, mu_I_H, mu_H_U, scaling_factor_inf);
+        if (!rki_result) {
+            return failure(rki_result.error().code(), rki_path + ", " + rki_result.error().message());
+        }
+        auto divi_result = details::read_divi_data(*divi_data_table, region, date, num_icu);
+        if (!divi_result) {
+            return failure(divi_result.error().code(), divi_path + ", " + divi_result.error().message());
+        }
 
         for (size_t i = 0; i < region.size(); i++) {
             for (size_t age = 0; age < ConfirmedCasesDataEntry::age_group_names.size(); age++) {
@@ -54,6 +54,7 @@ public:
         AgeGroup n_agegroups = params.get_num_groups();
 
         ContactMatrixGroup const& contact_matrix = params.get<ContactPatterns>();
+        auto const& cont_freq_mat                = contact_matrix.get_scheduled_matrix_at(t);
 
         auto icu_occupancy           = 0.0;
         auto test_and_trace_required = 0.0;
@@ -187,8 +188,8 @@ public:
                     (1 + params.get<Seasonality>() *
                              sin(3.141592653589793 * (std::fmod((params.get<StartDay>() + t), 365.0) / 182.5 + 0.5)));
                 double cont_freq_eff =
-                    season_val * contact_matrix.get_matrix_at(t)(static_cast<Eigen::Index>((size_t)i),
-                                                                 static_cast<Eigen::Index>((size_t)j));
+                    season_val *
+                    cont_freq_mat(static_cast<Eigen::Index>((size_t)i), static_cast<Eigen::Index>((size_t)j));
                 // without died people
                 double Nj = pop[SNj] + pop[ENj] + pop[INSNj] + pop[ISyNj] + pop[ISevNj] + pop[ICrNj] + pop[INSNCj] +
                             pop[ISyNCj] + pop[SPIj] + pop[EPIj] + pop[INSPIj] + pop[ISyPIj] + pop[ISevPIj] +
@@ -452,6 +453,8 @@ public:
         auto SV    = (size_t)InfectionState::SusceptiblePartialImmunity;
         auto R     = (size_t)InfectionState::SusceptibleImprovedImmunity;
 
+        size_t num_corrected_first_vacc = 0;
+        size_t num_corrected_full_vacc  = 0;
         for (size_t i = 0; i < num_groups; ++i) {
 
             double first_vacc;
@@ -469,9 +472,10 @@ public:
 
             if (last_value(count * i + S) - first_vacc < 0) {
                 auto corrected = 0.99 * last_value(count * i + S);
-                log_warning("too many first vaccinated at time {}: setting first_vacc from {} to {}", t, first_vacc,
-                            corrected);
+                log_debug("too many first vaccinated at time {} in age group {}: setting first_vacc from {} to {}", t,
+                          i, first_vacc, corrected);
                 first_vacc = corrected;
+                ++num_corrected_first_vacc;
             }
 
             last_value(count * i + S) -= first_vacc;
@@ -479,14 +483,25 @@ public:
 
             if (last_value(count * i + SV) - full_vacc < 0) {
                 auto corrected = 0.99 * last_value(count * i + SV);
-                log_warning("too many fully vaccinated at time {}: setting full_vacc from {} to {}", t, full_vacc,
-                            corrected);
+                log_debug("too many fully vaccinated at time {} in age group {}: setting full_vacc from {} to {}", t,
+                          i, full_vacc, corrected);
                 full_vacc = corrected;
+                ++num_corrected_full_vacc;
             }
 
             last_value(count * i + SV) -= full_vacc;
             last_value(count * i + R) += full_vacc;
         }
+
+        //one message for all age groups, this is called for every node of a graph
+        if (num_corrected_first_vacc > 0) {
+            log_warning("too many first vaccinated at time {} in {} age groups, reduced to available susceptibles", t,
+                        num_corrected_first_vacc);
+        }
+        if (num_corrected_full_vacc > 0) {
+            log_warning("too many fully vaccinated at time {} in {} age groups, reduced to available susceptibles", t,
+                        num_corrected_full_vacc);
+        }
     }
 
     /**
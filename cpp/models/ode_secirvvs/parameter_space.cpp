@@ -130,7 +130,8 @@ void draw_sample(Model& model)
 
 Graph<Model, MigrationParameters> draw_sample(Graph<Model, MigrationParameters>& graph, bool variant_high)
 {
-    Graph<Model, MigrationParameters> sampled_graph;
+    GraphBuilder<Model, MigrationParameters> sampled_graph;
+    sampled_graph.reserve(graph.nodes().size(), graph.edges().size());
 
     //sample global parameters
     auto& shared_params_model = graph.nodes()[0].property;
@@ -189,7 +190,7 @@ Graph<Model, MigrationParameters> draw_sample(Graph<Model, MigrationParameters>&
         sampled_graph.add_edge(edge.start_node_idx, edge.end_node_idx, edge_params);
     }
 
-    return sampled_graph;
+    return sampled_graph.build();
 }
 
 } // namespace osecirvvs
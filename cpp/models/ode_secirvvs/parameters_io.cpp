@@ -51,12 +51,22 @@ namespace osecirvvs
 {
 namespace details
 {
-//gets the county or state id of the entry if available, 0 (for whole country) otherwise
-//used for comparisons of entry to integer region id
+//ids of the regions in the table that contribute to each of the regions of interest
+//entries of a region contribute to the first region of interest with the same id or to the whole country (id = 0)
 template <class EpiDataEntry>
-int get_region_id(const EpiDataEntry& rki_entry)
+std::vector<std::vector<int>> get_contributing_region_ids(const EpiDataTable<EpiDataEntry>& table,
+                                                          std::vector<int> const& vregion)
 {
-    return rki_entry.county_id ? rki_entry.county_id->get() : (rki_entry.state_id ? rki_entry.state_id->get() : 0);
+    std::vector<std::vector<int>> region_ids(vregion.size());
+    for (auto region_id : table.get_region_ids()) {
+        auto it = std::find_if(vregion.begin(), vregion.end(), [region_id](auto r) {
+            return r == 0 || r == region_id;
+        });
+        if (it != vregion.end()) {
+            region_ids[size_t(it - vregion.begin())].push_back(region_id);
+        }
+    }
+    return region_ids;
 }
 
 IOResult<void> read_confirmed_cases_data(
@@ -70,15 +80,15 @@ IOResult<void> read_confirmed_cases_data(
     const std::vector<std::vector<double>>& vmu_I_H, const std::vector<std::vector<double>>& vmu_H_U,
     const std::vector<double>& scaling_factor_inf)
 {
-    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data(path));
-    return read_confirmed_cases_data(rki_data, vregion, date, vnum_Exposed, vnum_InfectedNoSymptoms,
+    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data_table(path));
+    return read_confirmed_cases_data(*rki_data, vregion, date, vnum_Exposed, vnum_InfectedNoSymptoms,
                                      vnum_InfectedSymptoms, vnum_InfectedSevere, vnum_icu, vnum_death, vnum_rec,
                                      vt_Exposed, vt_InfectedNoSymptoms, vt_InfectedSymptoms, vt_InfectedSevere,
                                      vt_InfectedCritical, vmu_C_R, vmu_I_H, vmu_H_U, scaling_factor_inf);
 }
 
 IOResult<void> read_confirmed_cases_data(
-    const std::vector<ConfirmedCasesDataEntry>& rki_data, std::vector<int> const& vregion, Date date,
+    const EpiDataTable<ConfirmedCasesDataEntry>& rki_data, std::vector<int> const& vregion, Date date,
     std::vector<std::vector<double>>& vnum_Exposed, std::vector<std::vector<double>>& vnum_InfectedNoSymptoms,
     std::vector<std::vector<double>>& vnum_InfectedSymptoms, std::vector<std::vector<double>>& vnum_InfectedSevere,
     std::vector<std::vector<double>>& vnum_icu, std::vector<std::vector<double>>& vnum_death,
@@ -89,15 +99,12 @@ IOResult<void> read_confirmed_cases_data(
     const std::vector<std::vector<double>>& vmu_I_H, const std::vector<std::vector<double>>& vmu_H_U,
     const std::vector<double>& scaling_factor_inf)
 {
-    auto max_date_entry = std::max_element(rki_data.begin(), rki_data.end(), [](auto&& a, auto&& b) {
-        return a.date < b.date;
-    });
-    if (max_date_entry == rki_data.end()) {
+    auto max_date = rki_data.get_max_date();
+    if (!max_date) {
         log_error("RKI data file is empty.");
         return failure(StatusCode::InvalidValue, "RKI data is empty.");
     }
-    auto max_date = max_date_entry->date;
-    if (max_date < date) {
+    if (*max_date < date) {
         log_error("Specified date does not exist in RKI data");
         return failure(StatusCode::OutOfRange, "RKI data does not contain specified date.");
     }
@@ -105,69 +112,77 @@ IOResult<void> read_confirmed_cases_data(
     // shifts the initilization to the recent past if simulation starts
     // around current day and data of the future would be required.
     // Only needed for preinfection compartments, exposed and InfectedNoSymptoms.
-    auto days_surplus = get_offset_in_days(max_date, date) - 6; // 6 > T_E + T_C
+    auto days_surplus = get_offset_in_days(*max_date, date) - 6; // 6 > T_E + T_C
     if (days_surplus > 0) {
         days_surplus = 0;
     }
 
-    for (auto&& entry : rki_data) {
-        auto it = std::find_if(vregion.begin(), vregion.end(), [&entry](auto r) {
-            return r == 0 || get_region_id(entry) == r;
-        });
-        if (it != vregion.end()) {
-            auto region_idx = size_t(it - vregion.begin());
+    auto region_ids = get_contributing_region_ids(rki_data, vregion);
+    for (size_t region_idx = 0; region_idx < vregion.size(); ++region_idx) {
+        auto& t_Exposed            = vt_Exposed[region_idx];
+        auto& t_InfectedNoSymptoms = vt_InfectedNoSymptoms[region_idx];
+        auto& t_InfectedSymptoms   = vt_InfectedSymptoms[region_idx];
+        auto& t_InfectedSevere     = vt_InfectedSevere[region_idx];
+        auto& t_InfectedCritical   = vt_InfectedCritical[region_idx];
 
-            auto& t_Exposed            = vt_Exposed[region_idx];
-            auto& t_InfectedNoSymptoms = vt_InfectedNoSymptoms[region_idx];
-            auto& t_InfectedSymptoms   = vt_InfectedSymptoms[region_idx];
-            auto& t_InfectedSevere     = vt_InfectedSevere[region_idx];
-            auto& t_InfectedCritical   = vt_InfectedCritical[region_idx];
-
-            auto& num_InfectedNoSymptoms = vnum_InfectedNoSymptoms[region_idx];
-            auto& num_InfectedSymptoms   = vnum_InfectedSymptoms[region_idx];
-            auto& num_rec                = vnum_rec[region_idx];
-            auto& num_Exposed            = vnum_Exposed[region_idx];
-            auto& num_InfectedSevere     = vnum_InfectedSevere[region_idx];
-            auto& num_death              = vnum_death[region_idx];
-            auto& num_icu                = vnum_icu[region_idx];
-
-            auto& mu_C_R = vmu_C_R[region_idx];
-            auto& mu_I_H = vmu_I_H[region_idx];
-            auto& mu_H_U = vmu_H_U[region_idx];
-
-            bool read_icu = false; // params.populations.get({age, SecirCompartments::U}) == 0;
-
-            auto age = (size_t)entry.age_group;
-            if (entry.date == offset_date_by_days(date, 0)) {
-                num_InfectedSymptoms[age] += scaling_factor_inf[age] * entry.num_confirmed;
-                num_rec[age] += entry.num_confirmed;
-            }
-            if (entry.date == offset_date_by_days(date, t_InfectedNoSymptoms[age] + days_surplus)) {
-                num_InfectedNoSymptoms[age] += 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
-                num_Exposed[age] -= 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
-            }
-            if (entry.date == offset_date_by_days(date, days_surplus)) {
-                num_InfectedNoSymptoms[age] -= 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
-            }
-            if (entry.date == offset_date_by_days(date, t_Exposed[age] + t_InfectedNoSymptoms[age] + days_surplus)) {
-                num_Exposed[age] += 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
-            }
-            if (entry.date == offset_date_by_days(date, -t_InfectedSymptoms[age])) {
-                num_InfectedSymptoms[age] -= scaling_factor_inf[age] * entry.num_confirmed;
-                num_InfectedSevere[age] += mu_I_H[age] * scaling_factor_inf[age] * entry.num_confirmed;
-            }
-            if (entry.date == offset_date_by_days(date, -t_InfectedSymptoms[age] - t_InfectedSevere[age])) {
-                num_InfectedSevere[age] -= mu_I_H[age] * scaling_factor_inf[age] * entry.num_confirmed;
-                if (read_icu) {
-                    num_icu[age] += mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] * entry.num_confirmed;
-                }
-            }
-            if (entry.date ==
-                offset_date_by_days(date, -t_InfectedSymptoms[age] - t_InfectedSevere[age] - t_InfectedCritical[age])) {
-                num_death[age] += entry.num_deaths;
-                if (read_icu) {
-                    num_icu[age] -= mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] * entry.num_confirmed;
-                }
+        auto& num_InfectedNoSymptoms = vnum_InfectedNoSymptoms[region_idx];
+        auto& num_InfectedSymptoms   = vnum_InfectedSymptoms[region_idx];
+        auto& num_rec                = vnum_rec[region_idx];
+        auto& num_Exposed            = vnum_Exposed[region_idx];
+        auto& num_InfectedSevere     = vnum_InfectedSevere[region_idx];
+        auto& num_death              = vnum_death[region_idx];
+        auto& num_icu                = vnum_icu[region_idx];
+
+        auto& mu_C_R = vmu_C_R[region_idx];
+        auto& mu_I_H = vmu_I_H[region_idx];
+        auto& mu_H_U = vmu_H_U[region_idx];
+
+        bool read_icu = false; // params.populations.get({age, SecirCompartments::U}) == 0;
+
+        for (auto region_id : region_ids[region_idx]) {
+            for (size_t age = 0; age < ConfirmedCasesDataEntry::age_group_names.size(); ++age) {
+                //look up the entries of the days that are required, instead of searching through all entries
+                auto for_each_entry = [&](int days, auto f) {
+                    auto day = offset_date_by_days(date, days);
+                    for (auto&& entry : rki_data.get_entries(region_id, day, AgeGroup(age))) {
+                        f(entry);
+                    }
+                };
+
+                for_each_entry(0, [&](auto&& entry) {
+                    num_InfectedSymptoms[age] += scaling_factor_inf[age] * entry.num_confirmed;
+                    num_rec[age] += entry.num_confirmed;
+                });
+                for_each_entry(t_InfectedNoSymptoms[age] + days_surplus, [&](auto&& entry) {
+                    num_InfectedNoSymptoms[age] +=
+                        1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
+                    num_Exposed[age] -= 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
+                });
+                for_each_entry(days_surplus, [&](auto&& entry) {
+                    num_InfectedNoSymptoms[age] -=
+                        1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
+                });
+                for_each_entry(t_Exposed[age] + t_InfectedNoSymptoms[age] + days_surplus, [&](auto&& entry) {
+                    num_Exposed[age] += 1 / (1 - mu_C_R[age]) * scaling_factor_inf[age] * entry.num_confirmed;
+                });
+                for_each_entry(-t_InfectedSymptoms[age], [&](auto&& entry) {
+                    num_InfectedSymptoms[age] -= scaling_factor_inf[age] * entry.num_confirmed;
+                    num_InfectedSevere[age] += mu_I_H[age] * scaling_factor_inf[age] * entry.num_confirmed;
+                });
+                for_each_entry(-t_InfectedSymptoms[age] - t_InfectedSevere[age], [&](auto&& entry) {
+                    num_InfectedSevere[age] -= mu_I_H[age] * scaling_factor_inf[age] * entry.num_confirmed;
+                    if (read_icu) {
+                        num_icu[age] += mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] * entry.num_confirmed;
+                    }
+                });
+                for_each_entry(-t_InfectedSymptoms[age] - t_InfectedSevere[age] - t_InfectedCritical[age],
+                               [&](auto&& entry) {
+                                   num_death[age] += entry.num_deaths;
+                                   if (read_icu) {
+                                       num_icu[age] -= mu_I_H[age] * mu_H_U[age] * scaling_factor_inf[age] *
+                                                       entry.num_confirmed;
+                                   }
+                               });
             }
         }
     }
@@ -228,42 +243,29 @@ IOResult<void> read_confirmed_cases_data_fix_recovered(std::string const& path,
                                                        Date date, std::vector<std::vector<double>>& vnum_rec,
                                                        double delay)
 {
-    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data(path));
-    return read_confirmed_cases_data_fix_recovered(rki_data, vregion, date, vnum_rec, delay);
+    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data_table(path));
+    return read_confirmed_cases_data_fix_recovered(*rki_data, vregion, date, vnum_rec, delay);
 }
 
-IOResult<void> read_confirmed_cases_data_fix_recovered(const std::vector<ConfirmedCasesDataEntry>& rki_data,
+IOResult<void> read_confirmed_cases_data_fix_recovered(const EpiDataTable<ConfirmedCasesDataEntry>& rki_data,
                                                        std::vector<int> const& vregion, Date date,
                                                        std::vector<std::vector<double>>& vnum_rec, double delay)
 {
-    auto max_date_entry = std::max_element(rki_data.begin(), rki_data.end(), [](auto&& a, auto&& b) {
-        return a.date < b.date;
-    });
-    if (max_date_entry == rki_data.end()) {
+    auto max_date = rki_data.get_max_date();
+    if (!max_date) {
         log_error("RKI data is empty.");
         return failure(StatusCode::InvalidValue, "RKI data is empty.");
     }
-    auto max_date = max_date_entry->date;
-    if (max_date < date) {
+    if (*max_date < date) {
         log_error("Specified date does not exist in RKI data");
         return failure(StatusCode::OutOfRange, "RKI data does not contain specified date.");
     }
 
-    // shifts the initilization to the recent past if simulation starts
-    // around current day and data of the future would be required.
-    // Only needed for preinfection compartments, exposed and InfectedNoSymptoms.
-    auto days_surplus = get_offset_in_days(max_date, date) - 6; // 6 > T_E^C + T_C^I
-    if (days_surplus > 0) {
-        days_surplus = 0;
-    }
-
-    for (auto&& rki_entry : rki_data) {
-        auto it = std::find_if(vregion.begin(), vregion.end(), [&rki_entry](auto r) {
-            return r == 0 || get_region_id(rki_entry) == r;
-        });
-        if (it != vregion.end()) {
-            auto region_idx = size_t(it - vregion.begin());
-            if (rki_entry.date == offset_date_by_days(date, int(-delay))) {
+    auto region_ids    = get_contributing_region_ids(rki_data, vregion);
+    auto recovery_date = offset_date_by_days(date, int(-delay));
+    for (size_t region_idx = 0; region_idx < vregion.size(); ++region_idx) {
+        for (auto region_id : region_ids[region_idx]) {
+            for (auto&& rki_entry : rki_data.get_entries(region_id, recovery_date)) {
                 vnum_rec[region_idx][size_t(rki_entry.age_group)] = rki_entry.num_confirmed;
             }
         }
@@ -302,34 +304,29 @@ IOResult<void> read_confirmed_cases_data_fix_recovered(const std::vector<Confirm
 IOResult<void> read_divi_data(const std::string& path, const std::vector<int>& vregion, Date date,
                               std::vector<double>& vnum_icu)
 {
-    BOOST_OUTCOME_TRY(divi_data, mio::read_divi_data(path));
-    return read_divi_data(divi_data, vregion, date, vnum_icu);
+    BOOST_OUTCOME_TRY(divi_data, mio::read_divi_data_table(path));
+    return read_divi_data(*divi_data, vregion, date, vnum_icu);
 }
 
-IOResult<void> read_divi_data(const std::vector<DiviEntry>& divi_data, const std::vector<int>& vregion, Date date,
+IOResult<void> read_divi_data(const EpiDataTable<DiviEntry>& divi_data, const std::vector<int>& vregion, Date date,
                               std::vector<double>& vnum_icu)
 {
-    auto max_date_entry = std::max_element(divi_data.begin(), divi_data.end(), [](auto&& a, auto&& b) {
-        return a.date < b.date;
-    });
-    if (max_date_entry == divi_data.end()) {
+    auto max_date = divi_data.get_max_date();
+    if (!max_date) {
         log_error("DIVI data is empty.");
         return failure(StatusCode::InvalidValue, "DIVI data is empty.");
     }
-    auto max_date = max_date_entry->date;
-    if (max_date < date) {
+    if (*max_date < date) {
         log_error("DIVI data does not contain the specified date.");
         return failure(StatusCode::OutOfRange, "DIVI data does not contain the specified date.");
     }
 
-    for (auto&& entry : divi_data) {
-        auto it      = std::find_if(vregion.begin(), vregion.end(), [&entry](auto r) {
-            return r == 0 || r == get_region_id(entry);
-        });
-        auto date_df = entry.date;
-        if (it != vregion.end() && date_df == date) {
-            auto region_idx      = size_t(it - vregion.begin());
-            vnum_icu[region_idx] = entry.num_icu;
+    auto region_ids = get_contributing_region_ids(divi_data, vregion);
+    for (size_t region_idx = 0; region_idx < vregion.size(); ++region_idx) {
+        for (auto region_id : region_ids[region_idx]) {
+            for (auto&& entry : divi_data.get_entries(region_id, date)) {
+                vnum_icu[region_idx] = entry.num_icu;
+            }
         }
     }
 
@@ -339,17 +336,17 @@ IOResult<void> read_divi_data(const std::vector<DiviEntry>& divi_data, const std
 IOResult<std::vector<std::vector<double>>> read_population_data(const std::string& path,
                                                                 const std::vector<int>& vregion)
 {
-    BOOST_OUTCOME_TRY(population_data, mio::read_population_data(path));
-    return read_population_data(population_data, vregion);
+    BOOST_OUTCOME_TRY(population_data, mio::read_population_data_table(path));
+    return read_population_data(*population_data, vregion);
 }
 
-IOResult<std::vector<std::vector<double>>> read_population_data(const std::vector<PopulationDataEntry>& population_data,
-                                                                const std::vector<int>& vregion)
+IOResult<std::vector<std::vector<double>>>
+read_population_data(const EpiDataTable<PopulationDataEntry>& population_data, const std::vector<int>& vregion)
 {
     std::vector<std::vector<double>> vnum_population(
         vregion.size(), std::vector<double>(ConfirmedCasesDataEntry::age_group_names.size(), 0.0));
 
-    for (auto&& county_entry : population_data) {
+    for (auto&& county_entry : population_data.get_entries()) {
         //accumulate population of states or country from population of counties
         if (!county_entry.county_id) {
             return failure(StatusCode::InvalidFileFormat, "File with county population expected.");
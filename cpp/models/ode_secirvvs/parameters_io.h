@@ -46,6 +46,7 @@ namespace details
 /**
         * @brief Reads subpopulations of infection states from transformed RKI cases file.
         * @param path Path to transformed RKI cases file.
+        * @param rki_data indexed table of RKI cases, e.g. from mio::read_confirmed_cases_data_table.
         * @param vregion vector of keys of the region of interest     
         * @param date Date for which the arrays are initialized
         * @param num_* output vector for number of people in the corresponding compartement
@@ -67,7 +68,7 @@ IOResult<void> read_confirmed_cases_data(
     const std::vector<double>& scaling_factor_inf);
 
 IOResult<void> read_confirmed_cases_data(
-    const std::vector<ConfirmedCasesDataEntry>& rki_data, std::vector<int> const& vregion, Date date,
+    const EpiDataTable<ConfirmedCasesDataEntry>& rki_data, std::vector<int> const& vregion, Date date,
     std::vector<std::vector<double>>& num_Exposed, std::vector<std::vector<double>>& num_InfectedNoSymptoms,
     std::vector<std::vector<double>>& num_InfectedSymptoms, std::vector<std::vector<double>>& num_InfectedSevere,
     std::vector<std::vector<double>>& num_icu, std::vector<std::vector<double>>& num_death,
@@ -81,6 +82,7 @@ IOResult<void> read_confirmed_cases_data(
 /**
         * @brief Reads confirmed cases data and translates data of day t0-delay to recovered compartment,
         * @param path Path to RKI confirmed cases file.
+        * @param rki_data indexed table of RKI cases, e.g. from mio::read_confirmed_cases_data_table.
         * @param vregion vector of keys of the region of interest     
         * @param date Date for which the arrays are initialized
         * @param num_rec output vector for number of people in the compartement recovered
@@ -88,7 +90,7 @@ IOResult<void> read_confirmed_cases_data(
         * @see mio::read_confirmed_cases_data
         * @{
         */
-IOResult<void> read_confirmed_cases_data_fix_recovered(const std::vector<ConfirmedCasesDataEntry>& rki_data,
+IOResult<void> read_confirmed_cases_data_fix_recovered(const EpiDataTable<ConfirmedCasesDataEntry>& rki_data,
                                                        std::vector<int> const& vregion, Date date,
                                                        std::vector<std::vector<double>>& vnum_rec, double delay = 14.);
 IOResult<void> read_confirmed_cases_data_fix_recovered(std::string const& path, std::vector<int> const& vregion,
@@ -114,7 +116,8 @@ IOResult<void> set_confirmed_cases_data(std::vector<Model>& model, const std::st
     assert(scaling_factor_inf.size() == num_age_groups); //TODO: allow vector or scalar valued scaling factors
     assert(ConfirmedCasesDataEntry::age_group_names.size() == num_age_groups);
 
-    BOOST_OUTCOME_TRY(rki_data, mio::read_confirmed_cases_data(path));
+    BOOST_OUTCOME_TRY(rki_data_table, mio::read_confirmed_cases_data_table(path));
+    auto& rki_data = *rki_data_table;
 
     std::vector<std::vector<int>> t_Exposed{model.size()};
     std::vector<std::vector<int>> t_InfectedNoSymptoms{model.size()};
@@ -372,6 +375,7 @@ IOResult<void> set_confirmed_cases_data(std::vector<Model>& model, const std::st
 /**
         * @brief reads number of ICU patients from DIVI register into Parameters
         * @param path Path to transformed DIVI file
+        * @param divi_data indexed table of DIVI data, e.g. from mio::read_divi_data_table.
         * @param vregion Keys of the region of interest
         * @param date Date for which the arrays are initialized
         * @param vnum_icu number of ICU patients
@@ -380,7 +384,7 @@ IOResult<void> set_confirmed_cases_data(std::vector<Model>& model, const std::st
         */
 IOResult<void> read_divi_data(const std::string& path, const std::vector<int>& vregion, Date date,
                               std::vector<double>& vnum_icu);
-IOResult<void> read_divi_data(const std::vector<DiviEntry>& divi_data, const std::vector<int>& vregion, Date date,
+IOResult<void> read_divi_data(const EpiDataTable<DiviEntry>& divi_data, const std::vector<int>& vregion, Date date,
                               std::vector<double>& vnum_icu);
 /**@}*/
 
@@ -424,14 +428,15 @@ IOResult<void> set_divi_data(std::vector<Model>& model, const std::string& path,
 /**
         * @brief reads population data from census data.
         * @param path Path to population data file.
+        * @param population_data indexed table of population data, e.g. from mio::read_population_data_table.
         * @param vregion vector of keys of the regions of interest
         * @see mio::read_population_data
         * @{
         */
 IOResult<std::vector<std::vector<double>>> read_population_data(const std::string& path,
                                                                 const std::vector<int>& vregion);
-IOResult<std::vector<std::vector<double>>> read_population_data(const std::vector<PopulationDataEntry>& population_data,
-                                                                const std::vector<int>& vregion);
+IOResult<std::vector<std::vector<double>>>
+read_population_data(const EpiDataTable<PopulationDataEntry>& population_data, const std::vector<int>& vregion);
 /**@}*/
 
 template <class Model>
@@ -631,9 +636,17 @@ IOResult<void> export_input_data_county_timeseries(const std::vector<Model>& mod
     assert(num_age_groups == ConfirmedCasesDataEntry::age_group_names.size());
     assert(model.size() == region.size());
 
-    BOOST_OUTCOME_TRY(rki_data, read_confirmed_cases_data(path_join(data_dir, "cases_all_county_age_ma7.json")));
-    BOOST_OUTCOME_TRY(population_data, read_population_data(path_join(data_dir, "county_current_population.json")));
-    BOOST_OUTCOME_TRY(divi_data, read_divi_data(path_join(data_dir, "county_divi_ma7.json")));
+    // each file is read and indexed only once, each day is then a lookup in the tables
+    BOOST_OUTCOME_TRY(rki_data_table,
+                      read_confirmed_cases_data_table(path_join(data_dir, "cases_all_county_age_ma7.json")));
+    BOOST_OUTCOME_TRY(population_data_table,
+                      read_population_data_table(path_join(data_dir, "county_current_population.json")));
+    BOOST_OUTCOME_TRY(divi_data_table, read_divi_data_table(path_join(data_dir, "county_divi_ma7.json")));
+    auto& rki_data  = *rki_data_table;
+    auto& divi_data = *divi_data_table;
+
+    // population does not depend on the date
+    BOOST_OUTCOME_TRY(num_population, details::read_population_data(*population_data_table, region));
 
     /* functionality copy from set_confirmed_cases_data() here splitted in params */
     /* which do not need to be reset for each day and compartments sizes that are */
@@ -830,25 +843,60 @@ IOResult<void> export_input_data_county_timeseries(const std::vector<Model>& mod
     std::vector<TimeSeries<double>> extrapolated_rki(
         model.size(), TimeSeries<double>::zero(num_days + 1, (size_t)InfectionState::Count * num_age_groups));
 
+    // compartments read for each day, allocated once and reset every day
+    auto make_compartment = [&]() {
+        return std::vector<std::vector<double>>(model.size(), std::vector<double>(num_age_groups, 0.0));
+    };
+    // unvaccinated
+    auto num_Exposed_uv            = make_compartment();
+    auto num_InfectedNoSymptoms_uv = make_compartment();
+    auto num_InfectedSymptoms_uv   = make_compartment();
+    // potential TODO: these confirmed are only confirmed by commuting, set to zero here. Adapt if generalized!
+    auto num_InfectedNoSymptomsConfirmed_uv = make_compartment();
+    auto num_InfectedSymptomsConfirmed_uv   = make_compartment();
+    // end TODO
+    auto num_rec_uv            = make_compartment();
+    auto num_InfectedSevere_uv = make_compartment();
+    auto num_death_uv          = make_compartment();
+    // partially vaccinated
+    auto num_Exposed_pv            = make_compartment();
+    auto num_InfectedNoSymptoms_pv = make_compartment();
+    auto num_InfectedSymptoms_pv   = make_compartment();
+    auto num_InfectedSevere_pv     = make_compartment();
+    // potential TODO: these confirmed are only confirmed by commuting, set to zero here. Adapt if generalized!
+    auto num_InfectedNoSymptomsConfirmed_pv = make_compartment();
+    auto num_InfectedSymptomsConfirmed_pv   = make_compartment();
+    // end TODO
+    // fully vaccinated
+    auto num_Exposed_fv            = make_compartment();
+    auto num_InfectedNoSymptoms_fv = make_compartment();
+    auto num_InfectedSymptoms_fv   = make_compartment();
+    // potential TODO: these confirmed are only confirmed by commuting, set to zero here. Adapt if generalized!
+    auto num_InfectedNoSymptomsConfirmed_fv = make_compartment();
+    auto num_InfectedSymptomsConfirmed_fv   = make_compartment();
+    // end TODO
+    auto num_InfectedSevere_fv = make_compartment();
+    auto dummy_icu             = make_compartment();
+    auto dummy_death           = make_compartment();
+    auto dummy_rec             = make_compartment();
+    auto num_icu               = make_compartment();
+    auto num_rec               = make_compartment();
+    std::vector<double> dummy_icu2(model.size(), 0.0);
+
+    auto reset = [](std::vector<std::vector<double>>& compartment) {
+        for (auto&& county_compartment : compartment) {
+            std::fill(county_compartment.begin(), county_compartment.end(), 0.0);
+        }
+    };
+
     for (size_t day = 0; day <= static_cast<size_t>(num_days); day++) {
         auto date = offset_date_by_days(start_date, int(day));
 
         // unvaccinated
-        std::vector<std::vector<double>> num_Exposed_uv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedNoSymptoms_uv(model.size(),
-                                                                   std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSymptoms_uv(model.size(),
-                                                                 std::vector<double>(num_age_groups, 0.0));
-        // potential TODO: these confirmed are only confirmed by commuting, set to zero here. Adapt if generalized!
-        std::vector<std::vector<double>> num_InfectedNoSymptomsConfirmed_uv(model.size(),
-                                                                            std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSymptomsConfirmed_uv(model.size(),
-                                                                          std::vector<double>(num_age_groups, 0.0));
-        // end TODO
-        std::vector<std::vector<double>> num_rec_uv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSevere_uv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_death_uv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> dummy_icu(model.size(), std::vector<double>(num_age_groups, 0.0));
+        for (auto compartment : {&num_Exposed_uv, &num_InfectedNoSymptoms_uv, &num_InfectedSymptoms_uv, &num_rec_uv,
+                                 &num_InfectedSevere_uv, &num_death_uv, &dummy_icu}) {
+            reset(*compartment);
+        }
         BOOST_OUTCOME_TRY(details::read_confirmed_cases_data(
             rki_data, region, date, num_Exposed_uv, num_InfectedNoSymptoms_uv, num_InfectedSymptoms_uv,
             num_InfectedSevere_uv, dummy_icu, num_death_uv, num_rec_uv, t_Exposed_uv, t_InfectedNoSymptoms_uv,
@@ -856,23 +904,9 @@ IOResult<void> export_input_data_county_timeseries(const std::vector<Model>& mod
             scaling_factor_inf));
 
         // partially vaccinated
-        std::vector<std::vector<double>> num_Exposed_pv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedNoSymptoms_pv(model.size(),
-                                                                   std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSymptoms_pv(model.size(),
-                                                                 std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSevere_pv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        // potential TODO: these confirmed are only confirmed by commuting, set to zero here. Adapt if generalized!
-        std::vector<std::vector<double>> num_InfectedNoSymptomsConfirmed_pv(model.size(),
-                                                                            std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSymptomsConfirmed_pv(model.size(),
-                                                                          std::vector<double>(num_age_groups, 0.0));
-        // end TODO
-        std::vector<std::vector<double>> dummy_death(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> dummy_rec(model.size(), std::vector<double>(num_age_groups, 0.0));
-        for (size_t county = 0; county < model.size(); county++) {
-            dummy_death[county] = std::vector<double>(num_age_groups, 0.0);
-            dummy_icu[county]   = std::vector<double>(num_age_groups, 0.0);
+        for (auto compartment : {&num_Exposed_pv, &num_InfectedNoSymptoms_pv, &num_InfectedSymptoms_pv,
+                                 &num_InfectedSevere_pv, &dummy_icu, &dummy_death, &dummy_rec}) {
+            reset(*compartment);
         }
         BOOST_OUTCOME_TRY(details::read_confirmed_cases_data(
             rki_data, region, date, num_Exposed_pv, num_InfectedNoSymptoms_pv, num_InfectedSymptoms_pv,
@@ -881,22 +915,9 @@ IOResult<void> export_input_data_county_timeseries(const std::vector<Model>& mod
             scaling_factor_inf));
 
         // fully vaccinated
-        std::vector<std::vector<double>> num_Exposed_fv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedNoSymptoms_fv(model.size(),
-                                                                   std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSymptoms_fv(model.size(),
-                                                                 std::vector<double>(num_age_groups, 0.0));
-        // potential TODO: these confirmed are only confirmed by commuting, set to zero here. Adapt if generalized!
-        std::vector<std::vector<double>> num_InfectedNoSymptomsConfirmed_fv(model.size(),
-                                                                            std::vector<double>(num_age_groups, 0.0));
-        std::vector<std::vector<double>> num_InfectedSymptomsConfirmed_fv(model.size(),
-                                                                          std::vector<double>(num_age_groups, 0.0));
-        // end TODO
-        std::vector<std::vector<double>> num_InfectedSevere_fv(model.size(), std::vector<double>(num_age_groups, 0.0));
-        for (size_t county = 0; county < model.size(); county++) {
-            dummy_rec[county]   = std::vector<double>(num_age_groups, 0.0);
-            dummy_death[county] = std::vector<double>(num_age_groups, 0.0);
-            dummy_icu[county]   = std::vector<double>(num_age_groups, 0.0);
+        for (auto compartment : {&num_Exposed_fv, &num_InfectedNoSymptoms_fv, &num_InfectedSymptoms_fv,
+                                 &num_InfectedSevere_fv, &dummy_icu, &dummy_death, &dummy_rec}) {
+            reset(*compartment);
         }
         BOOST_OUTCOME_TRY(details::read_confirmed_cases_data(
             rki_data, region, date, num_Exposed_fv, num_InfectedNoSymptoms_fv, num_InfectedSymptoms_fv,
@@ -905,10 +926,9 @@ IOResult<void> export_input_data_county_timeseries(const std::vector<Model>& mod
             scaling_factor_inf));
 
         // ICU only read for compartment InfectionState::InfectedCritical and then distributed later
-        std::vector<double> dummy_icu2(model.size(), 0.0);
+        std::fill(dummy_icu2.begin(), dummy_icu2.end(), 0.0);
         BOOST_OUTCOME_TRY(details::read_divi_data(divi_data, region, date, dummy_icu2));
 
-        std::vector<std::vector<double>> num_icu(model.size(), std::vector<double>(num_age_groups, 0.0));
         for (size_t county = 0; county < region.size(); county++) {
             for (size_t age = 0; age < num_age_groups; age++) {
                 num_icu[county][age] =
@@ -916,10 +936,7 @@ IOResult<void> export_input_data_county_timeseries(const std::vector<Model>& mod
             }
         }
 
-        // read population basics
-        BOOST_OUTCOME_TRY(num_population, details::read_population_data(population_data, region));
-
-        std::vector<std::vector<double>> num_rec(model.size(), std::vector<double>(num_age_groups, 0.0));
+        reset(num_rec);
         BOOST_OUTCOME_TRY(details::read_confirmed_cases_data_fix_recovered(rki_data, region, date, num_rec, 14.));
 
         for (size_t county = 0; county < region.size(); county++) {
@@ -1229,11 +1246,10 @@ IOResult<void> read_input_data_county(std::vector<Model>& model, Date date, cons
                                                    path_join(dir, "cases_all_county_age_ma7.json"), county, date));
 
     if (export_time_series) {
-        // Use only if extrapolated real data is needed for comparison. EXPENSIVE !
-        // Run time equals run time of the previous functions times the num_days !
+        // Use only if extrapolated real data is needed for comparison.
         // (This only represents the vectorization of the previous function over all simulation days...)
-        log_warning("Exporting time series of extrapolated real data. This may take some minutes. "
-                    "For simulation runs over the same time period, deactivate it.");
+        log_info("Exporting time series of extrapolated real data. "
+                 "For simulation runs over the same time period, deactivate it.");
         BOOST_OUTCOME_TRY(export_input_data_county_timeseries(model, dir, dir, county, date, scaling_factor_inf,
                                                               scaling_factor_icu, num_days));
     }
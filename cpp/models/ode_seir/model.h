@@ -20,7 +20,7 @@
 #ifndef SEIR_MODEL_H
 #define SEIR_MODEL_H
 
-#include "memilio/compartments/compartmentalmodel.h"
+#include "memilio/compartments/flow_model.h"
 #include "memilio/epidemiology/populations.h"
 #include "memilio/epidemiology/contact_matrix.h"
 #include "ode_seir/infection_state.h"
@@ -35,9 +35,13 @@ namespace oseir
     * define the model *
     ********************/
 
-class Model : public CompartmentalModel<InfectionState, Populations<InfectionState>, Parameters>
+using Flows = FlowChart<Flow<InfectionState, InfectionState::Susceptible, InfectionState::Exposed>,
+                        Flow<InfectionState, InfectionState::Exposed, InfectionState::Infected>,
+                        Flow<InfectionState, InfectionState::Infected, InfectionState::Recovered>>;
+
+class Model : public FlowModel<InfectionState, Populations<InfectionState>, Parameters, Flows>
 {
-    using Base = CompartmentalModel<InfectionState, mio::Populations<InfectionState>, Parameters>;
+    using Base = FlowModel<InfectionState, mio::Populations<InfectionState>, Parameters, Flows>;
 
 public:
     Model()
@@ -45,24 +49,47 @@ public:
     {
     }
 
-    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
-                         Eigen::Ref<Eigen::VectorXd> dydt) const override
+    void get_flows(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
+                   Eigen::Ref<Eigen::VectorXd> flow_values) const override
     {
         auto& params     = this->parameters;
         double coeffStoE = params.get<ContactPatterns>().get_matrix_at(t)(0, 0) *
                            params.get<TransmissionProbabilityOnContact>() / populations.get_total();
 
-        dydt[(size_t)InfectionState::Susceptible] =
-            -coeffStoE * y[(size_t)InfectionState::Susceptible] * pop[(size_t)InfectionState::Infected];
-        dydt[(size_t)InfectionState::Exposed] =
-            coeffStoE * y[(size_t)InfectionState::Susceptible] * pop[(size_t)InfectionState::Infected] -
+        flow_values[get_flat_flow_index<InfectionState::Susceptible, InfectionState::Exposed>()] =
+            coeffStoE * y[(size_t)InfectionState::Susceptible] * pop[(size_t)InfectionState::Infected];
+        flow_values[get_flat_flow_index<InfectionState::Exposed, InfectionState::Infected>()] =
             (1.0 / params.get<TimeExposed>()) * y[(size_t)InfectionState::Exposed];
-        dydt[(size_t)InfectionState::Infected] =
-            (1.0 / params.get<TimeExposed>()) * y[(size_t)InfectionState::Exposed] -
-            (1.0 / params.get<TimeInfected>()) * y[(size_t)InfectionState::Infected];
-        dydt[(size_t)InfectionState::Recovered] =
+        flow_values[get_flat_flow_index<InfectionState::Infected, InfectionState::Recovered>()] =
             (1.0 / params.get<TimeInfected>()) * y[(size_t)InfectionState::Infected];
     }
+
+    /**
+     * @brief analytic jacobian of the right hand side with respect to y, e.g. for RosenbrockIntegratorCore.
+     * @param y current state of the model, also used as the total population.
+     * @param t current time.
+     * @param jac jacobian of the right hand side at (y, t).
+     */
+    void get_jacobian(Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::MatrixXd> jac) const
+    {
+        auto& params     = this->parameters;
+        double coeffStoE = params.get<ContactPatterns>().get_matrix_at(t)(0, 0) *
+                           params.get<TransmissionProbabilityOnContact>() / populations.get_total();
+        auto S = (size_t)InfectionState::Susceptible;
+        auto E = (size_t)InfectionState::Exposed;
+        auto I = (size_t)InfectionState::Infected;
+        auto R = (size_t)InfectionState::Recovered;
+
+        jac.setZero();
+        jac(S, S) = -coeffStoE * y[I];
+        jac(S, I) = -coeffStoE * y[S];
+        jac(E, S) = coeffStoE * y[I];
+        jac(E, I) = coeffStoE * y[S];
+        jac(E, E) = -1.0 / params.get<TimeExposed>();
+        jac(I, E) = 1.0 / params.get<TimeExposed>();
+        jac(I, I) = -1.0 / params.get<TimeInfected>();
+        jac(R, I) = 1.0 / params.get<TimeInfected>();
+    }
 };
 
 } // namespace oseir
@@ -529,6 +529,8 @@ mio::IOResult<void> set_edges(const fs::path& data_dir,
                                    mio::osecir::InfectionState::InfectedNoSymptoms,
                                    mio::osecir::InfectionState::InfectedSymptoms,
                                    mio::osecir::InfectionState::Recovered};
+    //collect edges and add them all at once, adding them one by one is slow for large graphs
+    std::vector<mio::Edge<mio::MigrationParameters>> edges;
     for (size_t county_idx_i = 0; county_idx_i < params_graph.nodes().size(); ++county_idx_i) {
         for (size_t county_idx_j = 0; county_idx_j < params_graph.nodes().size(); ++county_idx_j) {
             auto& populations = params_graph.nodes()[county_idx_i].property.populations;
@@ -566,11 +568,13 @@ mio::IOResult<void> set_edges(const fs::path& data_dir,
             //only add edges with mobility above thresholds for performance
             //thresholds are chosen empirically so that more than 99% of mobility is covered, approx. 1/3 of the edges
             if (commuter_coeff_ij > 4e-5 || twitter_coeff > 1e-5) {
-                params_graph.add_edge(county_idx_i, county_idx_j, std::move(mobility_coeffs));
+                edges.emplace_back(county_idx_i, county_idx_j, std::move(mobility_coeffs));
             }
         }
     }
 
+    params_graph.add_edges(std::move(edges));
+
     return mio::success();
 }
 
@@ -50,6 +50,11 @@ public:
         return mock->get_rand_sample();
     }
 
+    double get_rand_sample_const() const override
+    {
+        return mock->get_rand_sample();
+    }
+
     mio::ParameterDistribution* clone() const override
     {
         return new MockParameterDistributionRef(*this);
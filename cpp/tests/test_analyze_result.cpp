@@ -22,6 +22,8 @@
 #include "matchers.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <algorithm>
+#include <limits>
 
 TEST(TestInterpolateTimeSeries, timePointsAreLinSpaced)
 {
@@ -518,3 +520,62 @@ TEST(TestDistance, one_compartment)
     ASSERT_EQ(mio::result_distance_2norm(v1, v2, mio::osecir::InfectionState::Exposed),
               std::sqrt(4.0 + 1.0 + 0.0 + 36.0));
 }
+
+TEST(TestEnsembleMean, singlePrecision)
+{
+    //ensemble of simulations computed in double precision, results stored in double and in float
+    mio::osecir::Model model(1);
+    model.populations[{mio::AgeGroup(0), mio::osecir::InfectionState::Exposed}] = 100;
+    model.populations.set_difference_from_total({mio::AgeGroup(0), mio::osecir::InfectionState::Susceptible}, 1e6);
+    model.parameters.get<mio::osecir::IncubationTime>()[mio::AgeGroup(0)]       = 5.2;
+    model.parameters.get<mio::osecir::SerialInterval>()[mio::AgeGroup(0)]       = 4.2;
+    model.parameters.get<mio::osecir::TimeInfectedSymptoms>()[mio::AgeGroup(0)] = 5.;
+    model.parameters.get<mio::osecir::TimeInfectedSevere>()[mio::AgeGroup(0)]   = 10.;
+    model.parameters.get<mio::osecir::TimeInfectedCritical>()[mio::AgeGroup(0)] = 8.;
+    model.parameters.get<mio::osecir::ContactPatterns>().get_cont_freq_mat()[0].get_baseline().setConstant(10.0);
+
+    std::vector<std::vector<mio::TimeSeries<double>>> ensemble;
+    std::vector<std::vector<mio::TimeSeries<float>>> ensemble_float;
+    for (auto run = 0; run < 10; ++run) {
+        ensemble.emplace_back();
+        ensemble_float.emplace_back();
+        for (auto node = 0; node < 2; ++node) {
+            model.parameters.get<mio::osecir::TransmissionProbabilityOnContact>()[mio::AgeGroup(0)] =
+                0.05 + 0.01 * run + 0.005 * node;
+            auto result = mio::interpolate_simulation_result(mio::simulate(0.0, 50.0, 0.1, model));
+            ASSERT_TRUE(result.get_last_value().allFinite());
+            ensemble.back().push_back(result);
+            ensemble_float.back().push_back(result.cast<float>());
+        }
+    }
+
+    //maximum deviation relative to the magnitude of the result
+    auto max_rel_deviation = [](auto&& results, auto&& results_float) {
+        auto max_deviation = 0.0;
+        for (size_t node = 0; node < results.size(); ++node) {
+            for (Eigen::Index t = 0; t < results[node].get_num_time_points(); ++t) {
+                auto v       = results[node][t].eval();
+                auto v_float = results_float[node][t].template cast<double>().eval();
+                max_deviation =
+                    std::max(max_deviation, ((v - v_float).array().abs() / v.array().abs().max(1.0)).maxCoeff());
+            }
+        }
+        return max_deviation;
+    };
+
+    //values are rounded to float once when stored and once when the accumulated result is stored
+    auto eps = double(std::numeric_limits<float>::epsilon());
+    EXPECT_LE(max_rel_deviation(ensemble[0], ensemble_float[0]), 0.5 * eps);
+    EXPECT_LE(max_rel_deviation(mio::ensemble_mean(ensemble), mio::ensemble_mean(ensemble_float)), eps);
+    EXPECT_LE(max_rel_deviation(mio::sum_nodes(ensemble)[0], mio::sum_nodes(ensemble_float)[0]), eps);
+    EXPECT_LE(
+        max_rel_deviation(mio::ensemble_percentile(ensemble, 0.25), mio::ensemble_percentile(ensemble_float, 0.25)),
+        0.5 * eps);
+
+    //interpolation in float is as accurate as interpolation in double
+    auto result = mio::simulate(0.0, 50.0, 0.1, model);
+    EXPECT_LE(max_rel_deviation(std::vector<mio::TimeSeries<double>>{mio::interpolate_simulation_result(result)},
+                                std::vector<mio::TimeSeries<float>>{
+                                    mio::interpolate_simulation_result(result.cast<float>())}),
+              4 * eps);
+}
@@ -0,0 +1,307 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/io/binary_serializer.h"
+#include "memilio/io/mobility_io.h"
+#include "memilio/utils/custom_index_array.h"
+#include "memilio/utils/parameter_set.h"
+#include "memilio/utils/uncertain_value.h"
+#include "ode_secir/model.h"
+#include "ode_secir/parameter_space.h"
+#include "matchers.h"
+#include "distributions_helpers.h"
+#include "temp_file_register.h"
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace binarytest
+{
+struct Foo {
+    int i;
+    std::string s;
+    template <class IOContext>
+    void serialize(IOContext& io) const
+    {
+        auto obj = io.create_object("Foo");
+        obj.add_element("i", i);
+        obj.add_element("s", s);
+    }
+
+    //reads the elements in reverse order to check lookup by name
+    template <class IOContext>
+    static mio::IOResult<Foo> deserialize(IOContext& io)
+    {
+        auto obj = io.expect_object("Foo");
+        auto s   = obj.expect_element("s", mio::Tag<std::string>{});
+        auto i   = obj.expect_element("i", mio::Tag<int>{});
+        return mio::apply(
+            io,
+            [](auto i_, auto s_) {
+                return Foo{i_, s_};
+            },
+            i, s);
+    }
+    bool operator==(const Foo& other) const
+    {
+        return i == other.i && s == other.s;
+    }
+};
+
+struct Param1 {
+    using Type = double;
+    static constexpr Type get_default()
+    {
+        return 1.0;
+    }
+    static std::string name()
+    {
+        return "Param1";
+    }
+};
+
+struct Param2 {
+    using Type = std::vector<Foo>;
+    static Type get_default()
+    {
+        return {Foo{1, "a"}, Foo{2, "bc"}};
+    }
+    static std::string name()
+    {
+        return "Param2";
+    }
+};
+
+using ParameterSet = mio::ParameterSet<Param1, Param2>;
+
+struct Tag {
+};
+} // namespace binarytest
+
+template <class T>
+void check_binary_round_trip(const T& t)
+{
+    auto bytes = mio::serialize_binary(t);
+    ASSERT_THAT(print_wrap(bytes), IsSuccess());
+    auto r = mio::deserialize_binary(bytes.value(), mio::Tag<T>{});
+    ASSERT_THAT(print_wrap(r), IsSuccess());
+    EXPECT_EQ(r.value(), t);
+}
+
+TEST(TestBinarySerializer, basic_types)
+{
+    check_binary_round_trip(true);
+    check_binary_round_trip(std::numeric_limits<int>::min());
+    check_binary_round_trip(std::numeric_limits<uint64_t>::max());
+    check_binary_round_trip(std::numeric_limits<double>::lowest());
+    check_binary_round_trip(0.125f);
+    check_binary_round_trip(std::string("Hello World"));
+    check_binary_round_trip(std::string());
+}
+
+TEST(TestBinarySerializer, wrong_type)
+{
+    auto bytes = mio::serialize_binary(1.0);
+    auto r     = mio::deserialize_binary(bytes.value(), mio::Tag<int>{});
+    EXPECT_THAT(print_wrap(r), IsFailure(mio::StatusCode::InvalidType));
+}
+
+TEST(TestBinarySerializer, objects_and_lists)
+{
+    check_binary_round_trip(binarytest::Foo{-3, "foo"});
+    check_binary_round_trip(std::vector<double>{1.0, 2.0, 3.0});
+    check_binary_round_trip(std::vector<binarytest::Foo>{{1, "a"}, {2, ""}, {3, "ccc"}});
+    check_binary_round_trip(std::make_tuple(1, std::string("two"), 3.0));
+    check_binary_round_trip(binarytest::ParameterSet{});
+}
+
+TEST(TestBinarySerializer, matrix)
+{
+    Eigen::MatrixXd m(2, 3);
+    m << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+    check_binary_round_trip(m);
+    check_binary_round_trip(Eigen::VectorXd::LinSpaced(5, 0.0, 1.0).eval());
+    check_binary_round_trip(Eigen::MatrixXd(0, 0));
+
+    //expressions and blocks can be written and are restored as matrices
+    auto bytes = mio::serialize_binary(m.block(0, 1, 2, 2));
+    auto r     = mio::deserialize_binary(bytes.value(), mio::Tag<Eigen::MatrixXd>{});
+    ASSERT_THAT(print_wrap(r), IsSuccess());
+    EXPECT_EQ(print_wrap(r.value()), print_wrap(m.block(0, 1, 2, 2).eval()));
+}
+
+TEST(TestBinarySerializer, customindexarray)
+{
+    mio::CustomIndexArray<double, binarytest::Tag> a(mio::Index<binarytest::Tag>(2));
+    a[mio::Index<binarytest::Tag>(0)] = 1.0;
+    a[mio::Index<binarytest::Tag>(1)] = 2.0;
+    auto bytes                        = mio::serialize_binary(a);
+    auto r = mio::deserialize_binary(bytes.value(), mio::Tag<mio::CustomIndexArray<double, binarytest::Tag>>{});
+    ASSERT_THAT(print_wrap(r), IsSuccess());
+    EXPECT_EQ(r.value().size(), mio::Index<binarytest::Tag>(2));
+    EXPECT_THAT(r.value(), testing::ElementsAre(1.0, 2.0));
+}
+
+TEST(TestBinarySerializer, uncertain_value)
+{
+    mio::UncertainValue uv(2.0);
+    {
+        auto bytes = mio::serialize_binary(uv);
+        auto r     = mio::deserialize_binary(bytes.value(), mio::Tag<mio::UncertainValue>{});
+        ASSERT_THAT(print_wrap(r), IsSuccess());
+        EXPECT_EQ(double(r.value()), 2.0);
+        EXPECT_EQ(r.value().get_distribution(), nullptr);
+    }
+
+    uv.set_distribution(mio::ParameterDistributionNormal(-1.0, 2.0, 0.5, 0.1));
+    {
+        auto bytes = mio::serialize_binary(uv);
+        auto r     = mio::deserialize_binary(bytes.value(), mio::Tag<mio::UncertainValue>{});
+        ASSERT_THAT(print_wrap(r), IsSuccess());
+        EXPECT_EQ(double(r.value()), 2.0);
+        ASSERT_NE(r.value().get_distribution(), nullptr);
+        check_distribution(*r.value().get_distribution(), *uv.get_distribution());
+    }
+    {
+        auto bytes = mio::serialize_binary(uv, mio::IOF_OmitDistributions);
+        auto r = mio::deserialize_binary(bytes.value(), mio::Tag<mio::UncertainValue>{}, mio::IOF_OmitDistributions);
+        ASSERT_THAT(print_wrap(r), IsSuccess());
+        EXPECT_EQ(r.value().get_distribution(), nullptr);
+    }
+}
+
+TEST(TestBinarySerializer, invalid_header)
+{
+    auto bytes = mio::serialize_binary(1);
+    //flags must match
+    EXPECT_THAT(print_wrap(mio::deserialize_binary(bytes.value(), mio::Tag<int>{}, mio::IOF_OmitValues)),
+                IsFailure(mio::StatusCode::InvalidValue));
+
+    //version must match
+    auto wrong_version = bytes.value();
+    wrong_version[12] += 1;
+    EXPECT_THAT(print_wrap(mio::deserialize_binary(wrong_version, mio::Tag<int>{})),
+                IsFailure(mio::StatusCode::InvalidFileFormat));
+
+    //not binary format
+    std::vector<unsigned char> not_binary{'{', '}'};
+    EXPECT_THAT(print_wrap(mio::deserialize_binary(not_binary, mio::Tag<int>{})),
+                IsFailure(mio::StatusCode::InvalidFileFormat));
+}
+
+TEST(TestBinarySerializer, truncated)
+{
+    auto bytes = mio::serialize_binary(std::vector<binarytest::Foo>{{1, "a"}, {2, "b"}});
+    auto& v    = bytes.value();
+    v.resize(v.size() - 3);
+    auto r = mio::deserialize_binary(v, mio::Tag<std::vector<binarytest::Foo>>{});
+    EXPECT_THAT(print_wrap(r), IsFailure(mio::StatusCode::InvalidFileFormat));
+}
+
+namespace
+{
+//replace the first occurrence of a value in the data of a binary buffer
+template <class T>
+void replace_first_value(std::vector<unsigned char>& buffer, T old_value, T new_value)
+{
+    auto offset = mio::details::read_binary_header(buffer, mio::IOF_None).value();
+    unsigned char old_bytes[sizeof(T)], new_bytes[sizeof(T)];
+    std::memcpy(old_bytes, &old_value, sizeof(T));
+    std::memcpy(new_bytes, &new_value, sizeof(T));
+    auto it = std::search(buffer.begin() + offset, buffer.end(), std::begin(old_bytes), std::end(old_bytes));
+    ASSERT_NE(it, buffer.end());
+    std::copy(std::begin(new_bytes), std::end(new_bytes), it);
+}
+} // namespace
+
+TEST(TestBinarySerializer, corrupt_sizes)
+{
+    //more elements than fit into the list
+    auto foos = mio::serialize_binary(std::vector<binarytest::Foo>{{1, "a"}, {2, "b"}}).value();
+    replace_first_value(foos, uint64_t(2), std::numeric_limits<uint64_t>::max());
+    EXPECT_THAT(print_wrap(mio::deserialize_binary(foos, mio::Tag<std::vector<binarytest::Foo>>{})),
+                IsFailure(mio::StatusCode::InvalidFileFormat));
+
+    //size of the list overflows
+    auto doubles = mio::serialize_binary(std::vector<double>{1.0, 2.0, 3.0}).value();
+    replace_first_value(doubles, uint64_t(3), (uint64_t(1) << 61) + 3);
+    EXPECT_THAT(print_wrap(mio::deserialize_binary(doubles, mio::Tag<std::vector<double>>{})),
+                IsFailure(mio::StatusCode::InvalidFileFormat));
+
+    //size of the matrix overflows
+    auto matrix = mio::serialize_binary(Eigen::MatrixXd(0, 4)).value();
+    replace_first_value(matrix, int64_t(0), int64_t(1) << 62);
+    EXPECT_THAT(print_wrap(mio::deserialize_binary(matrix, mio::Tag<Eigen::MatrixXd>{})),
+                IsFailure(mio::StatusCode::InvalidFileFormat));
+}
+
+TEST(TestBinarySerializer, graph)
+{
+    mio::osecir::Model model(2);
+    model.parameters.set<mio::osecir::TestAndTraceCapacity>(30);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(2); i++) {
+        model.populations[{i, mio::osecir::InfectionState::Exposed}] = 10.0 * ((size_t)i + 1);
+        model.populations.set_difference_from_group_total<mio::AgeGroup>({i, mio::osecir::InfectionState::Susceptible},
+                                                                         1000.0);
+    }
+    mio::ContactMatrixGroup& contact_matrix = model.parameters.get<mio::osecir::ContactPatterns>();
+    contact_matrix[0] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 5.0));
+    contact_matrix.add_damping(Eigen::MatrixXd::Constant(2, 2, 0.7), mio::SimulationTime(30.));
+    mio::osecir::set_params_distributions_normal(model, 0, 100, 0.15);
+
+    mio::Graph<mio::osecir::Model, mio::MigrationParameters> graph;
+    graph.add_node(1001, model);
+    graph.add_node(1002, model);
+    graph.add_node(1003, model);
+    graph.add_edge(0, 1, Eigen::VectorXd::Constant(model.populations.get_num_compartments(), 0.01));
+    graph.add_edge(2, 0, Eigen::VectorXd::Constant(model.populations.get_num_compartments(), 0.02));
+    graph.add_edge(1, 0, Eigen::VectorXd::Constant(model.populations.get_num_compartments(), 0.03));
+
+    TempFileRegister file_register;
+    auto filename     = file_register.get_unique_path("graph-%%%%-%%%%.bin");
+    auto write_status = mio::write_graph_binary(graph, filename);
+    ASSERT_THAT(print_wrap(write_status), IsSuccess());
+
+    auto read_result = mio::read_graph_binary<mio::osecir::Model>(filename);
+    ASSERT_THAT(print_wrap(read_result), IsSuccess());
+    auto& graph_read = read_result.value();
+
+    ASSERT_EQ(graph_read.nodes().size(), graph.nodes().size());
+    ASSERT_EQ(graph_read.edges().size(), graph.edges().size());
+    for (size_t i = 0; i < graph.nodes().size(); ++i) {
+        auto& m      = graph.nodes()[i].property;
+        auto& m_read = graph_read.nodes()[i].property;
+        EXPECT_EQ(graph_read.nodes()[i].id, graph.nodes()[i].id);
+        EXPECT_EQ(m_read.parameters.get<mio::osecir::ContactPatterns>().get_cont_freq_mat(),
+                  m.parameters.get<mio::osecir::ContactPatterns>().get_cont_freq_mat());
+        EXPECT_EQ(print_wrap(m_read.populations.get_compartments()), print_wrap(m.populations.get_compartments()));
+        check_distribution(*m_read.parameters.get<mio::osecir::TestAndTraceCapacity>().get_distribution(),
+                           *m.parameters.get<mio::osecir::TestAndTraceCapacity>().get_distribution());
+    }
+    for (size_t i = 0; i < graph.edges().size(); ++i) {
+        auto& e      = graph.edges()[i];
+        auto& e_read = graph_read.edges()[i];
+        EXPECT_EQ(e_read.start_node_idx, e.start_node_idx);
+        EXPECT_EQ(e_read.end_node_idx, e.end_node_idx);
+        EXPECT_EQ(e_read.property.get_coefficients(), e.property.get_coefficients());
+    }
+}
@@ -19,6 +19,11 @@
 */
 
 #include "memilio/compartments/simulation.h"
+#include "memilio/compartments/batch_simulation.h"
+#include "memilio/compartments/flow_simulation.h"
+#include "memilio/epidemiology/age_group.h"
+#include "memilio/epidemiology/populations.h"
+#include "memilio/utils/parameter_set.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -48,3 +53,201 @@ TEST(TestCompartmentSimulation, integrator_uses_model_reference)
 
     ASSERT_NEAR(sim.get_result().get_last_value()[0], 3.0, 1e-5);
 }
+
+namespace
+{
+struct MockBatchModel {
+    Eigen::VectorXd get_initial_values() const
+    {
+        return Eigen::VectorXd::Constant(2, m_y0);
+    }
+    void eval_right_hand_side(const Eigen::Ref<const Eigen::VectorXd>&, const Eigen::Ref<const Eigen::VectorXd>& y,
+                              double, Eigen::Ref<Eigen::VectorXd> dydt) const
+    {
+        dydt = m_rate * y;
+    }
+    void check_constraints() const
+    {
+    }
+    double m_y0   = 1.0;
+    double m_rate = 1.0;
+};
+} // namespace
+
+TEST(TestCompartmentSimulation, batch_simulation)
+{
+    std::vector<MockBatchModel> models(3);
+    models[0].m_rate = -1.0;
+    models[1].m_y0   = 2.0;
+    models[2].m_rate = 0.5;
+
+    auto sim = mio::BatchSimulation<MockBatchModel>(models, 0.0);
+    auto y   = sim.advance(1.0);
+
+    ASSERT_EQ(sim.get_num_models(), 3);
+    EXPECT_NEAR(sim.get_time(), 1.0, 1e-10);
+    for (size_t k = 0; k < 3; ++k) {
+        auto expected = models[k].m_y0 * std::exp(models[k].m_rate);
+        EXPECT_NEAR(y(0, Eigen::Index(k)), expected, 1e-4);
+        EXPECT_NEAR(sim.get_result(k).get_last_value()[1], expected, 1e-4);
+        //all results have the same time points
+        EXPECT_EQ(sim.get_result(k).get_num_time_points(), sim.get_result(0).get_num_time_points());
+    }
+
+    //modifying the models from the outside should affect the integration result
+    sim.get_model(0).m_rate = 0.0;
+    sim.advance(2.0);
+    EXPECT_NEAR(sim.get_result(0).get_last_value()[0], std::exp(-1.0), 1e-4);
+}
+
+TEST(TestCompartmentSimulation, simulate_batch_same_as_single)
+{
+    std::vector<MockBatchModel> models(2);
+    models[1].m_rate = -0.5;
+
+    auto results = mio::simulate_batch(0.0, 3.0, 0.1, models);
+    ASSERT_EQ(results.size(), 2);
+    for (size_t k = 0; k < 2; ++k) {
+        auto single = mio::simulate(0.0, 3.0, 0.1, models[k]);
+        EXPECT_NEAR(results[k].get_last_time(), single.get_last_time(), 1e-10);
+        //different integrators, results only agree within their tolerances
+        EXPECT_NEAR(results[k].get_last_value()[0], single.get_last_value()[0], 1e-4 * single.get_last_value()[0]);
+    }
+}
+
+namespace
+{
+enum class FlowTestState
+{
+    A,
+    B,
+    C,
+    Count
+};
+
+struct FlowTestRate {
+    using Type = double;
+    static Type get_default()
+    {
+        return 0.5;
+    }
+    static std::string name()
+    {
+        return "FlowTestRate";
+    }
+};
+
+using FlowTestParams = mio::ParameterSet<FlowTestRate>;
+
+using FlowTestFlows = mio::FlowChart<mio::Flow<FlowTestState, FlowTestState::A, FlowTestState::B>,
+                                     mio::Flow<FlowTestState, FlowTestState::B, FlowTestState::C>>;
+
+//A -> B -> C with rate 1 and 0.5 in each age group
+struct FlowTestModel : public mio::FlowModel<FlowTestState, mio::Populations<mio::AgeGroup, FlowTestState>,
+                                             FlowTestParams, FlowTestFlows> {
+    using Base =
+        mio::FlowModel<FlowTestState, mio::Populations<mio::AgeGroup, FlowTestState>, FlowTestParams, FlowTestFlows>;
+    FlowTestModel()
+        : Base(Populations({mio::AgeGroup(2), FlowTestState::Count}, 0.), ParameterSet())
+    {
+    }
+    void get_flows(Eigen::Ref<const Eigen::VectorXd>, Eigen::Ref<const Eigen::VectorXd> y, double,
+                   Eigen::Ref<Eigen::VectorXd> flow_values) const override
+    {
+        for (size_t i = 0; i < 2; ++i) {
+            flow_values[get_flat_flow_index<FlowTestState::A, FlowTestState::B>(i)] =
+                y[populations.get_flat_index({mio::AgeGroup(i), FlowTestState::A})];
+            flow_values[get_flat_flow_index<FlowTestState::B, FlowTestState::C>(i)] =
+                parameters.get<FlowTestRate>() * y[populations.get_flat_index({mio::AgeGroup(i), FlowTestState::B})];
+        }
+    }
+};
+} // namespace
+
+TEST(TestCompartmentSimulation, flow_chart)
+{
+    static_assert(FlowTestFlows::size() == 2, "");
+    static_assert(FlowTestFlows::get_index(FlowTestState::A, FlowTestState::B) == 0, "");
+    static_assert(FlowTestFlows::get_index(FlowTestState::B, FlowTestState::C) == 1, "");
+    static_assert(FlowTestFlows::get_index(FlowTestState::A, FlowTestState::C) == 2, "not in the chart");
+
+    FlowTestModel model;
+    EXPECT_EQ(model.get_num_subgroups(), 2);
+    EXPECT_EQ(model.get_num_flows(), 4);
+    EXPECT_EQ((FlowTestModel::get_flat_flow_index<FlowTestState::B, FlowTestState::C>(1)), 3);
+
+    //derivatives are generated from the flows
+    Eigen::VectorXd flows(4), dydt(6);
+    flows << 1.0, 2.0, 3.0, 4.0;
+    model.get_derivatives(flows, dydt);
+    EXPECT_THAT(dydt, testing::ElementsAre(-1.0, -1.0, 2.0, -3.0, -1.0, 4.0));
+}
+
+TEST(TestCompartmentSimulation, flow_simulation)
+{
+    FlowTestModel model;
+    model.populations[{mio::AgeGroup(0), FlowTestState::A}] = 100;
+    model.populations[{mio::AgeGroup(1), FlowTestState::A}] = 50;
+    model.populations[{mio::AgeGroup(1), FlowTestState::B}] = 10;
+
+    mio::FlowSimulation<FlowTestModel> flow_sim(model, 0.0, 0.1);
+    flow_sim.advance(2.0);
+    auto result = mio::simulate(0.0, 2.0, 0.1, model);
+
+    //compartments are the same as with the normal simulation
+    EXPECT_NEAR((flow_sim.get_result().get_last_value() - result.get_last_value()).norm(), 0.0, 1e-5);
+    EXPECT_EQ(flow_sim.get_result().get_num_time_points(), flow_sim.get_flows().get_num_time_points());
+
+    //flows accumulate everyone who left a compartment
+    auto flows = flow_sim.get_flows().get_last_value();
+    EXPECT_NEAR(flows[0], 100 * (1 - std::exp(-2.0)), 1e-4);
+    EXPECT_NEAR(flows[2], 50 * (1 - std::exp(-2.0)), 1e-4);
+    EXPECT_NEAR(flow_sim.get_result().get_last_value().sum(), 160, 1e-8);
+    auto y = flow_sim.get_result().get_last_value();
+    EXPECT_NEAR(flows[1] + flows[3], y[2] + y[5], 1e-8);
+}
+
+namespace
+{
+//only computes the first flow of each age group
+struct PartialFlowTestModel : public FlowTestModel {
+    void get_flows(Eigen::Ref<const Eigen::VectorXd>, Eigen::Ref<const Eigen::VectorXd> y, double,
+                   Eigen::Ref<Eigen::VectorXd> flow_values) const override
+    {
+        for (size_t i = 0; i < 2; ++i) {
+            flow_values[get_flat_flow_index<FlowTestState::A, FlowTestState::B>(i)] =
+                y[populations.get_flat_index({mio::AgeGroup(i), FlowTestState::A})];
+        }
+    }
+};
+
+//euler step that leaves values in the buffer of the derivatives before evaluating the right hand side
+struct DirtyEulerIntegratorCore : public mio::IntegratorCore {
+    bool step(const mio::DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
+              Eigen::Ref<Eigen::VectorXd> ytp1) const override
+    {
+        ytp1.setConstant(1.0);
+        f(yt, t, ytp1);
+        ytp1 = yt + dt * ytp1;
+        t += dt;
+        return true;
+    }
+};
+} // namespace
+
+TEST(TestCompartmentSimulation, flow_simulation_unset_flows_are_zero)
+{
+    PartialFlowTestModel model;
+    model.populations[{mio::AgeGroup(0), FlowTestState::A}] = 100;
+    model.populations[{mio::AgeGroup(1), FlowTestState::B}] = 10;
+
+    mio::FlowSimulation<PartialFlowTestModel> flow_sim(model, 0.0, 0.5);
+    flow_sim.set_integrator(std::make_shared<DirtyEulerIntegratorCore>());
+    flow_sim.advance(2.0);
+
+    auto flows = flow_sim.get_flows().get_last_value();
+    EXPECT_GT(flows[0], 0.0);
+    EXPECT_EQ(flows[1], 0.0);
+    EXPECT_EQ(flows[3], 0.0);
+    EXPECT_NEAR(flow_sim.get_result().get_last_value()[5], 0.0, 1e-14);
+}
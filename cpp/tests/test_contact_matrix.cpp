@@ -75,3 +75,78 @@ TEST(TestContactMatrixGroup, sum)
     EXPECT_THAT(print_wrap(cmg.get_matrix_at(0.0)), MatrixNear(Eigen::MatrixXd::Constant(3, 3, 6.0)));
     EXPECT_THAT(print_wrap(cmg.get_matrix_at(1.0)), MatrixNear(Eigen::MatrixXd::Constant(3, 3, 3.0)));
 }
+
+TEST(TestContactMatrixGroup, schedule)
+{
+    mio::ContactMatrixGroup cmg(3, 2);
+    cmg[0] = mio::ContactMatrix((Eigen::MatrixXd(2, 2) << 1, 2, 3, 4).finished(), Eigen::MatrixXd::Zero(2, 2));
+    cmg[1] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 2.0), Eigen::MatrixXd::Constant(2, 2, 0.5));
+    cmg[2] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 3.0));
+    //same damping for all matrices
+    cmg.add_damping(0.5, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(2.0));
+    cmg.add_damping(0.0, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(20.0));
+    //dampings of single matrices, partly less than a day apart
+    cmg[0].add_damping(0.3, mio::DampingLevel(1), mio::DampingType(0), mio::SimulationTime(2.5));
+    cmg[1].add_damping((Eigen::MatrixXd(2, 2) << 0.1, 0.2, 0.3, 0.4).finished(), mio::DampingLevel(1),
+                       mio::DampingType(1), mio::SimulationTime(7.2));
+    cmg[2].add_damping(0.75, mio::DampingLevel(0), mio::DampingType(1), mio::SimulationTime(7.0));
+
+    auto schedule = cmg.get_schedule();
+
+    //increasing time points like in an integration
+    for (auto t = -2.0; t < 25.0; t += 0.05) {
+        EXPECT_THAT(print_wrap(schedule.get_matrix_at(t)), MatrixNear(print_wrap(cmg.get_matrix_at(t).eval())));
+    }
+    //arbitrary order and breakpoints
+    for (auto t : {21.0, 1.5, 7.2, 2.5, 2.0, 6.9, 6.2, 19.5, 1e10, -1e10, 1.6}) {
+        EXPECT_THAT(print_wrap(schedule.get_matrix_at(t)), MatrixNear(print_wrap(cmg.get_matrix_at(t).eval())));
+    }
+
+    //the schedule is not changed by new dampings
+    auto m = schedule.get_matrix_at(30.0).eval();
+    cmg.add_damping(0.5, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(25.0));
+    EXPECT_THAT(print_wrap(schedule.get_matrix_at(30.0)), MatrixNear(m));
+    EXPECT_THAT(print_wrap(cmg.get_schedule().get_matrix_at(30.0)),
+                MatrixNear(print_wrap(cmg.get_matrix_at(30.0).eval())));
+}
+
+TEST(TestContactMatrixGroup, scheduled_matrix_at)
+{
+    mio::ContactMatrixGroup cmg(2, 2);
+    cmg[0] = mio::ContactMatrix((Eigen::MatrixXd(2, 2) << 1, 2, 3, 4).finished(), Eigen::MatrixXd::Zero(2, 2));
+    cmg[1] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 2.0), Eigen::MatrixXd::Constant(2, 2, 0.5));
+    cmg.add_damping(0.5, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(2.0));
+    auto check = [&cmg](double t) {
+        EXPECT_THAT(print_wrap(cmg.get_scheduled_matrix_at(t)),
+                    MatrixNear(print_wrap(cmg.get_matrix_at(t).eval())));
+    };
+    check(0.5);
+    check(1.5);
+    check(5.0);
+
+    //the schedule is updated when the matrices change
+    cmg.add_damping(0.8, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(4.0));
+    check(5.0);
+    cmg[1].add_damping(0.2, mio::DampingLevel(1), mio::DampingType(0), mio::SimulationTime(3.0));
+    check(5.0);
+    cmg[0].get_baseline()(0, 0) = 10.0;
+    check(5.0);
+    cmg[1].get_minimum().setZero();
+    check(5.0);
+    cmg[0].get_dampings()[0].get_coeffs().setConstant(0.1);
+    check(5.0);
+    cmg[1].clear_dampings();
+    check(5.0);
+    cmg[0].remove_damping(0);
+    check(5.0);
+    cmg = mio::ContactMatrixGroup(1, 2);
+    check(5.0);
+
+    //copies have their own schedule
+    cmg[0].get_baseline().setConstant(1.0);
+    auto copy = cmg;
+    EXPECT_THAT(print_wrap(copy.get_scheduled_matrix_at(1.0)), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 1.0)));
+    cmg[0].get_baseline().setConstant(2.0);
+    EXPECT_THAT(print_wrap(cmg.get_scheduled_matrix_at(1.0)), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 2.0)));
+    EXPECT_THAT(print_wrap(copy.get_scheduled_matrix_at(1.0)), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 1.0)));
+}
@@ -114,3 +114,56 @@ TEST(TestDampings, smoothTransitions)
     EXPECT_THAT(print_wrap(dampings.get_matrix_at(1.0)),
                 MatrixNear((dampings.get_matrix_at(0.5) + dampings.get_matrix_at(1.5)) / 2));
 }
+
+TEST(TestDampings, incrementalUpdate)
+{
+    using Dampings = mio::Dampings<mio::Damping<mio::SquareMatrixShape>>;
+    Dampings dampings(2);
+    auto D1 = (Eigen::MatrixXd(2, 2) << 0.1, 0.2, 0.3, 0.4).finished();
+    auto D2 = 0.25;
+    auto D3 = 0.5;
+    auto times = {-1.0, 0.0, 0.5, 1.5, 3.0, 7.5, 20.0};
+
+    //compare with dampings that are accumulated from scratch
+    auto expect_same_as_new = [&times](const Dampings& d) {
+        Dampings fresh(2);
+        for (auto& damping : d) {
+            fresh.add(damping);
+        }
+        for (auto t : times) {
+            EXPECT_THAT(print_wrap(d.get_matrix_at(t)), MatrixNear(print_wrap(fresh.get_matrix_at(t))));
+        }
+    };
+
+    dampings.add(D1, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(0.0));
+    dampings.add(D2, mio::DampingLevel(1), mio::DampingType(0), mio::SimulationTime(5.0));
+    dampings.finalize();
+    expect_same_as_new(dampings);
+
+    //after the end of the timeline
+    dampings.add(D3, mio::DampingLevel(0), mio::DampingType(1), mio::SimulationTime(10.0));
+    expect_same_as_new(dampings);
+
+    //in the middle of the timeline, same time as existing damping
+    dampings.add(D3, mio::DampingLevel(1), mio::DampingType(1), mio::SimulationTime(5.0));
+    expect_same_as_new(dampings);
+
+    //replace existing damping
+    dampings.add(D2, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(0.0));
+    expect_same_as_new(dampings);
+
+    //before the beginning of the timeline
+    dampings.add(D2, mio::DampingLevel(2), mio::DampingType(0), mio::SimulationTime(-5.0));
+    expect_same_as_new(dampings);
+
+    //remove dampings in the middle and at the end
+    dampings.remove(2);
+    expect_same_as_new(dampings);
+    dampings.remove(dampings.get_num_dampings() - 1);
+    expect_same_as_new(dampings);
+
+    dampings.clear();
+    for (auto t : times) {
+        EXPECT_THAT(print_wrap(dampings.get_matrix_at(t)), MatrixNear(Eigen::MatrixXd::Zero(2, 2)));
+    }
+}
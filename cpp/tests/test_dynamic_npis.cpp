@@ -138,6 +138,25 @@ TEST(DynamicNPIs, implement_empty)
     EXPECT_THAT(dampexprs[1].get_dampings()[1].get_coeffs(), MatrixNear(Eigen::VectorXd::Zero(2)));
 }
 
+TEST(DynamicNPIs, implement_partial)
+{
+    using Damping                 = mio::Damping<mio::ColumnVectorShape>;
+    using DampingMatrixExpression = mio::DampingMatrixExpression<mio::Dampings<Damping>>;
+    mio::DampingMatrixExpressionGroup<DampingMatrixExpression> dampexprs(2, 2);
+    auto make_mask = [](auto& g) {
+        return g;
+    };
+
+    //the second matrix is not affected by the npis and has no dampings
+    auto dynamic_npis = std::vector<mio::DampingSampling>({mio::DampingSampling(
+        0.8, mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(0), {0}, Eigen::VectorXd::Ones(2))});
+    mio::implement_dynamic_npis(dampexprs, dynamic_npis, mio::SimulationTime(0.45), mio::SimulationTime(0.6),
+                                make_mask);
+
+    EXPECT_EQ(dampexprs[0].get_dampings().size(), 2);
+    EXPECT_EQ(dampexprs[1].get_dampings().size(), 0);
+}
+
 TEST(DynamicNPIs, implement)
 {
     using Damping                 = mio::Damping<mio::RectMatrixShape>;
@@ -277,7 +296,9 @@ TEST(DynamicNPIs, migration)
     npis.set_base_value(100'000);
     npis.set_interval(mio::SimulationTime(3.0));
 
+    //the edge only stores coefficients and dampings of compartments that migrate
     mio::MigrationCoefficientGroup coeffs(1, 2);
+    coeffs[0].get_baseline().setConstant(0.1);
     mio::MigrationParameters parameters(coeffs);
     parameters.set_dynamic_npis_infected(npis);
 
@@ -25,11 +25,15 @@
 #include "matchers.h"
 #include "memilio/io/io.h"
 #include "memilio/io/mobility_io.h"
+#include "memilio/utils/parallel_for.h"
 #include "test_data_dir.h"
+#include "temp_file_register.h"
 #include "gtest/gtest.h"
 #include "json/value.h"
 #include "boost/optional/optional_io.hpp"
+#include "boost/filesystem.hpp"
 #include <gmock/gmock-matchers.h>
+#include <ctime>
 
 TEST(TestEpiDataIo, read_rki)
 {
@@ -91,6 +95,174 @@ TEST(TestEpiDataIo, read_rki_error_age)
     ASSERT_THAT(print_wrap(result), IsFailure(mio::StatusCode::InvalidValue));
 }
 
+TEST(TestEpiDataIo, read_rki_file)
+{
+    Json::Value js(Json::arrayValue);
+    js[0]["ID_County"] = 1002;
+    js[0]["Date"]      = "2021-12-02";
+    js[0]["Confirmed"] = 1;
+    js[0]["Deaths"]    = 2;
+    js[0]["Recovered"] = 3;
+    js[0]["Age_RKI"]   = "A80+";
+
+    js[1]["ID_County"] = 1001;
+    js[1]["Date"]      = "2021-12-02";
+    js[1]["Confirmed"] = 3;
+    js[1]["Deaths"]    = 4;
+    js[1]["Recovered"] = 5;
+    js[1]["Age_RKI"]   = "A00-A04";
+
+    js[2]["ID_County"] = 1001;
+    js[2]["Date"]      = "2021-12-01";
+    js[2]["Confirmed"] = 6;
+    js[2]["Deaths"]    = 7;
+    js[2]["Recovered"] = 8;
+    js[2]["Age_RKI"]   = "unknown";
+
+    js[3]["ID_County"] = 1001;
+    js[3]["Date"]      = "2021-12-01";
+    js[3]["Confirmed"] = 9;
+    js[3]["Deaths"]    = 10;
+    js[3]["Recovered"] = 11;
+    js[3]["Age_RKI"]   = "A05-A14";
+
+    TempFileRegister file_register;
+    auto filename = file_register.get_unique_path("rki-%%%%-%%%%.json");
+    ASSERT_THAT(print_wrap(mio::write_json(filename, js)), IsSuccess());
+
+    //reading the file one entry at a time gives the same result as deserializing the whole document
+    auto expected = mio::deserialize_confirmed_cases_data(js);
+    auto result   = mio::read_confirmed_cases_data(filename);
+    ASSERT_THAT(print_wrap(result), IsSuccess());
+    ASSERT_EQ(result.value().size(), 3);
+    for (size_t i = 0; i < result.value().size(); ++i) {
+        EXPECT_EQ(result.value()[i].date, expected.value()[i].date);
+        EXPECT_EQ(result.value()[i].age_group, expected.value()[i].age_group);
+        EXPECT_EQ(result.value()[i].num_confirmed, expected.value()[i].num_confirmed);
+        EXPECT_EQ(result.value()[i].county_id, expected.value()[i].county_id);
+    }
+
+    //files that were modified just before they are read are not cached
+    boost::filesystem::last_write_time(filename, std::time(nullptr) - 3600);
+    auto table_result = mio::read_confirmed_cases_data_table(filename);
+    ASSERT_THAT(print_wrap(table_result), IsSuccess());
+    auto& table = *table_result.value();
+    EXPECT_THAT(table.get_region_ids(), testing::ElementsAre(1001, 1002));
+    EXPECT_TRUE(table.get_max_date() == mio::Date(2021, 12, 2));
+    EXPECT_EQ(table.get_entries(1001).size(), 2);
+    EXPECT_EQ(table.get_entries(1003).size(), 0);
+    EXPECT_EQ(table.get_entries(1001, mio::Date(2021, 12, 1)).size(), 1);
+    EXPECT_EQ(table.get_entries(1001, mio::Date(2021, 12, 1)).begin()->num_confirmed, 9);
+    EXPECT_EQ(table.get_entries(1001, mio::Date(2021, 12, 2), mio::AgeGroup(0)).size(), 1);
+    EXPECT_EQ(table.get_entries(1001, mio::Date(2021, 12, 2), mio::AgeGroup(1)).size(), 0);
+    EXPECT_EQ(table.get_entries(1002, mio::Date(2021, 12, 2), mio::AgeGroup(5)).begin()->num_deaths, 2);
+
+    //second read is cached
+    auto cached_result = mio::read_confirmed_cases_data_table(filename);
+    ASSERT_THAT(print_wrap(cached_result), IsSuccess());
+    EXPECT_EQ(cached_result.value(), table_result.value());
+
+    mio::clear_epi_data_cache();
+    auto uncached_result = mio::read_confirmed_cases_data_table(filename);
+    ASSERT_THAT(print_wrap(uncached_result), IsSuccess());
+    EXPECT_NE(uncached_result.value(), table_result.value());
+    EXPECT_EQ(uncached_result.value()->get_entries().size(), 3);
+}
+
+TEST(TestEpiDataIo, read_data_table_cache)
+{
+    Json::Value js(Json::arrayValue);
+    js[0]["ID_County"] = 1001;
+    js[0]["Date"]      = "2021-12-01";
+    js[0]["Confirmed"] = 1;
+    js[0]["Deaths"]    = 2;
+    js[0]["Recovered"] = 3;
+    js[0]["Age_RKI"]   = "A00-A04";
+
+    TempFileRegister file_register;
+    auto filename1 = file_register.get_unique_path("rki-%%%%-%%%%.json");
+    auto filename2 = file_register.get_unique_path("rki-%%%%-%%%%.json");
+    ASSERT_THAT(print_wrap(mio::write_json(filename1, js)), IsSuccess());
+    ASSERT_THAT(print_wrap(mio::write_json(filename2, js)), IsSuccess());
+
+    //file that is rewritten with the same size immediately after it was read
+    auto result1 = mio::read_confirmed_cases_data_table(filename1);
+    ASSERT_THAT(print_wrap(result1), IsSuccess());
+    js[0]["Confirmed"] = 4;
+    ASSERT_THAT(print_wrap(mio::write_json(filename1, js)), IsSuccess());
+    auto result2 = mio::read_confirmed_cases_data_table(filename1);
+    ASSERT_THAT(print_wrap(result2), IsSuccess());
+    EXPECT_EQ(result2.value()->get_entries().begin()->num_confirmed, 4);
+
+    //least recently used tables are removed from the cache
+    boost::filesystem::last_write_time(filename1, std::time(nullptr) - 3600);
+    boost::filesystem::last_write_time(filename2, std::time(nullptr) - 3600);
+    mio::set_epi_data_cache_capacity(1);
+    auto table1 = mio::read_confirmed_cases_data_table(filename1).value();
+    EXPECT_EQ(mio::read_confirmed_cases_data_table(filename1).value(), table1);
+    auto table2 = mio::read_confirmed_cases_data_table(filename2).value();
+    EXPECT_EQ(mio::read_confirmed_cases_data_table(filename2).value(), table2);
+    EXPECT_NE(mio::read_confirmed_cases_data_table(filename1).value(), table1);
+
+    //no caching
+    mio::set_epi_data_cache_capacity(0);
+    EXPECT_NE(mio::read_confirmed_cases_data_table(filename2).value(), table2);
+    EXPECT_NE(mio::read_confirmed_cases_data_table(filename2).value(),
+              mio::read_confirmed_cases_data_table(filename2).value());
+
+    //files are read in parallel and the results are cached
+    mio::set_epi_data_cache_capacity(4);
+    std::vector<mio::IOResult<std::shared_ptr<const mio::EpiDataTable<mio::ConfirmedCasesDataEntry>>>> results(
+        8, mio::failure(mio::StatusCode::UnknownError));
+    mio::parallel_for(
+        results.size(),
+        [&](size_t i) {
+            results[i] = mio::read_confirmed_cases_data_table(i % 2 == 0 ? filename1 : filename2);
+        },
+        4);
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_THAT(print_wrap(results[i]), IsSuccess());
+        EXPECT_EQ(results[i].value()->get_entries().begin()->num_confirmed, i % 2 == 0 ? 4 : 1);
+    }
+    EXPECT_EQ(mio::read_confirmed_cases_data_table(filename1).value(),
+              mio::read_confirmed_cases_data_table(filename1).value());
+}
+
+TEST(TestEpiDataIo, read_json_array_errors)
+{
+    TempFileRegister file_register;
+    auto filename = file_register.get_unique_path("rki-%%%%-%%%%.json");
+    auto write    = [&filename](const std::string& content) {
+        std::ofstream ofs(filename);
+        ofs << content;
+    };
+    auto count_objects = [&filename]() -> mio::IOResult<int> {
+        auto n = 0;
+        BOOST_OUTCOME_TRY(mio::details::read_json_array(filename, [&n](const Json::Value&) -> mio::IOResult<void> {
+            ++n;
+            return mio::success();
+        }));
+        return mio::success(n);
+    };
+
+    write(" [ ] ");
+    EXPECT_EQ(count_objects().value(), 0);
+    write("[{\"a\": \"}{\\\"\", \"b\": {\"c\": 1}}, {\"a\": 2}]");
+    EXPECT_EQ(count_objects().value(), 2);
+    write("{\"a\": 1}");
+    EXPECT_THAT(print_wrap(count_objects()), IsFailure(mio::StatusCode::InvalidType));
+    write("[1, 2]");
+    EXPECT_THAT(print_wrap(count_objects()), IsFailure(mio::StatusCode::InvalidType));
+    write("[{\"a\": 1}, {\"a\": 2}");
+    EXPECT_THAT(print_wrap(count_objects()), IsFailure(mio::StatusCode::UnknownError));
+    write("[{\"a\": 1} {\"a\": 2}]");
+    EXPECT_THAT(print_wrap(count_objects()), IsFailure(mio::StatusCode::UnknownError));
+    write("[{\"a\": }]");
+    EXPECT_THAT(print_wrap(count_objects()), IsFailure(mio::StatusCode::UnknownError));
+    EXPECT_THAT(print_wrap(mio::read_confirmed_cases_data(filename + ".notfound")),
+                IsFailure(mio::StatusCode::FileNotFound));
+}
+
 TEST(TestEpiDataIo, read_divi)
 {
     Json::Value js(Json::arrayValue);
@@ -53,6 +53,120 @@ TEST(TestGraph, duplicate_edge)
     EXPECT_EQ(g.edges()[1], (mio::Edge<int>{1, 2, 3}));
 }
 
+TEST(TestGraph, bulk_creation)
+{
+    std::vector<mio::Node<int>> n = {{0, 6}, {1, 4}, {2, 8}};
+    std::vector<mio::Edge<int>> e = {{2, 1, 3}, {1, 2, 2}, {0, 2, 4}, {0, 1, 1}};
+    mio::Graph<int, int> g(n, e);
+
+    EXPECT_THAT(g.nodes(), testing::ElementsAreArray(n));
+    std::vector<mio::Edge<int>> v = {{0, 1, 1}, {0, 2, 4}, {1, 2, 2}, {2, 1, 3}};
+    EXPECT_THAT(g.edges(), testing::ElementsAreArray(v));
+
+    std::vector<mio::Edge<int>> v0 = {{0, 1, 1}, {0, 2, 4}};
+    EXPECT_THAT(g.out_edges(0), testing::ElementsAreArray(v0));
+}
+
+TEST(TestGraph, bulk_creation_duplicate_edge)
+{
+    std::vector<mio::Node<int>> n = {{0, 6}, {1, 4}, {2, 8}};
+    std::vector<mio::Edge<int>> e = {{1, 2, 2}, {0, 1, 1}, {1, 2, 3}, {2, 1, 3}, {1, 2, 4}};
+    mio::Graph<int, int> g(n, e);
+
+    //same as adding the edges one by one, the last duplicate is kept
+    std::vector<mio::Edge<int>> v = {{0, 1, 1}, {1, 2, 4}, {2, 1, 3}};
+    EXPECT_THAT(g.edges(), testing::ElementsAreArray(v));
+}
+
+TEST(TestGraph, in_edges)
+{
+    mio::Graph<int, int> g;
+    g.add_node(0);
+    g.add_node(1);
+    g.add_node(2);
+    g.add_node(3);
+    g.add_edge(2, 1, 0);
+    g.add_edge(0, 1, 1);
+    g.add_edge(3, 0, 2);
+    g.add_edge(1, 2, 3);
+    g.add_edge(3, 1, 4);
+    g.add_edge(0, 1, 5);
+
+    std::vector<mio::Edge<int>> v0 = {{3, 0, 2}};
+    EXPECT_THAT(g.in_edges(0), testing::ElementsAreArray(v0));
+    std::vector<mio::Edge<int>> v1 = {{0, 1, 5}, {2, 1, 0}, {3, 1, 4}};
+    EXPECT_THAT(g.in_edges(1), testing::ElementsAreArray(v1));
+    std::vector<mio::Edge<int>> v2 = {{1, 2, 3}};
+    EXPECT_THAT(g.in_edges(2), testing::ElementsAreArray(v2));
+    EXPECT_EQ(g.in_edges(3).size(), 0);
+
+    //in edges refer to the edges of the graph
+    g.in_edges(1)[1].property = 7;
+    EXPECT_EQ(g.edges()[2], (mio::Edge<int>{2, 1, 7}));
+}
+
+TEST(TestGraph, edge_offsets)
+{
+    mio::Graph<int, int> g;
+    g.add_node(0);
+    g.add_node(1);
+    g.add_node(2);
+    g.add_edge(2, 0, 0);
+    g.add_edge(0, 2, 1);
+    g.add_edge(0, 1, 2);
+
+    EXPECT_THAT(g.out_edge_offsets(), testing::ElementsAre(0, 2, 2, 3));
+    EXPECT_THAT(g.in_edge_offsets(), testing::ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(g.in_edge_indices(), testing::ElementsAre(2, 0, 1));
+
+    //offsets are updated after adding more nodes and edges
+    g.add_node(3);
+    g.add_edge(3, 1, 3);
+    g.add_edge(1, 0, 4);
+    EXPECT_THAT(g.out_edge_offsets(), testing::ElementsAre(0, 2, 3, 4, 5));
+    EXPECT_THAT(g.in_edge_offsets(), testing::ElementsAre(0, 2, 4, 5, 5));
+    EXPECT_THAT(g.in_edge_indices(), testing::ElementsAre(2, 3, 0, 4, 1));
+}
+
+TEST(TestGraph, add_edges)
+{
+    mio::Graph<int, int> g;
+    g.add_node(0);
+    g.add_node(1);
+    g.add_node(2);
+    g.add_edge(0, 1, 0);
+    g.add_edge(1, 2, 1);
+    g.add_edges({{2, 0, 2}, {0, 1, 3}, {1, 0, 4}});
+
+    std::vector<mio::Edge<int>> v = {{0, 1, 3}, {1, 0, 4}, {1, 2, 1}, {2, 0, 2}};
+    EXPECT_THAT(g.edges(), testing::ElementsAreArray(v));
+    std::vector<mio::Edge<int>> v1 = {{1, 0, 4}, {1, 2, 1}};
+    EXPECT_THAT(g.out_edges(1), testing::ElementsAreArray(v1));
+    std::vector<mio::Edge<int>> v0 = {{1, 0, 4}, {2, 0, 2}};
+    EXPECT_THAT(g.in_edges(0), testing::ElementsAreArray(v0));
+}
+
+TEST(TestGraph, builder)
+{
+    mio::GraphBuilder<int, int> builder;
+    builder.reserve(3, 4);
+    builder.add_node(0, 6);
+    builder.add_edge(2, 1, 3);
+    builder.add_node(1, 4);
+    builder.add_node(2, 8);
+    builder.add_edge(1, 2, 2);
+    builder.add_edge(0, 1, 1);
+    builder.add_edge(1, 2, 4);
+    auto g = builder.build();
+
+    std::vector<mio::Node<int>> n = {{0, 6}, {1, 4}, {2, 8}};
+    EXPECT_THAT(g.nodes(), testing::ElementsAreArray(n));
+    std::vector<mio::Edge<int>> v = {{0, 1, 1}, {1, 2, 4}, {2, 1, 3}};
+    EXPECT_THAT(g.edges(), testing::ElementsAreArray(v));
+    std::vector<mio::Edge<int>> v1 = {{0, 1, 1}, {2, 1, 3}};
+    EXPECT_THAT(g.in_edges(1), testing::ElementsAreArray(v1));
+}
+
 TEST(TestGraph, graph_without_edges)
 {
     struct MockModel {
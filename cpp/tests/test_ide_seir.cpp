@@ -21,6 +21,7 @@
 #include "ide_seir/model.h"
 #include "ide_seir/parameters.h"
 #include "memilio/math/eigen.h"
+#include "memilio/utils/logging.h"
 #include "memilio/utils/time_series.h"
 #include "memilio/epidemiology/uncertain_matrix.h"
 #include <gtest/gtest.h>
@@ -76,4 +77,29 @@ TEST_F(IdeSeirModelTest, compareWithPreviousRun)
             ASSERT_NEAR(sim_result.get_value(i)[j - 1], compare[i][j], 1e-8) << " at row " << i;
         }
     }
-}
\ No newline at end of file
+}
+TEST_F(IdeSeirModelTest, simulateInParts)
+{
+    //copy of the model for the reference before anything is simulated
+    auto model_parts = *model;
+
+    auto& result = model->simulate(15);
+    model_parts.simulate(7);
+    auto& result_parts = model_parts.simulate(15);
+
+    ASSERT_EQ(result_parts.get_num_time_points(), result.get_num_time_points());
+    for (Eigen::Index i = 0; i < result.get_num_time_points(); i++) {
+        ASSERT_NEAR(result_parts.get_time(i), result.get_time(i), 1e-12) << "at row " << i;
+        ASSERT_NEAR(result_parts[i][0], result[i][0], 1e-8) << "at row " << i;
+    }
+}
+
+TEST_F(IdeSeirModelTest, latencyTimeShorterThanTwoTimeSteps)
+{
+    mio::set_log_level(mio::LogLevel::off);
+    auto num_time_points = model->simulate(0).get_num_time_points();
+    model->parameters.set<mio::iseir::LatencyTime>(0.15);
+    auto& result = model->simulate(15);
+    EXPECT_EQ(result.get_num_time_points(), num_time_points);
+    mio::set_log_level(mio::LogLevel::warn);
+}
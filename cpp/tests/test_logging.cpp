@@ -0,0 +1,88 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/utils/logging.h"
+#include "gtest/gtest.h"
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+
+namespace
+{
+//replaces the default logger with a logger that writes to a string
+struct ScopedStringLogger {
+    ScopedStringLogger()
+        : old_logger(spdlog::default_logger())
+    {
+        auto sink   = std::make_shared<spdlog::sinks::ostream_sink_mt>(stream);
+        auto logger = std::make_shared<spdlog::logger>("test", sink);
+        logger->set_pattern("%v");
+        logger->set_level(spdlog::level::trace);
+        spdlog::set_default_logger(logger);
+    }
+    ~ScopedStringLogger()
+    {
+        spdlog::set_default_logger(old_logger);
+    }
+    std::ostringstream stream;
+    std::shared_ptr<spdlog::logger> old_logger;
+};
+} // namespace
+
+TEST(TestLogging, levelCompiled)
+{
+    static_assert(mio::is_log_level_compiled(mio::LogLevel::off), "off is always compiled.");
+    EXPECT_EQ(mio::is_log_level_compiled(mio::LogLevel::trace), mio::log_level_min == mio::LogLevel::trace);
+    EXPECT_EQ(mio::is_log_level_compiled(mio::LogLevel::warn), mio::log_level_min <= mio::LogLevel::warn);
+}
+
+TEST(TestLogging, messages)
+{
+    ScopedStringLogger logger;
+    mio::log_warning("warning {}", 1);
+    mio::log_debug("debug {}", 2);
+    mio::log(mio::LogLevel::err, "error {}", 3);
+    std::string expected;
+    if (mio::is_log_level_compiled(mio::LogLevel::warn)) {
+        expected += "warning 1\n";
+    }
+    if (mio::is_log_level_compiled(mio::LogLevel::debug)) {
+        expected += "debug 2\n";
+    }
+    if (mio::is_log_level_compiled(mio::LogLevel::err)) {
+        expected += "error 3\n";
+    }
+    EXPECT_EQ(logger.stream.str(), expected);
+}
+
+TEST(TestLogging, async)
+{
+    ScopedStringLogger logger;
+    mio::enable_async_logging();
+    for (int i = 0; i < 100; ++i) {
+        mio::log(mio::LogLevel::critical, "message {}", i);
+    }
+    mio::disable_async_logging();
+
+    //all messages are written in order when async logging is disabled
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        expected += "message " + std::to_string(i) + "\n";
+    }
+    EXPECT_EQ(logger.stream.str(), expected);
+}
@@ -20,6 +20,7 @@
 #define _USE_MATH_DEFINES
 
 #include "memilio/mobility/mobility.h"
+#include "memilio/mobility/coupled_migration.h"
 #include "ode_seir/model.h"
 #include "ode_seir/infection_state.h"
 #include "ode_seir/parameters.h"
@@ -106,6 +107,75 @@ TEST(TestMobility, nodeEvolve)
     node.evolve(t0, dt);
     ASSERT_DOUBLE_EQ(node.get_result().get_last_time(), t0 + dt);
     ASSERT_EQ(print_wrap(node.get_result().get_last_value()), print_wrap(node.get_last_state()));
+
+    //states at the start of the last steps are stored
+    node.evolve(t0 + dt, dt);
+    node.evolve(t0 + 2 * dt, dt);
+    EXPECT_EQ(node.get_step_start_state(t0), nullptr);
+    ASSERT_NE(node.get_step_start_state(t0 + dt), nullptr);
+    ASSERT_NE(node.get_step_start_state(t0 + 2 * dt), nullptr);
+    EXPECT_EQ(print_wrap(*node.get_step_start_state(t0 + dt)),
+              print_wrap(*mio::find_value_reverse(node.get_result(), t0 + dt, 1e-10, 1e-10)));
+    EXPECT_EQ(print_wrap(*node.get_step_start_state(t0 + 2 * dt)),
+              print_wrap(*mio::find_value_reverse(node.get_result(), t0 + 2 * dt, 1e-10, 1e-10)));
+}
+
+TEST(TestMobility, nodeCachedValues)
+{
+    using Model = mio::osecir::Model;
+    Model model(1);
+    model.populations[{mio::AgeGroup(0), mio::osecir::InfectionState::InfectedSymptoms}] = 100;
+    model.populations.set_difference_from_total({mio::AgeGroup(0), mio::osecir::InfectionState::Susceptible}, 1000);
+    model.parameters.get<mio::osecir::IncubationTime>()[mio::AgeGroup(0)] = 5.2;
+    model.parameters.get<mio::osecir::SerialInterval>()[mio::AgeGroup(0)] = 4.2;
+    model.parameters.apply_constraints();
+
+    double t0 = 0.0;
+    double dt = 0.5;
+    mio::SimulationNode<mio::osecir::Simulation<>> node(model, t0);
+
+    auto expect_values_at = [&node](double t) {
+        auto& factors = node.get_migration_factors_cached(t);
+        EXPECT_EQ(print_wrap(factors), print_wrap(get_migration_factors(node, t, node.get_last_state()).eval()));
+        //same object for all edges
+        EXPECT_EQ(&factors, &node.get_migration_factors_cached(t));
+        EXPECT_DOUBLE_EQ(node.get_infections_relative_cached(t),
+                         get_infections_relative(node, t, node.get_last_state()));
+    };
+    expect_values_at(t0);
+    node.evolve(t0, dt);
+    expect_values_at(t0 + dt);
+}
+
+TEST(TestMobility, integratorStatistics)
+{
+    using Model = mio::osecir::Model;
+    Model model(1);
+    model.populations[{mio::AgeGroup(0), mio::osecir::InfectionState::InfectedSymptoms}] = 100;
+    model.populations.set_difference_from_total({mio::AgeGroup(0), mio::osecir::InfectionState::Susceptible}, 1000);
+    model.parameters.get<mio::osecir::IncubationTime>()[mio::AgeGroup(0)] = 5.2;
+    model.parameters.get<mio::osecir::SerialInterval>()[mio::AgeGroup(0)] = 4.2;
+    model.parameters.apply_constraints();
+
+    mio::Graph<mio::SimulationNode<mio::Simulation<Model>>, mio::MigrationEdge> g;
+    g.add_node(0, model, 0.0);
+    g.add_node(1, model, 0.0);
+    g.add_edge(0, 1, Eigen::VectorXd::Constant(Eigen::Index(mio::osecir::InfectionState::Count), 0.1));
+    auto sim = mio::make_migration_sim(0.0, 0.5, std::move(g));
+    sim.advance(3.0);
+
+    auto nodes = sim.get_graph().nodes();
+    auto stats = mio::get_integrator_statistics(sim.get_graph());
+    EXPECT_GT(nodes[0].property.get_integrator_statistics().num_accepted_steps, 0);
+    EXPECT_EQ(stats.num_accepted_steps, nodes[0].property.get_integrator_statistics().num_accepted_steps +
+                                            nodes[1].property.get_integrator_statistics().num_accepted_steps);
+    EXPECT_EQ(stats.num_rhs_evaluations, nodes[0].property.get_integrator_statistics().num_rhs_evaluations +
+                                             nodes[1].property.get_integrator_statistics().num_rhs_evaluations);
+
+    std::vector<mio::Graph<mio::SimulationNode<mio::Simulation<Model>>, mio::MigrationEdge>> ensemble;
+    ensemble.push_back(std::move(sim).get_graph());
+    auto ensemble_stats = mio::get_integrator_statistics(ensemble);
+    EXPECT_EQ(ensemble_stats.num_accepted_steps, stats.num_accepted_steps);
 }
 
 TEST(TestMobility, edgeApplyMigration)
@@ -167,3 +237,238 @@ TEST(TestMobility, edgeApplyMigration)
     EXPECT_DOUBLE_EQ(node1.get_result().get_last_value().sum(), 900);
     EXPECT_DOUBLE_EQ(node2.get_result().get_last_value().sum(), 1100);
 }
+
+TEST(TestMobility, edgeApplyMigrationSparse)
+{
+    using Model = mio::osecir::Model;
+
+    Model model(2);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(2); ++i) {
+        model.populations[{i, mio::osecir::InfectionState::Exposed}]          = 20;
+        model.populations[{i, mio::osecir::InfectionState::InfectedSymptoms}] = 10;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>(
+            {i, mio::osecir::InfectionState::Susceptible}, 1000);
+        model.parameters.get<mio::osecir::IncubationTime>()[i] = 5.2;
+        model.parameters.get<mio::osecir::SerialInterval>()[i] = 4.2;
+    }
+    model.parameters.apply_constraints();
+    double t = 0.0;
+    mio::SimulationNode<mio::osecir::Simulation<>> node1(model, t);
+    mio::SimulationNode<mio::osecir::Simulation<>> node2(model, t);
+
+    //only susceptible and exposed of the second age group migrate
+    auto num_compartments  = Eigen::Index(mio::osecir::InfectionState::Count);
+    Eigen::VectorXd coeffs = Eigen::VectorXd::Zero(2 * num_compartments);
+    coeffs[num_compartments + Eigen::Index(mio::osecir::InfectionState::Susceptible)] = 0.1;
+    coeffs[num_compartments + Eigen::Index(mio::osecir::InfectionState::Exposed)]     = 0.5;
+    mio::MigrationEdge edge(coeffs);
+    EXPECT_THAT(edge.get_migrating_indices(),
+                testing::ElementsAre(num_compartments + Eigen::Index(mio::osecir::InfectionState::Susceptible),
+                                     num_compartments + Eigen::Index(mio::osecir::InfectionState::Exposed)));
+
+    //forward migration
+    Eigen::VectorXd y1 = node1.get_result().get_last_value();
+    edge.apply_migration(t, 0.5, node1, node2);
+    Eigen::VectorXd migrated = (coeffs.array() * y1.array()).matrix();
+    EXPECT_THAT(print_wrap(node1.get_result().get_last_value()), MatrixNear(y1 - migrated));
+    EXPECT_THAT(print_wrap(node2.get_result().get_last_value()), MatrixNear(y1 + migrated));
+
+    //returns, migrants may have changed compartments
+    node1.evolve(t, 0.5);
+    node2.evolve(t, 0.5);
+    t += 0.5;
+    edge.apply_migration(t, 0.5, node1, node2);
+    auto v1 = node1.get_result().get_last_value();
+    auto v2 = node2.get_result().get_last_value();
+    EXPECT_NEAR(v1.head(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_NEAR(v1.tail(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_NEAR(v2.head(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_NEAR(v2.tail(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_TRUE((v1.array() >= 0.0).all());
+    EXPECT_TRUE((v2.array() >= 0.0).all());
+}
+
+TEST(TestMobility, edgeSparseCoefficientsWithDampings)
+{
+    using Model = mio::osecir::Model;
+
+    Model model(2);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(2); ++i) {
+        model.populations[{i, mio::osecir::InfectionState::Exposed}] = 20;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>(
+            {i, mio::osecir::InfectionState::Susceptible}, 1000);
+    }
+    model.parameters.apply_constraints();
+    double t = 2.0;
+    mio::SimulationNode<mio::osecir::Simulation<>> node1(model, t);
+    mio::SimulationNode<mio::osecir::Simulation<>> node2(model, t);
+
+    //only the susceptible of the first age group migrate, the migration is halved by a damping
+    auto num_compartments  = Eigen::Index(mio::osecir::InfectionState::Count);
+    Eigen::VectorXd coeffs = Eigen::VectorXd::Zero(2 * num_compartments);
+    coeffs[Eigen::Index(mio::osecir::InfectionState::Susceptible)] = 0.1;
+    mio::MigrationParameters params(coeffs);
+    params.get_coefficients().add_damping(Eigen::VectorXd::Constant(2 * num_compartments, 0.5),
+                                          mio::DampingLevel(0), mio::DampingType(0), mio::SimulationTime(1.0));
+    mio::MigrationEdge edge(params);
+
+    //the parameters of all compartments are restored from the stored coefficients
+    auto edge_params = edge.get_parameters();
+    ASSERT_EQ(edge_params.get_coefficients().get_shape().rows(), 2 * num_compartments);
+    ASSERT_EQ(edge_params.get_coefficients()[0].get_dampings().size(), 1);
+    EXPECT_THAT(print_wrap(edge_params.get_coefficients().get_matrix_at(0.0)), MatrixNear(coeffs));
+    EXPECT_THAT(print_wrap(edge_params.get_coefficients().get_matrix_at(t)), MatrixNear(0.5 * coeffs));
+
+    Eigen::VectorXd y1 = node1.get_result().get_last_value();
+    edge.apply_migration(t, 0.5, node1, node2);
+    Eigen::VectorXd migrated = (0.5 * coeffs.array() * y1.array()).matrix();
+    EXPECT_THAT(print_wrap(node1.get_result().get_last_value()), MatrixNear(y1 - migrated));
+    EXPECT_THAT(print_wrap(node2.get_result().get_last_value()), MatrixNear(y1 + migrated));
+}
+
+namespace mobility_test
+{
+class DetectingSimulation : public mio::osecir::Simulation<>
+{
+public:
+    using mio::osecir::Simulation<>::Simulation;
+};
+
+//half of the symptomatic commuters are detected and travel as severe, which doesn't migrate otherwise.
+//the detected commuters are moved in the home node first, so they can be subtracted from the new compartment
+void test_commuters(DetectingSimulation& sim, Eigen::Ref<Eigen::VectorXd> migrated, double /*time*/)
+{
+    auto& populations = sim.get_model().populations;
+    for (auto i = mio::AgeGroup(0); i < sim.get_model().parameters.get_num_groups(); ++i) {
+        auto ISy      = populations.get_flat_index({i, mio::osecir::InfectionState::InfectedSymptoms});
+        auto ISev     = populations.get_flat_index({i, mio::osecir::InfectionState::InfectedSevere});
+        auto detected = 0.5 * migrated[ISy];
+        sim.get_result().get_last_value()[ISy] -= detected;
+        sim.get_result().get_last_value()[ISev] += detected;
+        migrated[ISy] -= detected;
+        migrated[ISev] += detected;
+    }
+}
+} // namespace mobility_test
+
+TEST(TestMobility, edgeApplyMigrationTestCommutersToNonMigratingCompartment)
+{
+    using Model = mio::osecir::Model;
+
+    Model model(2);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(2); ++i) {
+        model.populations[{i, mio::osecir::InfectionState::InfectedSymptoms}] = 100;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>(
+            {i, mio::osecir::InfectionState::Susceptible}, 1000);
+        model.parameters.get<mio::osecir::RiskOfInfectionFromSymptomatic>()[i]    = 1.0;
+        model.parameters.get<mio::osecir::MaxRiskOfInfectionFromSymptomatic>()[i] = 1.0;
+    }
+    model.parameters.apply_constraints();
+    double t = 0.0;
+    mio::SimulationNode<mobility_test::DetectingSimulation> node1(model, t);
+    mio::SimulationNode<mobility_test::DetectingSimulation> node2(model, t);
+
+    //only susceptible and symptomatic migrate
+    auto num_compartments  = Eigen::Index(mio::osecir::InfectionState::Count);
+    auto S                 = Eigen::Index(mio::osecir::InfectionState::Susceptible);
+    auto ISy               = Eigen::Index(mio::osecir::InfectionState::InfectedSymptoms);
+    auto ISev              = Eigen::Index(mio::osecir::InfectionState::InfectedSevere);
+    Eigen::VectorXd coeffs = Eigen::VectorXd::Zero(2 * num_compartments);
+
+    coeffs[S]                    = 0.1;
+    coeffs[ISy]                  = 0.2;
+    coeffs[num_compartments + S] = 0.1;
+    mio::MigrationEdge edge(coeffs);
+    EXPECT_THAT(edge.get_migrating_indices(), testing::ElementsAre(S, ISy, num_compartments + S));
+
+    //forward migration, detected commuters travel in a compartment that wasn't migrating before
+    edge.apply_migration(t, 0.5, node1, node2);
+    EXPECT_THAT(edge.get_migrating_indices(), testing::ElementsAre(S, ISy, ISev, num_compartments + S));
+    EXPECT_NEAR(node1.get_result().get_last_value()[ISy], 80.0, 1e-10);
+    EXPECT_NEAR(node1.get_result().get_last_value()[ISev], 0.0, 1e-10);
+    EXPECT_NEAR(node2.get_result().get_last_value()[ISy], 110.0, 1e-10);
+    EXPECT_NEAR(node2.get_result().get_last_value()[ISev], 10.0, 1e-10);
+
+    //everyone returns
+    node1.evolve(t, 0.5);
+    node2.evolve(t, 0.5);
+    t += 0.5;
+    edge.apply_migration(t, 0.5, node1, node2);
+    auto v1 = node1.get_result().get_last_value();
+    auto v2 = node2.get_result().get_last_value();
+    EXPECT_NEAR(v1.head(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_NEAR(v1.tail(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_NEAR(v2.head(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_NEAR(v2.tail(num_compartments).sum(), 1000, 1e-10);
+    EXPECT_TRUE((v1.array() >= 0.0).all());
+    EXPECT_TRUE((v2.array() >= 0.0).all());
+}
+
+TEST(TestMobility, coupledNoMigrationSameAsSingleIntegration)
+{
+    mio::oseir::Model model1;
+    model1.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Susceptible)}] = 0.9;
+    model1.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Exposed)}]     = 0.1;
+    model1.populations.set_total(1000);
+    model1.parameters.get<mio::oseir::ContactPatterns>().get_baseline()(0, 0) = 10;
+    model1.parameters.set<mio::oseir::TransmissionProbabilityOnContact>(0.4);
+    auto model2 = model1;
+    model2.populations.set_total(500);
+
+    mio::Graph<mio::oseir::Model, mio::MigrationParameters> graph;
+    graph.add_node(0, model1);
+    graph.add_node(1, model2);
+    graph.add_edge(0, 1, Eigen::VectorXd::Constant(4, 0)); //no migration along this edge
+    graph.add_edge(1, 0, Eigen::VectorXd::Constant(4, 0));
+
+    mio::CoupledMigrationSimulation<mio::oseir::Model> coupled_sim(graph, 0.0, 0.5);
+    coupled_sim.set_integrator(std::make_shared<mio::EulerIntegratorCore>());
+    coupled_sim.set_num_threads(2);
+    coupled_sim.advance(5.0);
+
+    auto single_sim1 = mio::Simulation<mio::oseir::Model>(model1, 0.0, 0.5);
+    auto single_sim2 = mio::Simulation<mio::oseir::Model>(model2, 0.0, 0.5);
+    single_sim1.set_integrator(std::make_shared<mio::EulerIntegratorCore>());
+    single_sim2.set_integrator(std::make_shared<mio::EulerIntegratorCore>());
+    single_sim1.advance(5.0);
+    single_sim2.advance(5.0);
+
+    auto result1 = coupled_sim.get_node_result(0);
+    auto result2 = coupled_sim.get_node_result(1);
+    ASSERT_EQ(result1.get_num_time_points(), single_sim1.get_result().get_num_time_points());
+    EXPECT_DOUBLE_EQ(result1.get_last_time(), 5.0);
+    EXPECT_NEAR((result1.get_last_value() - single_sim1.get_result().get_last_value()).norm(), 0.0, 1e-10);
+    EXPECT_NEAR((result2.get_last_value() - single_sim2.get_result().get_last_value()).norm(), 0.0, 1e-10);
+}
+
+TEST(TestMobility, coupledMigrationEquilibrium)
+{
+    //no infections, only commuting
+    mio::oseir::Model model;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Susceptible)}] = 1000;
+    auto model2 = model;
+    model2.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Susceptible)}] = 200;
+
+    auto commute_duration = 0.5;
+    auto coeff            = 0.2;
+    mio::Graph<mio::oseir::Model, mio::MigrationParameters> graph;
+    graph.add_node(0, model);
+    graph.add_node(1, model2);
+    graph.add_edge(0, 1, Eigen::VectorXd::Constant(4, coeff));
+
+    mio::CoupledMigrationSimulation<mio::oseir::Model> coupled_sim(graph, 0.0, 0.1, commute_duration);
+    auto y = coupled_sim.advance(30.0);
+
+    //residents at home, residents of node 1 and commuters from node 0 to node 1
+    ASSERT_EQ(y.size(), 12);
+    auto expected_home = 1000 / (1 + coeff * commute_duration);
+    EXPECT_NEAR(y[0], expected_home, 1e-3);
+    EXPECT_NEAR(y[4], 200, 1e-10);
+    EXPECT_NEAR(y[8], 1000 - expected_home, 1e-3);
+
+    //population is conserved
+    auto& result = coupled_sim.get_result();
+    for (Eigen::Index i = 0; i < result.get_num_time_points(); ++i) {
+        EXPECT_NEAR(coupled_sim.get_node_result(0)[i].sum(), 1000, 1e-8);
+    }
+}
@@ -22,6 +22,8 @@
 #include "memilio/utils/logging.h"
 #include "memilio/math/eigen.h"
 #include "matchers.h"
+#include "temp_file_register.h"
+#include "ode_secir/model.h"
 
 #include <gtest/gtest.h>
 
@@ -116,3 +118,159 @@ TEST(TestReadMigration, readPlain)
     ASSERT_EQ(test_matrix.cols(), matrix_read.value().cols());
     ASSERT_EQ(print_wrap(test_matrix), print_wrap(matrix_read.value()));
 }
+
+TEST(TestReadMigration, readFormattedSparse)
+{
+    TempFileRegister file_register;
+    auto filename = file_register.get_unique_path("test_twitter-%%%%-%%%%.txt");
+    {
+        std::ofstream file(filename);
+        file << "from_str\tto_str\tfrom_rs\tto_rs\tcount_abs\n";
+        file << "Narnia\tHogwarts\t150\t42\t1.5\n";
+        file << "Hogwarts\tNarnia\t42\t150\t2.5\r\n";
+        file << "Westeros\tNarnia\t7\t150\t3.0";
+    }
+
+    auto matrix_read = mio::read_mobility_formatted_sparse(filename);
+    ASSERT_THAT(print_wrap(matrix_read), IsSuccess());
+    auto& m = matrix_read.value();
+    ASSERT_EQ(m.rows(), 3);
+    ASSERT_EQ(m.cols(), 3);
+    EXPECT_EQ(m.nonZeros(), 3);
+    EXPECT_EQ(m.coeff(2, 1), 1.5);
+    EXPECT_EQ(m.coeff(1, 2), 2.5);
+    EXPECT_EQ(m.coeff(0, 2), 3.0);
+
+    auto dense_read = mio::read_mobility_formatted(filename);
+    ASSERT_THAT(print_wrap(dense_read), IsSuccess());
+    EXPECT_EQ(print_wrap(dense_read.value()), print_wrap(Eigen::MatrixXd(m)));
+}
+
+TEST(TestReadMigration, readFormattedInvalid)
+{
+    TempFileRegister file_register;
+    auto filename = file_register.get_unique_path("test_twitter-%%%%-%%%%.txt");
+    {
+        std::ofstream file(filename);
+        file << "from_str\tto_str\tfrom_rs\tto_rs\tcount_abs\n";
+        file << "Narnia\tHogwarts\t150\t42\n";
+    }
+    EXPECT_THAT(print_wrap(mio::read_mobility_formatted(filename)), IsFailure(mio::StatusCode::InvalidFileFormat));
+    {
+        std::ofstream file(filename);
+        file << "from_str\tto_str\tfrom_rs\tto_rs\tcount_abs\n";
+        file << "Narnia\tHogwarts\t150\tabc\t1.0\n";
+    }
+    EXPECT_THAT(print_wrap(mio::read_mobility_formatted(filename)), IsFailure(mio::StatusCode::InvalidFileFormat));
+    {
+        //destination is not an origin
+        std::ofstream file(filename);
+        file << "from_str\tto_str\tfrom_rs\tto_rs\tcount_abs\n";
+        file << "Narnia\tHogwarts\t150\t42\t1.0\n";
+    }
+    EXPECT_THAT(print_wrap(mio::read_mobility_formatted(filename)), IsFailure(mio::StatusCode::InvalidFileFormat));
+}
+
+TEST(TestReadMigration, readPlainSparse)
+{
+    auto dense_read  = mio::read_mobility_plain(get_test_data_file_path("contacts.txt"));
+    auto sparse_read = mio::read_mobility_plain_sparse(get_test_data_file_path("contacts.txt"));
+    ASSERT_THAT(print_wrap(dense_read), IsSuccess());
+    ASSERT_THAT(print_wrap(sparse_read), IsSuccess());
+    EXPECT_EQ(print_wrap(dense_read.value()), print_wrap(Eigen::MatrixXd(sparse_read.value())));
+}
+
+TEST(TestReadMigration, readPlainInvalid)
+{
+    TempFileRegister file_register;
+    auto filename = file_register.get_unique_path("test_plain-%%%%-%%%%.txt");
+    {
+        std::ofstream file(filename);
+        file << "1.0 0.0 \n0.0  2.0\n";
+    }
+    auto matrix_read = mio::read_mobility_plain(filename);
+    ASSERT_THAT(print_wrap(matrix_read), IsSuccess());
+    EXPECT_EQ(print_wrap(matrix_read.value()), print_wrap((Eigen::MatrixXd(2, 2) << 1.0, 0.0, 0.0, 2.0).finished()));
+    auto sparse_read = mio::read_mobility_plain_sparse(filename);
+    ASSERT_THAT(print_wrap(sparse_read), IsSuccess());
+    EXPECT_EQ(sparse_read.value().nonZeros(), 2);
+
+    {
+        std::ofstream file(filename);
+        file << "1.0 0.0\n0.0\n";
+    }
+    EXPECT_THAT(print_wrap(mio::read_mobility_plain(filename)), IsFailure(mio::StatusCode::InvalidFileFormat));
+    {
+        std::ofstream file(filename);
+        file << "1.0 0.0\n0.0 x\n";
+    }
+    EXPECT_THAT(print_wrap(mio::read_mobility_plain(filename)), IsFailure(mio::StatusCode::InvalidFileFormat));
+    {
+        std::ofstream file(filename);
+        file << "1.0 0.0\n0.0 1.0\n1.0 1.0\n";
+    }
+    EXPECT_THAT(print_wrap(mio::read_mobility_plain(filename)), IsFailure(mio::StatusCode::InvalidFileFormat));
+}
+
+#ifdef MEMILIO_HAS_JSONCPP
+
+TEST(TestReadGraph, json_graph)
+{
+    mio::osecir::Model model(1);
+    model.populations[{mio::AgeGroup(0), mio::osecir::InfectionState::Susceptible}] = 1000.0;
+    model.populations[{mio::AgeGroup(0), mio::osecir::InfectionState::Exposed}]     = 10.0;
+
+    //enough nodes and edges so that multiple threads are used
+    const size_t num_nodes = 8;
+    mio::Graph<mio::osecir::Model, mio::MigrationParameters> graph;
+    for (size_t i = 0; i < num_nodes; ++i) {
+        graph.add_node(int(1000 + i), model);
+    }
+    for (size_t i = 0; i < num_nodes; ++i) {
+        for (size_t j = num_nodes; j-- > 0;) {
+            if (i != j) {
+                graph.add_edge(i, j, Eigen::VectorXd::Constant(model.populations.get_num_compartments(), 0.1 * j));
+            }
+        }
+    }
+
+    TempFileRegister file_register;
+    auto graph_dir = file_register.get_unique_path("graph_parameters-%%%%-%%%%");
+    ASSERT_THAT(print_wrap(mio::write_graph(graph, graph_dir)), IsSuccess());
+
+    auto read_result = mio::read_graph<mio::osecir::Model>(graph_dir);
+    ASSERT_THAT(print_wrap(read_result), IsSuccess());
+    auto& graph_read = read_result.value();
+    ASSERT_EQ(graph_read.nodes().size(), graph.nodes().size());
+    ASSERT_EQ(graph_read.edges().size(), graph.edges().size());
+    for (size_t i = 0; i < graph.nodes().size(); ++i) {
+        EXPECT_EQ(graph_read.nodes()[i].id, graph.nodes()[i].id);
+        EXPECT_EQ(print_wrap(graph_read.nodes()[i].property.populations.get_compartments()),
+                  print_wrap(graph.nodes()[i].property.populations.get_compartments()));
+    }
+    for (size_t i = 0; i < graph.edges().size(); ++i) {
+        EXPECT_EQ(graph_read.edges()[i].start_node_idx, graph.edges()[i].start_node_idx);
+        EXPECT_EQ(graph_read.edges()[i].end_node_idx, graph.edges()[i].end_node_idx);
+        EXPECT_EQ(print_wrap(graph_read.edges()[i].property.get_coefficients()[0].get_baseline()),
+                  print_wrap(graph.edges()[i].property.get_coefficients()[0].get_baseline()));
+    }
+}
+
+TEST(TestReadGraph, json_graph_missing_file)
+{
+    mio::osecir::Model model(1);
+    mio::Graph<mio::osecir::Model, mio::MigrationParameters> graph;
+    graph.add_node(0, model);
+    graph.add_node(1, model);
+    graph.add_edge(0, 1, Eigen::VectorXd::Constant(model.populations.get_num_compartments(), 0.1));
+
+    TempFileRegister file_register;
+    auto graph_dir = file_register.get_unique_path("graph_parameters-%%%%-%%%%");
+    ASSERT_THAT(print_wrap(mio::write_graph(graph, graph_dir)), IsSuccess());
+    boost::filesystem::remove(mio::path_join(graph_dir, "GraphEdges_node1.json"));
+
+    auto read_result = mio::read_graph<mio::osecir::Model>(graph_dir);
+    EXPECT_THAT(print_wrap(read_result), IsFailure(mio::StatusCode::FileNotFound));
+}
+
+#endif //MEMILIO_HAS_JSONCPP
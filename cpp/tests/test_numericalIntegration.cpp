@@ -20,6 +20,7 @@
 #include "memilio/math/euler.h"
 #include "memilio/math/adapt_rk.h"
 #include "memilio/math/stepper_wrapper.h"
+#include "memilio/math/rosenbrock.h"
 #include <actions.h>
 
 #include <gtest/gtest.h>
@@ -29,6 +30,7 @@
 #include <fstream>
 #include <ios>
 #include <cmath>
+#include <numeric>
 
 void sin_deriv(Eigen::Ref<Eigen::VectorXd const> /*y*/, const double t, Eigen::Ref<Eigen::VectorXd> dydt)
 {
@@ -251,3 +253,230 @@ TEST(TestOdeIntegrator, integratorContinuesAtLastState)
     integrator.advance(4 * dt);
     integrator.advance(5 * dt);
 }
+
+TEST(TestOdeIntegrator, statistics)
+{
+    auto f          = [](auto&&, auto&&, auto&&) {};
+    auto integrator = mio::OdeIntegrator(f, 0, Eigen::VectorXd::Constant(1, 0.0), 0.25,
+                                         std::make_shared<testing::NiceMock<MockIntegratorCore>>());
+    integrator.advance(1.0);
+    auto& stats = integrator.get_statistics();
+    EXPECT_EQ(stats.num_accepted_steps, 4);
+    EXPECT_EQ(stats.num_rejected_steps, 0);
+    EXPECT_EQ(stats.num_rhs_evaluations, 0);
+    EXPECT_DOUBLE_EQ(stats.min_dt, 0.25);
+    EXPECT_DOUBLE_EQ(stats.max_dt, 0.25);
+    EXPECT_EQ(stats.dt_histogram[mio::IntegratorStatistics::get_dt_bucket(0.25)], 4);
+
+    //step that is shortened to stop at tmax is counted, but its size is not recorded
+    integrator.advance(1.1);
+    EXPECT_EQ(integrator.get_statistics().num_accepted_steps, 5);
+    EXPECT_DOUBLE_EQ(integrator.get_statistics().min_dt, 0.25);
+
+    integrator.reset_statistics();
+    EXPECT_EQ(integrator.get_statistics().num_accepted_steps, 0);
+}
+
+TEST(TestOdeIntegrator, statisticsAdaptive)
+{
+    size_t num_calls = 0;
+    auto f           = [&num_calls](auto&& y, auto&&, auto&& dydt) {
+        ++num_calls;
+        dydt = -y;
+    };
+    //initial step is much too large for the tolerances
+    auto integrator = mio::OdeIntegrator(f, 0, Eigen::VectorXd::Constant(1, 1.0), 10.0,
+                                         std::make_shared<mio::RKIntegratorCore>(1e-10, 1e-8, 1e-10, 10.0));
+    integrator.advance(5.0);
+
+    auto& stats = integrator.get_statistics();
+    EXPECT_GT(stats.num_rejected_steps, 0);
+    EXPECT_EQ(stats.num_accepted_steps, size_t(integrator.get_result().get_num_time_points() - 1));
+    EXPECT_EQ(stats.num_rhs_evaluations, num_calls);
+    //6 stages of the default Runge-Kutta-Fehlberg method for each trial step
+    EXPECT_EQ(stats.num_rhs_evaluations, 6 * (stats.num_accepted_steps + stats.num_rejected_steps));
+    EXPECT_GT(stats.min_dt, 0.0);
+    EXPECT_LE(stats.min_dt, stats.max_dt);
+    EXPECT_GE(stats.rhs_time, 0.0);
+    auto num_recorded = std::accumulate(stats.dt_histogram.begin(), stats.dt_histogram.end(), size_t(0));
+    EXPECT_GE(num_recorded, stats.num_accepted_steps - 1);
+    EXPECT_LE(num_recorded, stats.num_accepted_steps);
+}
+
+TEST(TestOdeIntegrator, statisticsRhsTiming)
+{
+    auto f = [](auto&& y, auto&&, auto&& dydt) {
+        dydt = -y;
+    };
+    auto integrator = mio::OdeIntegrator(f, 0, Eigen::VectorXd::Constant(1, 1.0), 0.1,
+                                         std::make_shared<mio::EulerIntegratorCore>());
+    integrator.set_rhs_timing(false);
+    integrator.advance(1.0);
+    EXPECT_EQ(integrator.get_statistics().num_rhs_evaluations, 10);
+    EXPECT_EQ(integrator.get_statistics().rhs_time, 0.0);
+
+    integrator.set_rhs_timing(true);
+    integrator.advance(2.0);
+    EXPECT_EQ(integrator.get_statistics().num_rhs_evaluations, 20);
+    EXPECT_GT(integrator.get_statistics().rhs_time, 0.0);
+}
+
+TEST(TestOdeIntegrator, combineStatistics)
+{
+    EXPECT_EQ(mio::IntegratorStatistics::get_dt_bucket(1e-7), 0);
+    EXPECT_EQ(mio::IntegratorStatistics::get_dt_bucket(1e-5), 1);
+    EXPECT_EQ(mio::IntegratorStatistics::get_dt_bucket(0.5), 5);
+    EXPECT_EQ(mio::IntegratorStatistics::get_dt_bucket(1.0), 6);
+    EXPECT_EQ(mio::IntegratorStatistics::get_dt_bucket(1e5), mio::IntegratorStatistics::num_dt_buckets - 1);
+
+    mio::IntegratorStatistics a, b;
+    a.num_rhs_evaluations = 10;
+    a.add_accepted_step(0.5);
+    b.num_rejected_steps = 2;
+    b.rhs_time           = 1.0;
+    b.add_accepted_step(0.02);
+    b.add_accepted_step(2.0);
+    a += b;
+    EXPECT_EQ(a.num_rhs_evaluations, 10);
+    EXPECT_EQ(a.num_accepted_steps, 3);
+    EXPECT_EQ(a.num_rejected_steps, 2);
+    EXPECT_DOUBLE_EQ(a.min_dt, 0.02);
+    EXPECT_DOUBLE_EQ(a.max_dt, 2.0);
+    EXPECT_DOUBLE_EQ(a.rhs_time, 1.0);
+    EXPECT_EQ(a.dt_histogram[4], 1);
+    EXPECT_EQ(a.dt_histogram[5], 1);
+    EXPECT_EQ(a.dt_histogram[6], 1);
+}
+
+TEST(TestBatchRKIntegrator, exponential_growth)
+{
+    //y' = a * y with different a in each system
+    Eigen::RowVector3d a(-1.0, 0.5, 2.0);
+    auto f = [&a](Eigen::Ref<const Eigen::MatrixXd> y, double /*t*/, Eigen::Ref<Eigen::MatrixXd> dydt) {
+        dydt = y.array().rowwise() * a.array();
+    };
+
+    mio::BatchRKIntegratorCore integrator(1e-10, 1e-7, 1e-8, 0.5);
+    Eigen::MatrixXd y = Eigen::MatrixXd::Ones(2, 3);
+    Eigen::MatrixXd ytp1(2, 3);
+    double t  = 0.0;
+    double dt = 0.1;
+    while (t < 1.0) {
+        dt = std::min(dt, 1.0 - t);
+        ASSERT_TRUE(integrator.step(f, y, t, dt, ytp1));
+        y = ytp1;
+    }
+
+    EXPECT_NEAR(t, 1.0, 1e-12);
+    for (Eigen::Index k = 0; k < 3; ++k) {
+        EXPECT_NEAR(y(0, k), std::exp(a[k]), 1e-5 * std::exp(a[k]));
+        EXPECT_NEAR(y(1, k), std::exp(a[k]), 1e-5 * std::exp(a[k]));
+    }
+}
+
+TEST(TestBatchRKIntegrator, step_size_of_worst_system)
+{
+    //a single system determines the step size of all
+    auto f_slow = [](Eigen::Ref<const Eigen::MatrixXd> y, double /*t*/, Eigen::Ref<Eigen::MatrixXd> dydt) {
+        dydt = -y;
+    };
+    auto f_mixed = [](Eigen::Ref<const Eigen::MatrixXd> y, double /*t*/, Eigen::Ref<Eigen::MatrixXd> dydt) {
+        dydt.col(0) = -y.col(0);
+        dydt.col(1) = -20 * y.col(1);
+    };
+
+    mio::BatchRKIntegratorCore integrator;
+    Eigen::MatrixXd y = Eigen::MatrixXd::Ones(1, 2);
+    Eigen::MatrixXd ytp1(1, 2);
+    double t = 0.0, dt_slow = 0.5, dt_mixed = 0.5;
+    integrator.step(f_slow, y, t, dt_slow, ytp1);
+    t = 0.0;
+    integrator.step(f_mixed, y, t, dt_mixed, ytp1);
+    EXPECT_LT(dt_mixed, dt_slow);
+}
+
+TEST(TestRosenbrockIntegrator, stiff_system)
+{
+    //y' = -1e5 * (y - cos(t)), solution quickly approaches cos(t)
+    auto f = [](Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::VectorXd> dydt) {
+        dydt[0] = -1e5 * (y[0] - std::cos(t));
+    };
+    auto jac = [](Eigen::Ref<const Eigen::VectorXd> /*y*/, double /*t*/, Eigen::Ref<Eigen::MatrixXd> j) {
+        j(0, 0) = -1e5;
+    };
+
+    auto rosenbrock = std::make_shared<mio::RosenbrockIntegratorCore>(1e-6, 1e-4, 1e-10, 10.0);
+    rosenbrock->set_jacobian(jac);
+    mio::OdeIntegrator rosenbrock_integrator(f, 0.0, Eigen::VectorXd::Zero(1), 1e-3, rosenbrock);
+    auto y_rosenbrock = rosenbrock_integrator.advance(10.0);
+
+    auto fd_rosenbrock = std::make_shared<mio::RosenbrockIntegratorCore>(1e-6, 1e-4, 1e-10, 10.0);
+    mio::OdeIntegrator fd_rosenbrock_integrator(f, 0.0, Eigen::VectorXd::Zero(1), 1e-3, fd_rosenbrock);
+    auto y_fd_rosenbrock = fd_rosenbrock_integrator.advance(10.0);
+
+    auto rk = std::make_shared<mio::RKIntegratorCore>(1e-6, 1e-4, 1e-10, 10.0);
+    mio::OdeIntegrator rk_integrator(f, 0.0, Eigen::VectorXd::Zero(1), 1e-3, rk);
+    auto y_rk = rk_integrator.advance(10.0);
+
+    EXPECT_NEAR(y_rosenbrock[0], std::cos(10.0), 1e-3);
+    EXPECT_NEAR(y_fd_rosenbrock[0], std::cos(10.0), 1e-3);
+    EXPECT_NEAR(y_rk[0], std::cos(10.0), 1e-3);
+
+    //step size of explicit methods is limited by stability
+    EXPECT_LT(rosenbrock_integrator.get_result().get_num_time_points() * 10,
+              rk_integrator.get_result().get_num_time_points());
+}
+
+TEST(TestRosenbrockIntegrator, color_jacobian_columns)
+{
+    //tridiagonal matrix needs three colors
+    Eigen::SparseMatrix<double> pattern(7, 7);
+    for (Eigen::Index i = 0; i < 7; ++i) {
+        for (Eigen::Index j = std::max(i - 1, Eigen::Index(0)); j < std::min(i + 2, Eigen::Index(7)); ++j) {
+            pattern.insert(i, j) = 1.0;
+        }
+    }
+    auto colors = mio::color_jacobian_columns(pattern);
+    ASSERT_EQ(colors.size(), 3);
+    EXPECT_THAT(colors[0], testing::ElementsAre(0, 3, 6));
+    EXPECT_THAT(colors[1], testing::ElementsAre(1, 4));
+    EXPECT_THAT(colors[2], testing::ElementsAre(2, 5));
+
+    //diagonal matrix needs one color
+    Eigen::SparseMatrix<double> diagonal(5, 5);
+    diagonal.setIdentity();
+    EXPECT_EQ(mio::color_jacobian_columns(diagonal).size(), 1);
+}
+
+TEST(TestRosenbrockIntegrator, sparse_finite_differences)
+{
+    //nonlinear diffusion on a line, jacobian is tridiagonal
+    const Eigen::Index n = 20;
+    auto f = [](Eigen::Ref<const Eigen::VectorXd> y, double /*t*/, Eigen::Ref<Eigen::VectorXd> dydt) {
+        for (Eigen::Index i = 0; i < n; ++i) {
+            auto left  = i > 0 ? y[i - 1] : y[i];
+            auto right = i < n - 1 ? y[i + 1] : y[i];
+            dydt[i]    = 50 * (left - 2 * y[i] + right) - y[i] * y[i];
+        }
+    };
+    Eigen::SparseMatrix<double> pattern(n, n);
+    for (Eigen::Index i = 0; i < n; ++i) {
+        for (Eigen::Index j = std::max(i - 1, Eigen::Index(0)); j < std::min(i + 2, n); ++j) {
+            pattern.insert(i, j) = 1.0;
+        }
+    }
+    Eigen::VectorXd y0 = Eigen::VectorXd::LinSpaced(n, 0.0, 1.0);
+
+    auto dense = std::make_shared<mio::RosenbrockIntegratorCore>();
+    mio::OdeIntegrator dense_integrator(f, 0.0, y0, 0.1, dense);
+    auto sparse = std::make_shared<mio::RosenbrockIntegratorCore>();
+    sparse->set_jacobian_sparsity(pattern);
+    mio::OdeIntegrator sparse_integrator(f, 0.0, y0, 0.1, sparse);
+
+    EXPECT_EQ(dense->get_num_jacobian_evaluations(n), n);
+    EXPECT_EQ(sparse->get_num_jacobian_evaluations(n), 3);
+
+    auto y_dense  = dense_integrator.advance(2.0);
+    auto y_sparse = sparse_integrator.advance(2.0);
+    EXPECT_NEAR((y_dense - y_sparse).norm(), 0.0, 1e-8);
+}
@@ -23,6 +23,7 @@
 #include "memilio/math/adapt_rk.h"
 #include "ode_secir/parameter_space.h"
 #include "ode_secir/analyze_result.h"
+#include "memilio/compartments/sensitivity_simulation.h"
 #include <distributions_helpers.h>
 #include <gtest/gtest.h>
 
@@ -795,3 +796,137 @@ TEST(Secir, get_migration_factors)
         ASSERT_LT(factors[Eigen::Index(mio::osecir::InfectionState::InfectedSymptoms)], max_beta);
     }
 }
+
+TEST(TestSecir, fixedSizeModel)
+{
+    mio::osecir::Model model(3);
+    auto& params = model.parameters;
+    params.set<mio::osecir::ICUCapacity>(20);
+    params.set<mio::osecir::TestAndTraceCapacity>(30);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(3); ++i) {
+        auto fact = 1.0 + 0.1 * (size_t)i;
+        params.get<mio::osecir::IncubationTime>()[i]                    = 5.2 * fact;
+        params.get<mio::osecir::SerialInterval>()[i]                    = 4.2 * fact;
+        params.get<mio::osecir::TimeInfectedSymptoms>()[i]              = 5.8 * fact;
+        params.get<mio::osecir::TimeInfectedSevere>()[i]                = 9.5 * fact;
+        params.get<mio::osecir::TimeInfectedCritical>()[i]              = 7.1 * fact;
+        params.get<mio::osecir::TransmissionProbabilityOnContact>()[i]  = 0.05 * fact;
+        params.get<mio::osecir::RecoveredPerInfectedNoSymptoms>()[i]    = 0.09 * fact;
+        params.get<mio::osecir::RiskOfInfectionFromSymptomatic>()[i]    = 0.25 * fact;
+        params.get<mio::osecir::MaxRiskOfInfectionFromSymptomatic>()[i] = 0.45 * fact;
+        params.get<mio::osecir::SeverePerInfectedSymptoms>()[i]         = 0.2 * fact;
+        params.get<mio::osecir::CriticalPerSevere>()[i]                 = 0.25 * fact;
+        params.get<mio::osecir::DeathsPerCritical>()[i]                 = 0.3 * fact;
+
+        model.populations[{i, mio::osecir::InfectionState::Exposed}]            = 10 * fact;
+        model.populations[{i, mio::osecir::InfectionState::InfectedNoSymptoms}] = 20 * fact;
+        model.populations[{i, mio::osecir::InfectionState::InfectedSymptoms}]   = 30 * fact;
+        model.populations[{i, mio::osecir::InfectionState::InfectedSevere}]     = 10 * fact;
+        model.populations[{i, mio::osecir::InfectionState::InfectedCritical}]   = 8 * fact;
+        model.populations[{i, mio::osecir::InfectionState::Recovered}]          = 10 * fact;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>({i, mio::osecir::InfectionState::Susceptible},
+                                                                         1000 * fact);
+    }
+    Eigen::MatrixXd contacts(3, 3);
+    contacts << 5, 2, 1, 2, 6, 3, 1, 3, 4;
+    params.get<mio::osecir::ContactPatterns>().get_cont_freq_mat()[0].get_baseline() = contacts;
+    model.apply_constraints();
+
+    mio::osecir::FixedSizeModel<3> fixed_model(model);
+
+    //same right hand side, also with exceeded capacities
+    auto y = model.populations.get_compartments();
+    Eigen::VectorXd dydt(y.size()), dydt_fixed(y.size());
+    model.get_derivatives(y, y, 1.0, dydt);
+    fixed_model.get_derivatives(y, y, 1.0, dydt_fixed);
+    for (Eigen::Index i = 0; i < y.size(); ++i) {
+        EXPECT_NEAR(dydt_fixed[i], dydt[i], 1e-12 * std::max(1.0, std::abs(dydt[i])));
+    }
+
+    //same simulation result
+    auto result       = mio::simulate(0.0, 20.0, 0.1, model);
+    auto result_fixed = mio::simulate(0.0, 20.0, 0.1, fixed_model);
+    ASSERT_EQ(result_fixed.get_num_time_points(), result.get_num_time_points());
+    EXPECT_NEAR((result_fixed.get_last_value() - result.get_last_value()).norm(), 0.0,
+                1e-10 * result.get_last_value().norm());
+}
+
+TEST(TestSecir, sensitivities)
+{
+    mio::osecir::Model model(1);
+    auto& params = model.parameters;
+    auto g       = mio::AgeGroup(0);
+    params.set<mio::osecir::ICUCapacity>(1e6);
+    params.set<mio::osecir::TestAndTraceCapacity>(1e6);
+    params.get<mio::osecir::IncubationTime>()[g]                   = 5.2;
+    params.get<mio::osecir::SerialInterval>()[g]                   = 4.2;
+    params.get<mio::osecir::TimeInfectedSymptoms>()[g]             = 5.8;
+    params.get<mio::osecir::TimeInfectedSevere>()[g]               = 9.5;
+    params.get<mio::osecir::TimeInfectedCritical>()[g]             = 7.1;
+    params.get<mio::osecir::TransmissionProbabilityOnContact>()[g] = 0.05;
+    params.get<mio::osecir::ContactPatterns>().get_cont_freq_mat()[0].get_baseline().setConstant(10.0);
+    model.populations[{g, mio::osecir::InfectionState::Exposed}]          = 100;
+    model.populations[{g, mio::osecir::InfectionState::InfectedSymptoms}] = 50;
+    model.populations.set_difference_from_group_total<mio::AgeGroup>({g, mio::osecir::InfectionState::Susceptible},
+                                                                     10000);
+
+    using Accessor = mio::SensitivitySimulation<mio::osecir::Model>::ParameterAccessor;
+    std::vector<Accessor> parameters{
+        [](auto& m) -> ScalarType& {
+            return m.parameters.template get<mio::osecir::TransmissionProbabilityOnContact>()[mio::AgeGroup(0)];
+        },
+        [](auto& m) -> ScalarType& {
+            return m.parameters.template get<mio::osecir::TimeInfectedSymptoms>()[mio::AgeGroup(0)];
+        },
+        [](auto& m) -> ScalarType& {
+            return m.populations[{mio::AgeGroup(0), mio::osecir::InfectionState::Exposed}];
+        }};
+
+    //results at the end of each day, so no interpolation error in the distance to the reference
+    auto make_integrator = []() {
+        return std::make_shared<mio::RKIntegratorCore>(1e-10, 1e-10, 1e-10, 1.0);
+    };
+    auto simulate_days = [&](auto&& m) {
+        mio::Simulation<mio::osecir::Model> s(m, 0.0, 0.1);
+        s.set_integrator(make_integrator());
+        for (auto t = 1; t <= 30; ++t) {
+            s.advance(t);
+        }
+        return mio::interpolate_simulation_result(s.get_result());
+    };
+    mio::SensitivitySimulation<mio::osecir::Model> sim(model, parameters);
+    sim.set_integrator(make_integrator());
+    for (auto t = 1; t <= 30; ++t) {
+        sim.advance(t);
+    }
+
+    //same compartments as a simulation without sensitivities
+    auto result = simulate_days(model);
+    EXPECT_THAT(sim.get_model_result().get_last_value(), MatrixNear(result.get_last_value(), 1e-8, 1e-8));
+
+    //sensitivities and gradient match central differences of whole simulations
+    auto reference = result;
+    for (auto&& day : reference) {
+        day *= 1.1;
+    }
+    auto gradient = mio::result_distance_2norm_gradient(sim, reference);
+    ASSERT_EQ(gradient.size(), 3);
+    for (size_t k = 0; k < parameters.size(); ++k) {
+        auto h           = 1e-5 * parameters[k](model);
+        auto model_plus  = model;
+        auto model_minus = model;
+        parameters[k](model_plus) += h;
+        parameters[k](model_minus) -= h;
+        auto result_plus  = simulate_days(model_plus);
+        auto result_minus = simulate_days(model_minus);
+
+        auto fd_sensitivity = ((result_plus.get_last_value() - result_minus.get_last_value()) / (2 * h)).eval();
+        auto sensitivity    = sim.get_sensitivity(k).get_last_value();
+        EXPECT_THAT(sensitivity, MatrixNear(fd_sensitivity, 1e-4, 1e-4 * fd_sensitivity.cwiseAbs().maxCoeff()));
+
+        auto fd_gradient = (mio::result_distance_2norm({result_plus}, {reference}) -
+                            mio::result_distance_2norm({result_minus}, {reference})) /
+                           (2 * h);
+        EXPECT_NEAR(gradient[Eigen::Index(k)], fd_gradient, 1e-4 * std::abs(fd_gradient));
+    }
+}
@@ -0,0 +1,109 @@
+/* 
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/utils/parallel_for.h"
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+TEST(TestParallelFor, all_indices)
+{
+    for (auto num_threads : {size_t(1), size_t(3), size_t(20)}) {
+        std::vector<int> v(10, 0);
+        mio::parallel_for(
+            v.size(),
+            [&](size_t i) {
+                v[i] += int(i);
+            },
+            num_threads);
+        EXPECT_THAT(v, testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+    }
+}
+
+TEST(TestParallelFor, empty)
+{
+    auto num_calls = 0;
+    mio::parallel_for(0, [&](size_t) {
+        ++num_calls;
+    });
+    EXPECT_EQ(num_calls, 0);
+}
+
+TEST(TestParallelFor, exception)
+{
+    auto f = [](size_t i) {
+        if (i == 5) {
+            throw std::runtime_error("error");
+        }
+    };
+    EXPECT_THROW(mio::parallel_for(10, f, 4), std::runtime_error);
+}
+
+TEST(TestThreadPool, all_indices)
+{
+    for (auto num_threads : {size_t(1), size_t(3), size_t(20)}) {
+        mio::ThreadPool pool(num_threads);
+        EXPECT_EQ(pool.get_num_threads(), num_threads);
+        for (auto n : {size_t(0), size_t(1), size_t(10), size_t(100)}) {
+            std::vector<int> v(n, 0);
+            pool.parallel_for(v.size(), [&](size_t i) {
+                v[i] += int(i);
+            });
+            for (size_t i = 0; i < n; ++i) {
+                EXPECT_EQ(v[i], int(i));
+            }
+        }
+    }
+}
+
+TEST(TestThreadPool, reuses_threads)
+{
+    mio::ThreadPool pool(3);
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    for (auto i = 0; i < 100; ++i) {
+        pool.parallel_for(10, [&](size_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            thread_ids.insert(std::this_thread::get_id());
+        });
+    }
+    EXPECT_LE(thread_ids.size(), size_t(3));
+}
+
+TEST(TestThreadPool, exception)
+{
+    mio::ThreadPool pool(4);
+    auto f = [](size_t i) {
+        if (i == 5) {
+            throw std::runtime_error("error");
+        }
+    };
+    EXPECT_THROW(pool.parallel_for(10, f), std::runtime_error);
+
+    //still usable after an exception
+    std::atomic<int> num_calls{0};
+    pool.parallel_for(10, [&](size_t) {
+        ++num_calls;
+    });
+    EXPECT_EQ(num_calls, 10);
+}
@@ -167,6 +167,25 @@ TEST(ParameterStudies, sample_graph)
     }
 }
 
+TEST(ParameterStudies, graph_with_relative_deviation)
+{
+    mio::osecir::Model model(1);
+    model.parameters.get<mio::osecir::IncubationTime>()[mio::AgeGroup(0)] = 5.2;
+    model.parameters.get<mio::osecir::SerialInterval>()[mio::AgeGroup(0)] = 4.2;
+
+    auto graph = mio::Graph<mio::osecir::Model, mio::MigrationParameters>();
+    graph.add_node(0, model);
+    graph.add_node(1, model);
+
+    auto study = mio::ParameterStudy<mio::osecir::Simulation<>>(graph, 0.0, 10.0, 0.2, 0.5, 1);
+    for (auto& node : study.get_secir_model_graph().nodes()) {
+        auto& incubation_time = node.property.parameters.get<mio::osecir::IncubationTime>()[mio::AgeGroup(0)];
+        ASSERT_NE(incubation_time.get_distribution(), nullptr);
+        EXPECT_NEAR(incubation_time.get_distribution()->get_lower_bound(), (1 - 0.2 * 2.6) * 5.2, 1e-10);
+        EXPECT_NEAR(incubation_time.get_distribution()->get_upper_bound(), (1 + 0.2 * 2.6) * 5.2, 1e-10);
+    }
+}
+
 TEST(ParameterStudies, test_normal_distribution)
 {
     mio::log_thread_local_rng_seeds(mio::LogLevel::warn);
@@ -211,6 +230,20 @@ TEST(ParameterStudies, test_normal_distribution)
     //degenerate case: ub == lb
     mio::ParameterDistributionNormal dist3(3.0, 3.0, 3.0, 3.0);
     EXPECT_EQ(dist3.get_sample(), 3.0);
+    EXPECT_EQ(dist3.get_rand_sample_const(), 3.0);
+
+    //sampling without changing the distribution, also if the standard deviation would be adapted
+    mio::ParameterDistributionNormal dist4(-1.0, 1.0, 0.0, 0.1);
+    dist4.set_standard_dev(1.0);
+    dist4.log_stddev_changes(false); // only avoid warning output in tests
+    for (auto&& dist : {parameter_dist_normal_2, dist4}) {
+        for (int i = 0; i < 1000; i++) {
+            double val = dist.get_rand_sample_const();
+            EXPECT_GE(dist.get_upper_bound() + 1e-10, val);
+            EXPECT_LE(dist.get_lower_bound() - 1e-10, val);
+        }
+    }
+    EXPECT_EQ(dist4.get_standard_dev(), 1.0);
 }
 
 TEST(ParameterStudies, test_uniform_distribution)
@@ -228,6 +261,9 @@ TEST(ParameterStudies, test_uniform_distribution)
         double val = parameter_dist_unif.get_sample();
         EXPECT_GE(parameter_dist_unif.get_upper_bound() + 1e-10, val);
         EXPECT_LE(parameter_dist_unif.get_lower_bound() - 1e-10, val);
+        val = parameter_dist_unif.get_rand_sample_const();
+        EXPECT_GE(parameter_dist_unif.get_upper_bound() + 1e-10, val);
+        EXPECT_LE(parameter_dist_unif.get_lower_bound() - 1e-10, val);
     }
 }
 
@@ -332,3 +368,44 @@ TEST(ParameterStudies, check_ensemble_run_result)
         }
     }
 }
+
+TEST(ParameterStudies, check_batched_ensemble_run_result)
+{
+    mio::log_thread_local_rng_seeds(mio::LogLevel::warn);
+
+    double t0   = 0;
+    double tmax = 20;
+
+    mio::osecir::Model model(2);
+    for (auto i = mio::AgeGroup(0); i < model.parameters.get_num_groups(); i++) {
+        model.populations[{i, mio::osecir::InfectionState::Exposed}]          = 100;
+        model.populations[{i, mio::osecir::InfectionState::InfectedSymptoms}] = 50;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>({i, mio::osecir::InfectionState::Susceptible},
+                                                                         10000);
+    }
+    model.parameters.get<mio::osecir::ContactPatterns>().get_cont_freq_mat()[0].get_baseline().setConstant(5.0);
+    model.apply_constraints();
+    mio::osecir::set_params_distributions_normal(model, t0, tmax, 0.2);
+
+    mio::ParameterStudy<mio::osecir::Simulation<>> parameter_study(model, t0, tmax, 5);
+    std::vector<mio::TimeSeries<double>> results;
+    parameter_study.run_batched(
+        2,
+        [](auto&& m) {
+            auto sampled_model = m;
+            draw_sample(sampled_model);
+            return sampled_model;
+        },
+        [&results](auto&& /*sampled_model*/, auto&& result) {
+            results.push_back(std::move(result));
+        });
+
+    ASSERT_EQ(results.size(), 5);
+    for (auto& result : results) {
+        EXPECT_NEAR(result.get_last_time(), tmax, 1e-10);
+        for (Eigen::Index i = 0; i < result.get_num_time_points(); i++) {
+            EXPECT_NEAR(result[i].sum(), 20000, 1e-3) << " time point " << i;
+            EXPECT_GE(result[i].minCoeff(), -1e-8) << " time point " << i;
+        }
+    }
+}
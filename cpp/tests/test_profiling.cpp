@@ -0,0 +1,150 @@
+/*
+* Copyright (C) 2020-2023 German Aerospace Center (DLR-SC)
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/utils/profiling.h"
+#include "memilio/utils/parallel_for.h"
+#include "temp_file_register.h"
+#include "gtest/gtest.h"
+#include <fstream>
+#include <sstream>
+
+TEST(TestProfiling, nestedScopes)
+{
+    mio::ProfilingRegistry registry;
+    for (int i = 0; i < 3; ++i) {
+        mio::ScopedProfilingTimer outer("outer", registry);
+        {
+            mio::ScopedProfilingTimer inner("inner", registry);
+        }
+        mio::ScopedProfilingTimer other("other", registry);
+        mio::ScopedProfilingTimer nested("inner", registry);
+    }
+    {
+        mio::ScopedProfilingTimer inner("inner", registry);
+    }
+
+    auto stats = registry.get_timer_statistics();
+    ASSERT_EQ(stats.size(), 5);
+    EXPECT_EQ(stats[0].path, "outer");
+    EXPECT_EQ(stats[1].path, "outer/inner");
+    EXPECT_EQ(stats[2].path, "outer/other");
+    EXPECT_EQ(stats[3].path, "outer/other/inner");
+    EXPECT_EQ(stats[4].path, "inner");
+    EXPECT_EQ(stats[3].depth, 2);
+    EXPECT_EQ(stats[0].num_calls, 3);
+    EXPECT_EQ(stats[3].num_calls, 3);
+    EXPECT_EQ(stats[4].num_calls, 1);
+    for (auto& s : stats) {
+        EXPECT_EQ(s.num_threads, 1);
+        EXPECT_LE(s.min_time, s.max_time);
+        EXPECT_LE(s.max_time, s.total_time);
+    }
+    EXPECT_GE(stats[0].total_time, stats[1].total_time + stats[2].total_time);
+}
+
+TEST(TestProfiling, threads)
+{
+    mio::ProfilingRegistry registry;
+    mio::parallel_for(
+        4,
+        [&registry](size_t) {
+            mio::ScopedProfilingTimer timer("work", registry);
+            registry.add_count("items", 2);
+        },
+        4);
+    registry.add_count("other", 1);
+
+    auto stats = registry.get_timer_statistics();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].path, "work");
+    EXPECT_EQ(stats[0].num_calls, 4);
+    EXPECT_GE(stats[0].num_threads, 1);
+    EXPECT_LE(stats[0].num_threads, 4);
+
+    auto counters = registry.get_counter_statistics();
+    ASSERT_EQ(counters.size(), 2);
+    EXPECT_EQ(counters[0].name, "items");
+    EXPECT_EQ(counters[0].value, 8);
+    EXPECT_EQ(counters[1].name, "other");
+    EXPECT_EQ(counters[1].value, 1);
+}
+
+TEST(TestProfiling, clear)
+{
+    mio::ProfilingRegistry registry;
+    mio::ScopedProfilingTimer outer("outer", registry);
+    {
+        mio::ScopedProfilingTimer inner("inner", registry);
+        registry.add_count("count", 1);
+    }
+    registry.clear();
+    {
+        mio::ScopedProfilingTimer inner("inner", registry);
+    }
+
+    auto stats = registry.get_timer_statistics();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats[0].num_calls, 0);
+    EXPECT_EQ(stats[1].path, "outer/inner");
+    EXPECT_EQ(stats[1].num_calls, 1);
+    EXPECT_TRUE(registry.get_counter_statistics().empty());
+}
+
+TEST(TestProfiling, summary)
+{
+    mio::ProfilingRegistry registry;
+    {
+        mio::ScopedProfilingTimer outer("outer", registry);
+        mio::ScopedProfilingTimer inner("inner", registry);
+    }
+    registry.add_count("count", 3);
+
+    std::stringstream ss;
+    registry.print_summary(ss);
+    auto summary = ss.str();
+    EXPECT_NE(summary.find("\nouter "), std::string::npos);
+    EXPECT_NE(summary.find("\n  inner "), std::string::npos);
+    EXPECT_NE(summary.find("\ncount "), std::string::npos);
+}
+
+TEST(TestProfiling, chromeTrace)
+{
+    mio::ProfilingRegistry registry;
+    registry.set_trace_enabled(true, 0);
+    for (int i = 0; i < 2; ++i) {
+        mio::ScopedProfilingTimer outer("outer", registry);
+        mio::ScopedProfilingTimer inner("inner", registry);
+    }
+
+    TempFileRegister file_register;
+    auto filename = file_register.get_unique_path("trace-%%%%-%%%%.json");
+    ASSERT_TRUE(registry.write_chrome_trace(filename));
+
+    std::ifstream file(filename);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    auto trace = ss.str();
+    EXPECT_EQ(trace.find("{\"traceEvents\":["), 0);
+    //only the outer scope is recorded because of the maximum depth
+    auto first = trace.find("\"name\":\"outer\"");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"outer\"", first + 1), std::string::npos);
+    EXPECT_EQ(trace.find("\"name\":\"inner\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+}
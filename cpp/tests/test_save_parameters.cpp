@@ -598,3 +598,44 @@ TEST(TestSaveParameters, ExtrapolateRKI)
             death[i], 1e-1);
     }
 }
+
+TEST(TestSaveParameters, ExtrapolateRKIMultipleDays)
+{
+    std::vector<mio::osecir::Model> model{mio::osecir::Model(6)};
+    model[0].apply_constraints();
+    for (auto group = mio::AgeGroup(0); group < mio::AgeGroup(6); group++) {
+        model[0].parameters.get<mio::osecir::RecoveredPerInfectedNoSymptoms>()[group] = 0.1 * ((size_t)group + 1);
+        model[0].parameters.get<mio::osecir::SeverePerInfectedSymptoms>()[group]      = 0.11 * ((size_t)group + 1);
+        model[0].parameters.get<mio::osecir::CriticalPerSevere>()[group]              = 0.12 * ((size_t)group + 1);
+    }
+    std::vector<double> scaling_factor_inf(6, 1.0);
+    double scaling_factor_icu = 1.0;
+    std::vector<int> county   = {1002};
+
+    TempFileRegister file_register;
+    auto results_dir_multi = file_register.get_unique_path("ExtrapolateRKI-%%%%-%%%%");
+    auto results_dir_one   = file_register.get_unique_path("ExtrapolateRKI-%%%%-%%%%");
+    boost::filesystem::create_directory(results_dir_multi);
+    boost::filesystem::create_directory(results_dir_one);
+
+    //each day of a time series is the same as if the day was exported on its own
+    ASSERT_THAT(print_wrap(mio::osecir::export_input_data_county_timeseries(model, TEST_DATA_DIR, results_dir_multi,
+                                                                           county, mio::Date(2020, 12, 8),
+                                                                           scaling_factor_inf, scaling_factor_icu, 3)),
+                IsSuccess());
+    ASSERT_THAT(print_wrap(mio::osecir::export_input_data_county_timeseries(model, TEST_DATA_DIR, results_dir_one,
+                                                                           county, mio::Date(2020, 12, 10),
+                                                                           scaling_factor_inf, scaling_factor_icu, 1)),
+                IsSuccess());
+
+    auto read_result_multi = mio::read_result(mio::path_join(results_dir_multi, "Results_rki.h5"));
+    ASSERT_THAT(print_wrap(read_result_multi), IsSuccess());
+    auto read_result_one = mio::read_result(mio::path_join(results_dir_one, "Results_rki.h5"));
+    ASSERT_THAT(print_wrap(read_result_one), IsSuccess());
+
+    auto& results_multi = read_result_multi.value()[0].get_groups();
+    auto& results_one   = read_result_one.value()[0].get_groups();
+    ASSERT_EQ(results_multi.get_num_time_points(), 3);
+    ASSERT_EQ(results_one.get_num_time_points(), 1);
+    EXPECT_EQ(print_wrap(results_multi[2]), print_wrap(results_one[0]));
+}
@@ -23,7 +23,10 @@
 #include "memilio/utils/time_series.h"
 #include "memilio/io/result_io.h"
 #include "temp_file_register.h"
+#include "matchers.h"
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <limits>
 
 TEST(TestSaveResult, compareResultWithH5)
 {
@@ -105,3 +108,46 @@ TEST(TestSaveResult, compareResultWithH5)
         }
     }
 }
+
+TEST(TestSaveResult, singlePrecision)
+{
+    mio::osecir::Model model(2);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(2); i++) {
+        model.parameters.get<mio::osecir::IncubationTime>()[i]       = 5.2;
+        model.parameters.get<mio::osecir::SerialInterval>()[i]       = 4.2;
+        model.parameters.get<mio::osecir::TimeInfectedSymptoms>()[i] = 5.;
+        model.parameters.get<mio::osecir::TimeInfectedSevere>()[i]   = 10.;
+        model.parameters.get<mio::osecir::TimeInfectedCritical>()[i] = 8.;
+        model.populations[{i, mio::osecir::InfectionState::Exposed}] = 100;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>({i, mio::osecir::InfectionState::Susceptible},
+                                                                         1e5);
+    }
+    model.parameters.get<mio::osecir::ContactPatterns>().get_cont_freq_mat()[0].get_baseline().setConstant(5.0);
+
+    auto result = mio::interpolate_simulation_result(mio::simulate(0.0, 100.0, 0.1, model));
+    std::vector<mio::TimeSeries<double>> results        = {result, result};
+    std::vector<mio::TimeSeries<float>> results_float = {result.cast<float>(), result.cast<float>()};
+
+    TempFileRegister file_register;
+    auto file_path       = file_register.get_unique_path("test_result-%%%%-%%%%.h5");
+    auto file_path_float = file_register.get_unique_path("test_result-%%%%-%%%%.h5");
+    ASSERT_TRUE(mio::save_result(results, {1, 2}, 2, file_path));
+    ASSERT_TRUE(mio::save_result(results_float, {1, 2}, 2, file_path_float));
+
+    //values are stored in half the space
+    EXPECT_LT(fs::file_size(file_path_float), fs::file_size(file_path));
+
+    auto results_from_file = mio::read_result(file_path_float);
+    ASSERT_TRUE(results_from_file);
+    auto& result_from_file = results_from_file.value()[0];
+    ASSERT_EQ(result_from_file.get_groups().get_num_time_points(), result.get_num_time_points());
+    auto eps              = double(std::numeric_limits<float>::epsilon());
+    auto num_compartments = Eigen::Index(mio::osecir::InfectionState::Count);
+    for (Eigen::Index t = 0; t < result.get_num_time_points(); t++) {
+        EXPECT_EQ(result_from_file.get_groups().get_time(t), result.get_time(t));
+        //only rounding of the stored values, totals are summed in double precision before rounding
+        EXPECT_THAT(result_from_file.get_groups()[t], MatrixNear(result[t], 0.5 * eps, 0.0));
+        auto total = (result[t].head(num_compartments) + result[t].tail(num_compartments)).eval();
+        EXPECT_THAT(result_from_file.get_totals()[t], MatrixNear(total, 0.5 * eps, 0.0));
+    }
+}
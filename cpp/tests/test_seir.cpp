@@ -22,7 +22,9 @@
 #include "ode_seir/infection_state.h"
 #include "ode_seir/parameters.h"
 #include "memilio/math/euler.h"
+#include "memilio/math/rosenbrock.h"
 #include "memilio/compartments/simulation.h"
+#include "memilio/compartments/flow_simulation.h"
 #include <gtest/gtest.h>
 
 using real = double;
@@ -107,3 +109,56 @@ TEST_F(TestSeir, checkPopulationConservation)
     }
     EXPECT_NEAR(num_persons, total_population, 1e-8);
 }
+
+TEST_F(TestSeir, jacobian)
+{
+    //compare with finite differences
+    Eigen::VectorXd y = model.get_initial_values();
+    Eigen::MatrixXd jac(4, 4), fd_jac(4, 4);
+    model.get_jacobian(y, 1.0, jac);
+
+    Eigen::VectorXd dydt(4), dydt_h(4);
+    model.eval_right_hand_side(y, y, 1.0, dydt);
+    for (Eigen::Index j = 0; j < 4; ++j) {
+        auto h             = 1e-3;
+        Eigen::VectorXd yh = y;
+        yh[j] += h;
+        model.eval_right_hand_side(yh, yh, 1.0, dydt_h);
+        fd_jac.col(j) = (dydt_h - dydt) / h;
+    }
+    EXPECT_NEAR((jac - fd_jac).norm(), 0.0, 1e-6);
+}
+
+TEST_F(TestSeir, rosenbrockWithAnalyticJacobian)
+{
+    mio::Simulation<mio::oseir::Model> sim(model, t0, dt);
+    auto rosenbrock = std::make_shared<mio::RosenbrockIntegratorCore>(1e-3, 1e-6, 1e-10, 10.0);
+    rosenbrock->set_jacobian([&sim](auto&& y, auto&& t, auto&& jac) {
+        sim.get_model().get_jacobian(y, t, jac);
+    });
+    sim.set_integrator(rosenbrock);
+    sim.advance(tmax);
+
+    auto reference = mio::simulate<mio::oseir::Model>(t0, tmax, dt, model);
+    EXPECT_NEAR(sim.get_result().get_last_time(), tmax, 1e-10);
+    EXPECT_NEAR((sim.get_result().get_last_value() - reference.get_last_value()).norm(), 0.0,
+                1e-4 * total_population);
+}
+
+TEST_F(TestSeir, flowSimulation)
+{
+    auto results   = mio::simulate_flows(t0, tmax, dt, model);
+    auto& comps    = results[0];
+    auto& flows    = results[1];
+    auto reference = mio::simulate(t0, tmax, dt, model);
+
+    EXPECT_NEAR((comps.get_last_value() - reference.get_last_value()).norm(), 0.0, 1e-4 * total_population);
+
+    //new exposed per time step, without an additional compartment
+    auto flow_idx = mio::oseir::Model::get_flat_flow_index<mio::oseir::InfectionState::Susceptible,
+                                                           mio::oseir::InfectionState::Exposed>();
+    auto S        = (size_t)mio::oseir::InfectionState::Susceptible;
+    for (Eigen::Index i = 1; i < flows.get_num_time_points(); ++i) {
+        EXPECT_NEAR(flows[i][flow_idx] - flows[i - 1][flow_idx], comps[i - 1][S] - comps[i][S], 1e-6);
+    }
+}
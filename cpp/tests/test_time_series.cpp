@@ -22,6 +22,7 @@
 #include "matchers.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <limits>
 
 template <class T>
 using TestTimeSeries = ::testing::Test;
@@ -320,3 +321,24 @@ TYPED_TEST(TestTimeSeries, create)
         }
     }
 }
+
+TEST(TestTimeSeries, cast)
+{
+    mio::TimeSeries<double> ts(3);
+    ts.add_time_point(0.0, Eigen::Vector3d(1.0, 1e6 + 0.5, 1.0 / 3.0));
+    ts.add_time_point(0.1, Eigen::Vector3d(2.0, 2e6 + 0.25, 2.0 / 3.0));
+
+    auto ts_float = ts.cast<float>();
+    ASSERT_EQ(ts_float.get_num_elements(), 3);
+    ASSERT_EQ(ts_float.get_num_time_points(), 2);
+    for (Eigen::Index i = 0; i < ts.get_num_time_points(); ++i) {
+        EXPECT_EQ(ts_float.get_time(i), float(ts.get_time(i)));
+        EXPECT_EQ(print_wrap(ts_float[i]), print_wrap(ts[i].cast<float>().eval()));
+    }
+
+    //converting back only loses the precision of float
+    auto ts_double = ts_float.cast<double>();
+    for (Eigen::Index i = 0; i < ts.get_num_time_points(); ++i) {
+        EXPECT_THAT(ts_double[i], MatrixNear(ts[i], std::numeric_limits<float>::epsilon(), 0.0));
+    }
+}
@@ -51,6 +51,50 @@ TEST(TestUncertain, uncertain_value_copy)
     check_distribution(*val.get_distribution().get(), *val2.get_distribution().get());
 }
 
+TEST(TestUncertain, uncertain_value_shared_distribution)
+{
+    mio::UncertainValue val(2.0);
+    val.set_distribution(mio::ParameterDistributionUniform(1.0, 3.0));
+
+    //copies share the distribution until it is modified
+    mio::UncertainValue val2(val);
+    mio::UncertainValue val3;
+    val3              = val2;
+    const auto& cval  = val;
+    const auto& cval2 = val2;
+    const auto& cval3 = val3;
+    EXPECT_EQ(cval.get_distribution().get(), cval2.get_distribution().get());
+    EXPECT_EQ(cval.get_distribution().get(), cval3.get_distribution().get());
+
+    //modification only affects the modified copy
+    val2.get_distribution()->add_predefined_sample(2.5);
+    EXPECT_NE(cval.get_distribution().get(), cval2.get_distribution().get());
+    EXPECT_EQ(cval.get_distribution().get(), cval3.get_distribution().get());
+    EXPECT_EQ(cval.get_distribution()->get_predefined_samples().size(), 0);
+    EXPECT_EQ(cval2.get_distribution()->get_predefined_samples().size(), 1);
+
+    //a unique distribution is sampled in place
+    auto dist2 = cval2.get_distribution().get();
+    val2.draw_sample();
+    EXPECT_EQ(val2, 2.5);
+    EXPECT_EQ(cval2.get_distribution().get(), dist2);
+
+    //random samples are drawn from a shared distribution without copying it
+    val3.draw_sample();
+    EXPECT_EQ(cval.get_distribution().get(), cval3.get_distribution().get());
+    EXPECT_GE(val3, 1.0);
+    EXPECT_LE(val3, 3.0);
+    EXPECT_EQ(val, 2.0);
+
+    //predefined samples change the distribution, so it is copied
+    val.get_distribution()->add_predefined_sample(1.5);
+    mio::UncertainValue val4(val);
+    val4.draw_sample();
+    EXPECT_EQ(val4, 1.5);
+    EXPECT_NE(cval.get_distribution().get(), val4.get_distribution().get());
+    EXPECT_EQ(cval.get_distribution()->get_predefined_samples().size(), 1);
+}
+
 TEST(TestUncertain, random_sample)
 {
     mio::UncertainValue val(2.0);